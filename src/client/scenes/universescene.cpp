@@ -20,6 +20,7 @@
 
 #include <fmt/format.h>
 
+#include <chrono>
 #include <cmath>
 #include <string>
 
@@ -57,6 +58,19 @@
 
 // If the game is paused or not, like when escape is pressed
 bool game_halted = false;
+std::shared_ptr<const cqsp::common::UniverseSnapshot> universe_snapshot;
+// The client state of the star system view. It's kept out of the universe so that it can be
+// changed while the simulation is ticking.
+entt::entity focused_planet = entt::null;
+entt::entity mouse_over_entity = entt::null;
+// Fast forward options set by the turn window
+bool fast_forward = false;
+int skip_target = -1;
+bool skipping = false;
+bool stop_skipping = false;
+// How long the ticks can run for every frame when fast forwarding. The ticks run while the frame
+// is rendered, so this is a bit less than the time of a frame.
+const auto fast_forward_budget = std::chrono::milliseconds(12);
 
 cqsp::scene::UniverseScene::UniverseScene(cqsp::engine::Application& app) : Scene(app) {}
 
@@ -69,6 +83,9 @@ void cqsp::scene::UniverseScene::Init() {
 
     using cqspco::systems::simulation::Simulation;
     simulation = std::make_unique<Simulation>(GetApp().GetGame());
+    // Spreading out the systems that run every n ticks keeps the frame rate from dropping every n ticks, but changes
+    // the results of the simulation, so it has to be turned on in the options
+    simulation->SetAmortized(static_cast<bool>(GetApp().GetClientOptions().GetOptions()["simulation"]["amortize"]));
 
     system_renderer = new cqsps::SysStarSystemRenderer(GetUniverse(), GetApp());
     system_renderer->Initialize();
@@ -79,7 +96,6 @@ void cqsp::scene::UniverseScene::Init() {
         player_civ = &civ;
     }
     //cqspb::Body body = GetUniverse().get<cqspb::Body>(player_civ->starting_planet);
-    system_renderer->SeeStarSystem();
 
     //SeeStarSystem(GetApp(), body.star_system);
     //SeePlanet(GetApp(), player_civ->starting_planet);
@@ -98,10 +114,25 @@ void cqsp::scene::UniverseScene::Init() {
 
     AddUISystem<cqsps::gui::SysEvent>();
     simulation->tick();
+
+    // The rest of the ticks are run on the simulation thread
+    using cqspco::systems::simulation::SimulationThread;
+    simulation_thread = std::make_unique<SimulationThread>(*simulation, GetUniverse());
+    universe_snapshot = simulation_thread->GetSnapshot();
+    system_renderer->SetSnapshot(universe_snapshot);
+    system_renderer->SeeStarSystem();
 }
 
 void cqsp::scene::UniverseScene::Update(float deltaTime) {
     ZoneScoped;
+    // If the simulation is still ticking, only the things that read the snapshot are updated this frame,
+    // so that a long tick doesn't freeze the game
+    universe_lock = simulation_thread->TryLockUniverse();
+    if (stop_skipping) {
+        simulation_thread->Cancel();
+        stop_skipping = false;
+    }
+    skipping = simulation_thread->IsRunningUntil();
 
     if (!game_halted) {
         if (!ImGui::GetIO().WantCaptureKeyboard && GetApp().ButtonIsReleased(engine::KeyInput::KEY_M)) {
@@ -110,37 +141,72 @@ void cqsp::scene::UniverseScene::Update(float deltaTime) {
         system_renderer->Update(deltaTime);
         // Check to see if you have to switch
     }
+    if (universe_lock.owns_lock() && system_renderer->UpdateUniverse()) {
+        // Show the changes now instead of after the next tick
+        simulation_thread->PublishSnapshot();
+    }
 
-    // Check for last tick
-    if (GetUniverse().ToTick() && !game_halted) {
-        // Game tick
-        simulation->tick();
+    auto snapshot = simulation_thread->GetSnapshot();
+    if (snapshot != universe_snapshot) {
+        universe_snapshot = snapshot;
+        system_renderer->SetSnapshot(universe_snapshot);
         system_renderer->OnTick();
     }
 
     DoScreenshot();
 
     if (view_mode) {
-        GetUniverse().clear<cqsp::client::systems::MouseOverEntity>();
-        system_renderer->GetMouseOnObject(GetApp().GetMouseX(), GetApp().GetMouseY());
+        mouse_over_entity = system_renderer->GetMouseOnObject(GetApp().GetMouseX(), GetApp().GetMouseY());
     }
 
+    bool changed = false;
     for (auto& ui : user_interfaces) {
+        if (!universe_lock.owns_lock() && !ui->ReadsSnapshotOnly()) {
+            continue;
+        }
         if (game_halted) {
             ui->window_flags = ImGuiWindowFlags_NoInputs;
         } else {
             ui->window_flags = 0;
         }
         ui->DoUpdate(deltaTime);
+        if (universe_lock.owns_lock()) {
+            changed |= ui->DoUniverseUpdate(deltaTime);
+        }
+    }
+    if (changed) {
+        // Show the changes that the interfaces made, like a renamed city, on the next frame instead of after the
+        // next tick
+        simulation_thread->PublishSnapshot();
     }
 }
 
 void cqsp::scene::UniverseScene::Ui(float deltaTime) {
     for (auto& ui : user_interfaces) {
+        if (!universe_lock.owns_lock() && !ui->ReadsSnapshotOnly()) {
+            continue;
+        }
         ui->DoUI(deltaTime);
     }
-    // Render star system renderer ui
-    system_renderer->DoUI(deltaTime);
+    if (universe_lock.owns_lock()) {
+        // Render star system renderer ui
+        system_renderer->DoUI(deltaTime);
+        universe_lock.unlock();
+    }
+
+    // Run the next ticks while the frame is being rendered
+    if (skip_target >= 0) {
+        if (simulation_thread->RequestTicksUntil(skip_target)) {
+            skip_target = -1;
+            skipping = true;
+        }
+    } else if (GetUniverse().ToTick() && !game_halted) {
+        if (fast_forward) {
+            simulation_thread->RequestTicks(fast_forward_budget);
+        } else {
+            simulation_thread->RequestTick();
+        }
+    }
 }
 
 void cqsp::scene::UniverseScene::Render(float deltaTime) {
@@ -159,15 +225,30 @@ void cqsp::scene::UniverseScene::DoScreenshot() {
     }
 }
 
-entt::entity cqsp::scene::GetCurrentViewingPlanet(cqsp::common::Universe& universe) {
-    return universe.view<cqsp::client::systems::FocusedPlanet>().front();
-}
+entt::entity cqsp::scene::GetCurrentViewingPlanet() { return focused_planet; }
 
-void cqsp::scene::SeePlanet(cqsp::engine::Application& app, entt::entity ent) {
-    app.GetUniverse().clear<cqsp::client::systems::FocusedPlanet>();
-    app.GetUniverse().emplace<cqsp::client::systems::FocusedPlanet>(ent);
-}
+void cqsp::scene::SeePlanet(entt::entity ent) { focused_planet = ent; }
+
+entt::entity cqsp::scene::GetMouseOverEntity() { return mouse_over_entity; }
 
 void cqsp::scene::SetGameHalted(bool b) { game_halted = b; }
 
 bool cqsp::scene::IsGameHalted() { return game_halted; }
+
+std::shared_ptr<const cqsp::common::UniverseSnapshot> cqsp::scene::GetUniverseSnapshot() { return universe_snapshot; }
+
+void cqsp::scene::SetFastForward(bool b) { fast_forward = b; }
+
+bool cqsp::scene::IsFastForward() { return fast_forward; }
+
+void cqsp::scene::SkipToDate(int date) {
+    skip_target = date;
+    stop_skipping = false;
+}
+
+void cqsp::scene::StopSkipping() {
+    skip_target = -1;
+    stop_skipping = true;
+}
+
+bool cqsp::scene::IsSkipping() { return skipping || skip_target >= 0; }
@@ -18,6 +18,7 @@
 
 #include <vector>
 #include <memory>
+#include <mutex>
 #include <utility>
 
 #include "client/systems/views/starsystemview.h"
@@ -30,6 +31,8 @@
 #include "engine/renderer/renderer.h"
 #include "engine/renderer/renderer2d.h"
 #include "common/simulation.h"
+#include "common/simulationthread.h"
+#include "common/universesnapshot.h"
 
 namespace cqsp {
 namespace scene {
@@ -38,6 +41,8 @@ class UniverseScene : public cqsp::engine::Scene {
     explicit UniverseScene(cqsp::engine::Application& app);
     ~UniverseScene() {
         // Delete ui
+        universe_lock = std::unique_lock<std::mutex>();
+        simulation_thread.reset();
         simulation.reset();
         for (auto it = user_interfaces.begin(); it != user_interfaces.end(); it++) {
             it->reset();
@@ -81,6 +86,9 @@ class UniverseScene : public cqsp::engine::Scene {
     cqsp::client::systems::SysStarSystemRenderer* system_renderer;
 
     std::unique_ptr<cqsp::common::systems::simulation::Simulation> simulation;
+    std::unique_ptr<cqsp::common::systems::simulation::SimulationThread> simulation_thread;
+    // Held from the start of `Update` to the end of `Ui` when the simulation is not ticking
+    std::unique_lock<std::mutex> universe_lock;
 
     bool to_show_planet_window = false;
 
@@ -90,10 +98,22 @@ class UniverseScene : public cqsp::engine::Scene {
     std::vector<std::unique_ptr<cqsp::client::systems::SysUserInterface>> user_interfaces;
 };
 
-void SeePlanet(cqsp::engine::Application&, entt::entity);
-entt::entity GetCurrentViewingPlanet(cqsp::common::Universe&);
+// Centers the star system view on the planet, or stops following a planet if it's null
+void SeePlanet(entt::entity);
+entt::entity GetCurrentViewingPlanet();
+// Body that the mouse is over in the star system view
+entt::entity GetMouseOverEntity();
 // Halts all other things
 void SetGameHalted(bool b);
 bool IsGameHalted();
+// Snapshot of the universe taken at the end of the last tick
+std::shared_ptr<const cqsp::common::UniverseSnapshot> GetUniverseSnapshot();
+// Runs as many ticks as fit in a time budget every frame, instead of a tick every few frames
+void SetFastForward(bool b);
+bool IsFastForward();
+// Runs ticks in the background until the date is reached
+void SkipToDate(int date);
+void StopSkipping();
+bool IsSkipping();
 }  // namespace scene
 }  // namespace cqsp
@@ -22,6 +22,7 @@
 #include "common/util/utilnumberdisplay.h"
 
 #include "client/systems/gui/systooltips.h"
+#include "client/scenes/universescene.h"
 
 void cqsp::client::systems::CivilizationInfoPanel::Init() {}
 
@@ -48,32 +49,34 @@ void cqsp::client::systems::CivilizationInfoPanel::DoUpdate(int delta_time) {}
 
 void cqsp::client::systems::CivilizationInfoPanel::CivInfoPanel() {
     ImGui::Text("Information");
+    auto snapshot = cqsp::scene::GetUniverseSnapshot();
+    const entt::registry& registry = snapshot->registry;
     // Get player
-    entt::entity player = GetUniverse()
-                              .view<common::components::Civilization,
-                                    common::components::Player>()
+    entt::entity player = registry
+                              .view<const common::components::Civilization,
+                                    const common::components::Player>()
                               .front();
     ImGui::TextFmt("{}", player);
     if (player == entt::null) {
         return;
     }
     // Make hoverable
-    gui::EntityTooltip(GetUniverse(), player);
-    if (GetUniverse().any_of<common::components::Wallet>(player)) {
-        auto& wallet = GetUniverse().get<common::components::Wallet>(player);
+    gui::EntityTooltip(*snapshot, player);
+    if (registry.any_of<common::components::Wallet>(player)) {
+        auto& wallet = registry.get<common::components::Wallet>(player);
         ImGui::TextFmt("Reserves: {}", util::LongToHumanString(wallet.GetBalance()));
     }
 
     // Collate all the owned stuff
-    auto view = GetUniverse().view<common::components::Governed>();
+    auto view = registry.view<const common::components::Governed>();
     ImGui::Separator();
     ImGui::Text("Owned Cities");
 
     ImGui::BeginChild("ownedcitiespanel");
     for (auto entity : view) {
-        if (GetUniverse().get<common::components::Governed>(entity).governor == player) {
-            ImGui::TextFmt("{}", client::systems::gui::GetName(GetUniverse(), entity));
-            gui::EntityTooltip(GetUniverse(), entity);
+        if (view.get<const common::components::Governed>(entity).governor == player) {
+            ImGui::TextFmt("{}", client::systems::gui::GetName(*snapshot, entity));
+            gui::EntityTooltip(*snapshot, entity);
         }
     }
     ImGui::EndChild();
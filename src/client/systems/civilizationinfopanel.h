@@ -28,6 +28,7 @@ class CivilizationInfoPanel : public SysUserInterface {
     void Init();
     void DoUI(int delta_time);
     void DoUpdate(int delta_time);
+    bool ReadsSnapshotOnly() override { return true; }
 
     void CivInfoPanel();
 
@@ -25,11 +25,14 @@
 #include "client/systems/gui/systooltips.h"
 
 using cqsp::common::Universe;
+using cqsp::common::UniverseSnapshot;
 using cqsp::common::components::Identifier;
 using cqsp::util::LongToHumanString;
 using cqsp::common::components::ResourceLedger;
-bool cqsp::client::systems::DrawLedgerTable(const std::string &name, const Universe &universe,
-                                                                        const ResourceLedger& ledger) {
+namespace {
+// Draws the ledger, with the names of the goods from either the universe or the snapshot
+template <typename Source>
+bool DrawLedger(const std::string &name, const Source &source, const ResourceLedger& ledger) {
     if (ledger.empty()) {
         ImGui::Text("Empty ledger");
         return false;
@@ -42,7 +45,7 @@ bool cqsp::client::systems::DrawLedgerTable(const std::string &name, const Unive
                                     iterator != ledger.end(); iterator++) {
             ImGui::TableNextRow();
             ImGui::TableSetColumnIndex(0);
-            ImGui::TextFmt("{}", gui::GetName(universe, iterator->first));
+            ImGui::TextFmt("{}", cqsp::client::systems::gui::GetName(source, iterator->first));
             ImGui::TableSetColumnIndex(1);
             ImGui::TextFmt("{}", LongToHumanString(static_cast<int64_t>(iterator->second)));
         }
@@ -50,3 +53,14 @@ bool cqsp::client::systems::DrawLedgerTable(const std::string &name, const Unive
     }
     return true;
 }
+}  // namespace
+
+bool cqsp::client::systems::DrawLedgerTable(const std::string &name, const Universe &universe,
+                                                                        const ResourceLedger& ledger) {
+    return DrawLedger(name, universe, ledger);
+}
+
+bool cqsp::client::systems::DrawLedgerTable(const std::string &name, const UniverseSnapshot &snapshot,
+                                            const ResourceLedger& ledger) {
+    return DrawLedger(name, snapshot, ledger);
+}
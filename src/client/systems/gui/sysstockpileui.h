@@ -21,6 +21,7 @@
 #include <entt/entt.hpp>
 
 #include "common/universe.h"
+#include "common/universesnapshot.h"
 #include "common/components/resource.h"
 
 namespace cqsp {
@@ -28,6 +29,11 @@ namespace client {
 namespace systems {
 bool DrawLedgerTable(const std::string &name, const cqsp::common::Universe&,
                         const cqsp::common::components::ResourceLedger& ledger);
+/// <summary>
+/// Same as above, but reads the names of the goods from the snapshot.
+/// </summary>
+bool DrawLedgerTable(const std::string &name, const cqsp::common::UniverseSnapshot&,
+                        const cqsp::common::components::ResourceLedger& ledger);
 }  // namespace systems
 }  // namespace client
 }  // namespace cqsp
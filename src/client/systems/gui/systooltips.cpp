@@ -64,7 +64,7 @@ void ResourceTooltipSection(const Universe &universe, entt::entity entity) {
         ImGui::TextFmt("Resources");
         // Then do demand
         cqsp::client::systems::DrawLedgerTable(
-            "resourcesstockpiletooltip", universe, universe.get<cqspc::ResourceStockpile>(entity));
+            "resourcesstockpiletooltip", universe, universe.get<cqspc::ResourceStockpile>(entity).ToLedger());
     }
     if (universe.all_of<cqspc::FactoryProducing>(entity)) {
         ImGui::Text("Producing next tick");
@@ -79,7 +79,7 @@ void ResourceTooltipSection(const Universe &universe, entt::entity entity) {
         ImGui::TextFmt("Generating");
         // Then do demand
         cqsp::client::systems::DrawLedgerTable(
-            "factorygentooltip", universe, universe.get<cqspc::ResourceGenerator>(entity));
+            "factorygentooltip", universe, universe.get<cqspc::ResourceGenerator>(entity).ToLedger());
     }
 
     if (universe.all_of<cqspc::infrastructure::PowerConsumption>(entity)) {
@@ -90,59 +90,65 @@ void ResourceTooltipSection(const Universe &universe, entt::entity entity) {
         ImGui::TextFmt("Min Power: {}", consumption.min);
     }
 }
-}  // namespace
 
-namespace cqsp::client::systems::gui {
-std::string GetName(const Universe& universe, entt::entity entity) {
-    namespace cqspc = cqsp::common::components;
-    if (universe.all_of<cqspc::Name>(entity)) {
-        return universe.get<cqspc::Name>(entity);
-    } else if (universe.all_of<cqspc::Identifier>(entity)) {
-        return universe.get<cqspc::Identifier>(entity);
-    } else {
-        return fmt::format("{}", entity);
-    }
-}
-
-std::string GetEntityType(const cqsp::common::Universe& universe, entt::entity entity) {
+// The type of the entity, with the components read from the registry, and the names from the universe or the snapshot
+template <typename Source>
+std::string EntityType(const entt::registry& registry, const Source& source, entt::entity entity) {
     namespace cqspc = cqsp::common::components;
     // Then get type of entity
     if (entity == entt::null) {
         return "Null Entity";
     }
-    if (universe.all_of<cqspc::bodies::Star>(entity)) {
+    if (registry.all_of<cqspc::bodies::Star>(entity)) {
         return "Star";
-    } else if (universe.all_of<cqspc::bodies::Planet>(entity)) {
+    } else if (registry.all_of<cqspc::bodies::Planet>(entity)) {
         return  "Planet";
-    } else if (universe.any_of<cqspc::Settlement, cqspc::Habitation>(entity)) {
+    } else if (registry.any_of<cqspc::Settlement, cqspc::Habitation>(entity)) {
         return  "City";
-    } else if (universe.any_of<cqspc::Mine>(entity)) {
+    } else if (registry.any_of<cqspc::Mine>(entity)) {
         std::string production = "";
-        auto& generator = universe.get<cqspc::ResourceGenerator>(entity);
+        auto& generator = registry.get<cqspc::ResourceGenerator>(entity);
         for (auto it = generator.begin(); it != generator.end(); ++it) {
-            production += universe.get<cqspc::Name>(it->first).name + ", ";
+            production += registry.get<cqspc::Name>(it->first).name + ", ";
         }
         // Remove last comma
         if (!production.empty()) {
             production = production.substr(0, production.size() - 2);
         }
         return fmt::format("{} Mine", production);
-    } else if (universe.any_of<cqspc::Factory>(entity)) {
+    } else if (registry.any_of<cqspc::Factory>(entity)) {
         std::string production = "";
-        auto& generator = universe.get<cqspc::ResourceConverter>(entity);
-        return fmt::format("{} Factory", cqsp::client::systems::gui::GetName(universe, generator.recipe));
-    } else if (universe.any_of<cqspc::Player>(entity)) {
+        auto& generator = registry.get<cqspc::ResourceConverter>(entity);
+        return fmt::format("{} Factory", cqsp::client::systems::gui::GetName(source, generator.recipe));
+    } else if (registry.any_of<cqspc::Player>(entity)) {
         return "Player";
-    } else if (universe.any_of<cqspc::Civilization>(entity)) {
+    } else if (registry.any_of<cqspc::Civilization>(entity)) {
         return "Civilization";
-    } else if (universe.any_of<cqspc::Organization>(entity)) {
+    } else if (registry.any_of<cqspc::Organization>(entity)) {
         return "Organization";
-    } else if (universe.any_of<cqspc::science::Lab>(entity)) {
+    } else if (registry.any_of<cqspc::science::Lab>(entity)) {
         return "Science Lab";
     } else {
         return "Unknown";
     }
 }
+}  // namespace
+
+namespace cqsp::client::systems::gui {
+std::string GetName(const Universe& universe, entt::entity entity) {
+    namespace cqspc = cqsp::common::components;
+    if (universe.all_of<cqspc::Name>(entity)) {
+        return universe.get<cqspc::Name>(entity);
+    } else if (universe.all_of<cqspc::Identifier>(entity)) {
+        return universe.get<cqspc::Identifier>(entity);
+    } else {
+        return fmt::format("{}", entity);
+    }
+}
+
+std::string GetEntityType(const cqsp::common::Universe& universe, entt::entity entity) {
+    return EntityType(universe, universe, entity);
+}
 
 // TODO(EhWhoAmI): Organize this so that it makes logical sense and order.
 void EntityTooltip(const Universe &universe, entt::entity entity) {
@@ -219,4 +225,75 @@ void EntityTooltip(const Universe &universe, entt::entity entity) {
     ResourceTooltipSection(universe, entity);
     ImGui::EndTooltip();
 }
+
+std::string GetName(const cqsp::common::UniverseSnapshot& snapshot, entt::entity entity) {
+    namespace cqspc = cqsp::common::components;
+    const entt::registry& registry = snapshot.registry;
+    if (!registry.valid(entity)) {
+        return fmt::format("{}", entity);
+    } else if (registry.all_of<cqspc::Name>(entity)) {
+        return registry.get<cqspc::Name>(entity);
+    } else if (registry.all_of<cqspc::Identifier>(entity)) {
+        return registry.get<cqspc::Identifier>(entity);
+    } else {
+        return fmt::format("{}", entity);
+    }
+}
+
+std::string GetEntityType(const cqsp::common::UniverseSnapshot& snapshot, entt::entity entity) {
+    return EntityType(snapshot.registry, snapshot, entity);
+}
+
+void EntityTooltip(const cqsp::common::UniverseSnapshot& snapshot, entt::entity entity) {
+    if (!ImGui::IsItemHovered()) {
+        return;
+    }
+    namespace cqspc = cqsp::common::components;
+    const entt::registry& registry = snapshot.registry;
+    ImGui::BeginTooltip();
+    ImGui::TextFmt("{}", GetName(snapshot, entity));
+    if (!registry.valid(entity)) {
+        if (entity == entt::null) {
+            ImGui::TextColored(ImVec4(1.f, 0.f, 0.f, 1.f), "Null entity!");
+        }
+        ImGui::EndTooltip();
+        return;
+    }
+    if (registry.all_of<cqspc::Player>(entity)) {
+        ImGui::TextColored(ImColor(252, 186, 3), "Player");
+    }
+
+    if (registry.all_of<cqspc::Wallet>(entity)) {
+        ImGui::TextFmt("Wallet: {}", registry.get<cqspc::Wallet>(entity).GetBalance());
+    }
+    if (registry.all_of<cqspc::types::Kinematics>(entity)) {
+        auto& a = registry.get<cqspc::types::Kinematics>(entity);
+        ImGui::TextFmt("Position: {} {} {} ({})", a.position.x, a.position.y, a.position.z, glm::length(a.position));
+        ImGui::TextFmt("Velocity: {} {} {} ({})", a.velocity.x, a.velocity.y,
+                       a.velocity.z, glm::length(a.velocity));
+    }
+    if (registry.all_of<cqspc::Governed>(entity)) {
+        auto& governed = registry.get<cqspc::Governed>(entity);
+        ImGui::TextFmt("Owned by: {}", GetName(snapshot, governed.governor));
+    }
+    if (registry.all_of<cqspc::bodies::Body>(entity)) {
+        auto& body = registry.get<cqspc::bodies::Body>(entity);
+        ImGui::TextFmt("Rotation: {} days", body.rotation / 86400);
+        ImGui::Separator();
+        ImGui::TextFmt("Radius: {:.3g} km", body.radius);
+        ImGui::TextFmt("Mass: {:.3g} kg", body.mass);
+        ImGui::TextFmt("SOI: {:.3g} km", body.SOI);
+    }
+    if (registry.all_of<cqspc::types::Orbit>(entity)) {
+        auto& orbit = registry.get<cqspc::types::Orbit>(entity);
+        ImGui::Separator();
+        ImGui::TextFmt("Semi Major Axis: {}", orbit.semi_major_axis);
+        ImGui::TextFmt("Inclination: {}", orbit.inclination);
+        ImGui::TextFmt("Eccentricity: {}", orbit.eccentricity);
+        ImGui::TextFmt("Longitude of Linear Node: {}", orbit.LAN);
+        ImGui::TextFmt("Argument of Periapsis: {}", orbit.w);
+        ImGui::TextFmt("True Anomaly: {}", orbit.v);
+    }
+    ImGui::EndTooltip();
+}
 }  // namespace cqsp::client::systems::gui
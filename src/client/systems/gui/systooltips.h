@@ -21,6 +21,7 @@
 #include <entt/entt.hpp>
 
 #include "common/universe.h"
+#include "common/universesnapshot.h"
 
 namespace cqsp::client::systems::gui {
 /// <summary>
@@ -34,4 +35,12 @@ std::string GetName(const cqsp::common::Universe &universe,
                     entt::entity entity);
 void EntityTooltip(const cqsp::common::Universe &, entt::entity);
 std::string GetEntityType(const cqsp::common::Universe &, entt::entity);
+
+/// <summary>
+/// Same as above, but reads the snapshot, for the interfaces that are shown while the simulation is ticking.
+/// The tooltip only shows the components that are in the snapshot.
+/// </summary>
+std::string GetName(const cqsp::common::UniverseSnapshot &snapshot, entt::entity entity);
+void EntityTooltip(const cqsp::common::UniverseSnapshot &, entt::entity);
+std::string GetEntityType(const cqsp::common::UniverseSnapshot &, entt::entity);
 }  // namespace cqsp::client::systems::gui
@@ -54,14 +54,16 @@ void cqsp::client::systems::SysCommand::DoUI(int delta_time) {
     ImGui::Begin("Order Target", &to_see,
                  ImGuiWindowFlags_NoResize | window_flags);
     int index = 0;
+    auto snapshot = cqsp::scene::GetUniverseSnapshot();
+    const entt::registry& registry = snapshot->registry;
     // Get selected planet
-    auto system = GetApp().GetUniverse().view<common::components::types::Orbit>();
-    entt::entity current_planet = cqsp::scene::GetCurrentViewingPlanet(GetUniverse());
+    auto system = registry.view<const common::components::types::Orbit>();
+    entt::entity current_planet = cqsp::scene::GetCurrentViewingPlanet();
     for (auto entity : system) {
         bool is_selected = (entity == current_planet);
         std::string planet_name = fmt::format("{}", entity);
-        if (GetUniverse().all_of<Name>(entity)) {
-            planet_name = fmt::format("{}", GetUniverse().get<Name>(entity).name);
+        if (registry.all_of<Name>(entity)) {
+            planet_name = fmt::format("{}", registry.get<Name>(entity).name);
         }
 
         if (CQSPGui::DefaultSelectable(planet_name.c_str(),
@@ -70,11 +72,13 @@ void cqsp::client::systems::SysCommand::DoUI(int delta_time) {
             selected_index = index;
             if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left) && selected_ship!= entt::null) {
                 // Go to the planet
-                GetUniverse().emplace_or_replace<cqspt::MoveTarget>(selected_ship, entity);
+                queued_actions.push_back([ship = selected_ship, entity](common::Universe& universe) {
+                    universe.emplace_or_replace<cqspt::MoveTarget>(ship, entity);
+                });
                 SPDLOG_INFO("Move Ordered");
             }
         }
-        gui::EntityTooltip(GetUniverse(), entity);
+        gui::EntityTooltip(*snapshot, entity);
         index++;
     }
     ImGui::End();
@@ -83,7 +87,7 @@ void cqsp::client::systems::SysCommand::DoUI(int delta_time) {
 void cqsp::client::systems::SysCommand::DoUpdate(int delta_time) {
     namespace cqspb = cqsp::common::components::bodies;
     namespace cqspt = cqsp::common::components::types;
-    selected_planet = cqsp::scene::GetCurrentViewingPlanet(GetUniverse());
+    selected_planet = cqsp::scene::GetCurrentViewingPlanet();
     /*entt::entity mouse_over = GetUniverse()
             .view<cqsp::client::systems::MouseOverEntity, cqspt::Kinematics>().front();
     if (!ImGui::GetIO().WantCaptureMouse &&
@@ -93,26 +97,36 @@ void cqsp::client::systems::SysCommand::DoUpdate(int delta_time) {
     }*/
 }
 
+bool cqsp::client::systems::SysCommand::DoUniverseUpdate(int delta_time) {
+    bool changed = !queued_actions.empty();
+    for (auto& action : queued_actions) {
+        action(GetUniverse());
+    }
+    queued_actions.clear();
+    return changed;
+}
+
 void cqsp::client::systems::SysCommand::ShipList() {
     namespace cqspcs = cqsp::client::systems;
     namespace cqspb = cqsp::common::components::bodies;
     namespace cqsps = cqsp::common::components::ships;
     namespace cqspc = cqsp::common::components;
 
-
-    static entt::entity selectedFleetEnt = GetUniverse()
-                           .get<cqspc::Civilization>(GetUniverse()
-                           .view<cqspc::Player>()
+    auto snapshot = cqsp::scene::GetUniverseSnapshot();
+    const entt::registry& registry = snapshot->registry;
+    static entt::entity selectedFleetEnt = registry
+                           .get<cqspc::Civilization>(registry
+                           .view<const cqspc::Player>()
                            .front()).top_level_fleet;
 
-    auto& selectedFleet = GetUniverse().get<cqsps::Fleet>(selectedFleetEnt);
-    auto& selectedFleetName = GetUniverse().get<cqspc::Name>(selectedFleetEnt);
+    auto& selectedFleet = registry.get<cqsps::Fleet>(selectedFleetEnt);
+    auto& selectedFleetName = registry.get<cqspc::Name>(selectedFleetEnt);
 
 
 
     std::stringstream finalSelectedFleetName;
     for (size_t i = 0; i < selectedFleet.echelon; i++) {
-        finalSelectedFleetName << GetUniverse()
+        finalSelectedFleetName << registry
                                       .get<cqsp::common::components::Name>(
                                           selectedFleet.parent_fleet)
                                       .name
@@ -130,7 +144,7 @@ void cqsp::client::systems::SysCommand::ShipList() {
     for (entt::entity enti : selectedFleet.ships) {
         index++;
         const bool is_selected = (selected == index);
-        std::string entity_name = cqsp::client::systems::gui::GetName(GetUniverse(), enti);
+        std::string entity_name = cqsp::client::systems::gui::GetName(*snapshot, enti);
         if (CQSPGui::DefaultSelectable(entity_name.c_str(), is_selected)) {
             selected = index;
             to_see = true;
@@ -153,7 +167,7 @@ void cqsp::client::systems::SysCommand::ShipList() {
         entity_name << (i == (subfleetsAndLast.size() - 1) && has_parent
             ? "<-"
             : "->")
-                    << cqsp::client::systems::gui::GetName(GetUniverse(),
+                    << cqsp::client::systems::gui::GetName(*snapshot,
                                                            subfleetsAndLast[i]);
         if (CQSPGui::DefaultSelectable(entity_name.str().c_str(),
                                        is_selected)) {
@@ -16,6 +16,9 @@
 */
 #pragma once
 
+#include <functional>
+#include <vector>
+
 #include "client/systems/sysgui.h"
 
 namespace cqsp {
@@ -29,12 +32,16 @@ class SysCommand : public SysUserInterface {
     void Init();
     void DoUI(int delta_time);
     void DoUpdate(int delta_time);
+    bool ReadsSnapshotOnly() override { return true; }
+    bool DoUniverseUpdate(int delta_time) override;
 
     bool to_see = false;
  private:
     int selected_index = 0;
     entt::entity selected_planet = entt::null;
     entt::entity selected_ship = entt::null;
+    // Orders to the ships, which are given the next time the universe is locked
+    std::vector<std::function<void(common::Universe&)>> queued_actions;
     void ShipList();
 };
 }  // namespace systems
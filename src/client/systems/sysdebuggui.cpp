@@ -20,6 +20,7 @@
 #include <GLFW/glfw3.h>
 
 #include "client/systems/views/starsystemview.h"
+#include "client/scenes/universescene.h"
 #include "client/components/clientctx.h"
 #include "common/components/name.h"
 #include "common/util/profiler.h"
@@ -36,8 +37,7 @@ SysDebugMenu::SysDebugMenu(Application& app) : SysUserInterface(app) {
     };
 
     auto entity_command = [](Application& app, const string_view& args, CommandOutput& input) {
-        using cqsp::client::systems::MouseOverEntity;
-        entt::entity ent = app.GetUniverse().view<MouseOverEntity>().front();
+        entt::entity ent = cqsp::scene::GetMouseOverEntity();
         if (ent == entt::null) {
             input.push_back(fmt::format("Mouse is over null"));
         } else {
@@ -54,6 +54,18 @@ SysDebugMenu::SysDebugMenu(Application& app) : SysUserInterface(app) {
                         app.GetUniverse().size(), app.GetUniverse().alive()));
     };
 
+    auto memory = [&](Application& app, const string_view& args, CommandOutput& input) {
+        // Show the largest components, unless a number of rows is given
+        size_t rows = 15;
+        if (!args.empty() && std::all_of(args.begin(), args.end(), ::isdigit)) {
+            rows = atoi(args.data());
+        }
+        auto report = memory_tracker.Sample(app.GetUniverse());
+        for (std::string& line : report.Format(rows)) {
+            input.push_back(std::move(line));
+        }
+    };
+
     auto entity_name = [](Application& app, const string_view& args, CommandOutput& input) {
         if (std::all_of(args.begin(), args.end(), ::isdigit)) {
             namespace cqspc = cqsp::common::components;
@@ -80,6 +92,7 @@ SysDebugMenu::SysDebugMenu(Application& app) : SysUserInterface(app) {
         {"mouseon", {"Get the entitiy the mouse is over", entity_command}},
         {"clear", {"Clears screen", screen_clear}},
         {"entitycount", {"Gets number of entities", entitycount}},
+        {"memory", {"Shows the memory used by each component, and the growth since the last time", memory}},
         {"name", {"Gets name and identifier of entity", entity_name}},
         {"lua", {"Executes lua script", lua}
 }
@@ -114,7 +127,10 @@ void SysDebugMenu::CqspMetricsWindow() {
             }
             ImPlot::EndPlot();
         }
-        profiler_information_map.clear();
+        {
+            std::lock_guard<std::mutex> lock(profiler_information_mutex);
+            profiler_information_map.clear();
+        }
         ImGui::End();
 }
 
@@ -188,26 +204,9 @@ void cqsp::client::systems::SysDebugMenu::ConsoleInput() {
     if (ImGui::InputText("DebugInput", &command, ImGuiInputTextFlags_EnterReturnsTrue |
                              ImGuiInputTextFlags_CallbackCompletion |
                              ImGuiInputTextFlags_CallbackHistory)) {
-        std::string command_request = std::string(command);
-        std::transform(command_request.begin(), command_request.end(), command_request.begin(),
-                    [](unsigned char c){ return std::tolower(c); });
-        if (!command_request.empty()) {
-            bool no_command = true;
-            for (auto it = commands.begin(); it != commands.end(); it++) {
-                if (command_request.rfind(it->first, 0) != 0) {
-                    continue;
-                }
-                it->second.second(GetApp(), command.length() == it->first.length() ? "" :
-                                                command.substr(it->first.length()+1) , items);
-                no_command = false;
-                break;
-            }
-            if (no_command) {
-                items.push_back("#Command does not exist!");
-            }
-
+        if (!command.empty()) {
+            queued_commands.push_back(command);
             command = "";
-            scroll_to_bottom = true;
         }
         reclaim_focus = true;
     }
@@ -220,6 +219,26 @@ void cqsp::client::systems::SysDebugMenu::ConsoleInput() {
     }
 }
 
+void cqsp::client::systems::SysDebugMenu::RunCommand(const std::string& input) {
+    std::string command_request = input;
+    std::transform(command_request.begin(), command_request.end(), command_request.begin(),
+                [](unsigned char c){ return std::tolower(c); });
+    bool no_command = true;
+    for (auto it = commands.begin(); it != commands.end(); it++) {
+        if (command_request.rfind(it->first, 0) != 0) {
+            continue;
+        }
+        it->second.second(GetApp(), input.length() == it->first.length() ? "" :
+                                        input.substr(it->first.length()+1) , items);
+        no_command = false;
+        break;
+    }
+    if (no_command) {
+        items.push_back("#Command does not exist!");
+    }
+    scroll_to_bottom = true;
+}
+
 void SysDebugMenu::DoUI(int delta_time) {
     ShowWindows();
     if (!to_show_window) {
@@ -256,6 +275,7 @@ void SysDebugMenu::DoUpdate(int delta_time) {
     }
     fps_history.push_back(ImVec2(time, fps));
 
+    std::lock_guard<std::mutex> lock(profiler_information_mutex);
     for (auto it = profiler_information_map.begin(); it != profiler_information_map.end(); it++) {
         if (!history_maps[it->first].empty() &&
             (history_maps[it->first].begin()->x + fps_history_len) < time) {
@@ -264,8 +284,16 @@ void SysDebugMenu::DoUpdate(int delta_time) {
 
         history_maps[it->first].push_back(ImVec2(time, it->second));
     }
+}
+
+bool SysDebugMenu::DoUniverseUpdate(int delta_time) {
+    bool changed = !queued_commands.empty();
+    for (const std::string& queued : queued_commands) {
+        RunCommand(queued);
+    }
+    queued_commands.clear();
 
-    // Add lua logging information
+    // Add lua logging information, which scripts write to while ticking
     if (!GetApp().GetScriptInterface().values.empty()) {
         // Fill up the things
         for (auto str : GetApp().GetScriptInterface().values) {
@@ -273,4 +301,5 @@ void SysDebugMenu::DoUpdate(int delta_time) {
         }
         GetApp().GetScriptInterface().values.clear();
     }
+    return changed;
 }
@@ -24,6 +24,7 @@
 #include <utility>
 
 #include "client/systems/sysgui.h"
+#include "common/systems/memoryreport.h"
 
 namespace cqsp {
 namespace client {
@@ -35,6 +36,8 @@ class SysDebugMenu : public SysUserInterface {
     void Init();
     void DoUI(int delta_time);
     void DoUpdate(int delta_time);
+    bool ReadsSnapshotOnly() override { return true; }
+    bool DoUniverseUpdate(int delta_time) override;
 
  private:
     void CqspMetricsWindow();
@@ -42,6 +45,7 @@ class SysDebugMenu : public SysUserInterface {
     void CreateMenuBar();
     void DrawConsole();
     void ConsoleInput();
+    void RunCommand(const std::string& input);
 
     bool to_show_window = false;
     bool to_show_metrics_window = false;
@@ -52,6 +56,8 @@ class SysDebugMenu : public SysUserInterface {
     bool to_show_cqsp_metrics = false;
     std::string command;
     std::vector<std::string> items;
+    // Commands read and change the universe, so they're run when it's locked
+    std::vector<std::string> queued_commands;
 
     typedef std::vector<std::string> CommandOutput;
     typedef std::function<void(cqsp::engine::Application& app,
@@ -62,6 +68,8 @@ class SysDebugMenu : public SysUserInterface {
     float fps_history_len = 10;
 
     std::map<std::string, std::vector<ImVec2>> history_maps;
+
+    cqsp::common::systems::memory::MemoryTracker memory_tracker;
 };
 }  // namespace systems
 }  // namespace client
@@ -28,6 +28,19 @@ class SysUserInterface {
     virtual void DoUI(int delta_time) = 0;
     virtual void DoUpdate(int delta_time) = 0;
 
+    /// <summary>
+    /// If the interface only reads the simulation state from the universe snapshot, so it can be
+    /// updated while the simulation is ticking. Other interfaces are skipped until the tick is complete.
+    /// </summary>
+    virtual bool ReadsSnapshotOnly() { return false; }
+
+    /// <summary>
+    /// Called after `DoUpdate` on the frames where the universe is locked. Interfaces that read the
+    /// snapshot only can do the work that needs the live universe here, like running debug commands.
+    /// </summary>
+    /// <returns>If the universe was changed, so that a new snapshot is published</returns>
+    virtual bool DoUniverseUpdate(int delta_time) { return false; }
+
     cqsp::engine::Application &GetApp() { return m_app; }
     cqsp::common::Universe &GetUniverse() { return GetApp().GetUniverse(); }
     cqsp::asset::AssetManager &GetAssetManager() {
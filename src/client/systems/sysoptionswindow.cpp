@@ -113,6 +113,20 @@ void ShowOptionsWindow(bool* open, cqsp::engine::Application& app) {
             }
             ImGui::EndTabItem();
         }
+        if (ImGui::BeginTabItem("Simulation")) {
+            static bool amortize_checkbox = static_cast<bool>(
+                app.GetClientOptions().GetOptions()["simulation"]["amortize"]);
+            ImGui::Text("Spread out systems over every tick");
+            ImGui::SameLine();
+            if (CQSPGui::DefaultCheckbox("##Amortize", &amortize_checkbox)) {
+                // Read when a game is started
+                app.GetClientOptions().GetOptions()["simulation"]["amortize"] = amortize_checkbox;
+            }
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("Smooths out the frame rate, but games play out differently than with it off");
+            }
+            ImGui::EndTabItem();
+        }
         ImGui::EndTabBar();
     }
 
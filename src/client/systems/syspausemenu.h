@@ -29,6 +29,7 @@ class SysPauseMenu : public SysUserInterface {
     void Init();
     void DoUI(int delta_time);
     void DoUpdate(int delta_time);
+    bool ReadsSnapshotOnly() override { return true; }
 
  private:
     bool to_show = false;
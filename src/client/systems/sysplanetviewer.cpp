@@ -68,7 +68,7 @@ void SysPlanetInformation::DisplayPlanet() {
     ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x * 0.79f,
                                    ImGui::GetIO().DisplaySize.y * 0.55f),
                             ImGuiCond_Appearing, ImVec2(0.5f, 0.5f));
-    if (SysStarSystemRenderer::IsFoundingCity(GetUniverse())) {
+    if (is_founding_city) {
         ImGui::SetNextWindowCollapsed(true, ImGuiCond_Always);
     } else {
         ImGui::SetNextWindowCollapsed(false, ImGuiCond_Always);
@@ -77,8 +77,8 @@ void SysPlanetInformation::DisplayPlanet() {
     if (selected_planet == entt::null) {
         return;
     }
-    if (GetUniverse().all_of<cqspc::Name>(selected_planet)) {
-        planet_name = GetUniverse().get<cqspc::Name>(selected_planet);
+    if (snapshot->registry.all_of<cqspc::Name>(selected_planet)) {
+        planet_name = snapshot->registry.get<cqspc::Name>(selected_planet);
     }
     ImGui::Begin(planet_name.c_str(), &to_see, window_flags | ImGuiWindowFlags_NoCollapse);
     switch (view_mode) {
@@ -115,7 +115,10 @@ void SysPlanetInformation::DoUI(int delta_time) {
         if (ImGui::Button("Rename")) {
             renaming_city = false;
             using cqsp::common::components::Name;
-            GetUniverse().get<Name>(selected_city_entity).name = city_founding_name;
+            queued_actions.push_back([city = selected_city_entity,
+                                      name = city_founding_name](common::Universe& universe) {
+                universe.get<Name>(city).name = name;
+            });
         }
         ImGui::End();
     }
@@ -125,8 +128,9 @@ void SysPlanetInformation::DoUpdate(int delta_time) {
     // If clicked on a planet, go to the planet
     // Get the thing
     namespace cqspb = cqsp::common::components::bodies;
-    selected_planet = cqsp::scene::GetCurrentViewingPlanet(GetUniverse());
-    entt::entity mouse_over = GetUniverse().view<MouseOverEntity>().front();
+    snapshot = cqsp::scene::GetUniverseSnapshot();
+    selected_planet = cqsp::scene::GetCurrentViewingPlanet();
+    entt::entity mouse_over = cqsp::scene::GetMouseOverEntity();
     if (!ImGui::GetIO().WantCaptureMouse &&
                 GetApp().MouseButtonIsReleased(GLFW_MOUSE_BUTTON_LEFT) &&
                 mouse_over == selected_planet && !cqsp::scene::IsGameHalted() &&
@@ -134,40 +138,69 @@ void SysPlanetInformation::DoUpdate(int delta_time) {
         to_see = true;
         SPDLOG_INFO("Switched entity");
     }
-    if (!GetUniverse().valid(selected_planet) || !GetUniverse().all_of<cqspb::Body>(selected_planet)) {
+    if (!snapshot->registry.valid(selected_planet) || !snapshot->registry.all_of<cqspb::Body>(selected_planet)) {
         to_see = false;
     }
 }
 
+bool SysPlanetInformation::DoUniverseUpdate(int delta_time) {
+    common::Universe& universe = GetUniverse();
+    bool changed = !queued_actions.empty();
+    for (auto& action : queued_actions) {
+        action(universe);
+    }
+    queued_actions.clear();
+    is_founding_city = SysStarSystemRenderer::IsFoundingCity(universe);
+
+    // Copy the history of the market that is shown
+    entt::entity market = entt::null;
+    if (market_information_panel && universe.valid(selected_planet) &&
+        universe.all_of<cqspc::MarketCenter>(selected_planet)) {
+        market = universe.get<cqspc::MarketCenter>(selected_planet).market;
+    }
+    if (market == entt::null || !universe.all_of<cqspc::MarketHistory>(market)) {
+        market_history = cqspc::MarketHistory();
+        market_history_market = entt::null;
+    } else if (market != market_history_market || universe.date.GetDate() != market_history_date || changed) {
+        market_history = universe.get<cqspc::MarketHistory>(market);
+        market_history_market = market;
+        market_history_date = universe.date.GetDate();
+    }
+    return changed;
+}
+
 void SysPlanetInformation::CityInformationPanel() {
     if (CQSPGui::ArrowButton("cityinformationpanel", ImGuiDir_Left)) {
         view_mode = ViewMode::PLANET_VIEW;
     }
     ImGui::SameLine();
 
-    ImGui::TextFmt("{}", GetUniverse().get<cqspc::Name>(selected_city_entity).name);
+    const entt::registry& registry = snapshot->registry;
+    ImGui::TextFmt("{}", registry.get<cqspc::Name>(selected_city_entity).name);
     if (ImGui::IsItemClicked(ImGuiMouseButton_Left)) {
         // Then rename the city
         renaming_city = true;
-        city_founding_name = GetUniverse().get<cqspc::Name>(selected_city_entity).name;
+        city_founding_name = registry.get<cqspc::Name>(selected_city_entity).name;
     }
     ImGui::SameLine();
     if (ImGui::Button("Focus on city")) {
         // Focus city
-        GetApp().GetUniverse().emplace_or_replace<FocusedCity>(selected_city_entity);
+        queued_actions.push_back([city = selected_city_entity](common::Universe& universe) {
+            universe.emplace_or_replace<FocusedCity>(city);
+        });
     }
 
-    if (GetUniverse().all_of<cqspc::Settlement>(selected_city_entity)) {
-        int size = GetUniverse().get<cqspc::Settlement>(selected_city_entity).population.size();
-        for (auto seg_entity : GetUniverse().get<cqspc::Settlement>(selected_city_entity).population) {
-            auto& pop_segement = GetUniverse().get<cqspc::PopulationSegment>(seg_entity);
+    if (registry.all_of<cqspc::Settlement>(selected_city_entity)) {
+        int size = registry.get<cqspc::Settlement>(selected_city_entity).population.size();
+        for (auto seg_entity : registry.get<cqspc::Settlement>(selected_city_entity).population) {
+            auto& pop_segement = registry.get<cqspc::PopulationSegment>(seg_entity);
             ImGui::TextFmt("Population: {}", cqsp::util::LongToHumanString(pop_segement.population));
         }
     } else {
         ImGui::TextFmt("No population");
     }
 
-    if (GetUniverse().all_of<cqspc::Industry>(selected_city_entity)) {
+    if (registry.all_of<cqspc::Industry>(selected_city_entity)) {
         if (ImGui::BeginTabBar("CityTabs", ImGuiTabBarFlags_None)) {
             if (ImGui::BeginTabItem("Demographics")) {
                 DemographicsTab();
@@ -193,7 +226,7 @@ void SysPlanetInformation::CityInformationPanel() {
                 ScienceTab();
                 ImGui::EndTabItem();
             }
-            if (GetUniverse().any_of<cqspc::infrastructure::SpacePort>(selected_city_entity)) {
+            if (registry.any_of<cqspc::infrastructure::SpacePort>(selected_city_entity)) {
                 if (ImGui::BeginTabItem("Space Port")) {
                     SpacePortTab();
                     ImGui::EndTabItem();
@@ -205,16 +238,17 @@ void SysPlanetInformation::CityInformationPanel() {
 }
 
 void SysPlanetInformation::PlanetInformationPanel() {
-    if (!GetUniverse().all_of<cqspc::Habitation>(selected_planet)) {
+    const entt::registry& registry = snapshot->registry;
+    if (!registry.all_of<cqspc::Habitation>(selected_planet)) {
         return;
     }
-    auto& habit = GetUniverse().get<cqspc::Habitation>(selected_planet);
+    auto& habit = registry.get<cqspc::Habitation>(selected_planet);
     ImGui::TextFmt("Cities: {}", habit.settlements.size());
 
     ImGui::BeginChild("citylist", ImVec2(0, 0), false, ImGuiWindowFlags_HorizontalScrollbar |
                                         window_flags);
     // Market
-    if (GetUniverse().all_of<cqspc::MarketCenter>(selected_planet)) {
+    if (registry.all_of<cqspc::MarketCenter>(selected_planet)) {
         if (ImGui::Button("Is market center")) {
             market_information_panel = true;
         }
@@ -225,16 +259,18 @@ void SysPlanetInformation::PlanetInformationPanel() {
 
     if (ImGui::Button("Found City")) {
         // Enable city founding
-        entt::entity ent = GetUniverse().create();
-        GetUniverse().emplace<CityFounding>(ent);
+        queued_actions.push_back([](common::Universe& universe) {
+            entt::entity ent = universe.create();
+            universe.emplace<CityFounding>(ent);
+        });
         is_founding_city = true;
     }
 
     // Get population
     uint64_t pop_size = 0;
     for (entt::entity settlement : habit.settlements) {
-        for (entt::entity population : GetUniverse().get<cqspc::Settlement>(settlement).population) {
-            pop_size += GetUniverse().get<cqspc::PopulationSegment>(population).population;
+        for (entt::entity population : registry.get<cqspc::Settlement>(settlement).population) {
+            pop_size += registry.get<cqspc::PopulationSegment>(population).population;
         }
     }
     ImGui::TextFmt("Population: {} ({})", cqsp::util::LongToHumanString(pop_size), pop_size);
@@ -264,8 +300,8 @@ void SysPlanetInformation::PlanetInformationPanel() {
 
         entt::entity e = habit.settlements[i];
         std::string name = "No name";
-        if (GetUniverse().any_of<cqspc::Name>(e)) {
-            name = GetUniverse().get<cqspc::Name>(e);
+        if (registry.any_of<cqspc::Name>(e)) {
+            name = registry.get<cqspc::Name>(e);
         }
         if (CQSPGui::DefaultSelectable(fmt::format("{}", name).c_str(), is_selected)) {
             // Load city
@@ -273,35 +309,36 @@ void SysPlanetInformation::PlanetInformationPanel() {
             selected_city_entity = habit.settlements[i];
             view_mode = ViewMode::CITY_VIEW;
         }
-        gui::EntityTooltip(GetUniverse(), e);
+        gui::EntityTooltip(*snapshot, e);
     }
     ImGui::EndChild();
 }
 
 void SysPlanetInformation::ResourcesTab() {
     // Consolidate resources
-    auto &city_industry = GetUniverse().get<cqspc::Industry>(selected_city_entity);
+    const entt::registry& registry = snapshot->registry;
+    auto &city_industry = registry.get<cqspc::Industry>(selected_city_entity);
     cqspc::ResourceLedger resources;
     for (auto area : city_industry.industries) {
-        if (GetUniverse().all_of<cqspc::ResourceStockpile>(area)) {
+        if (registry.all_of<cqspc::ResourceStockpile>(area)) {
             // Add resources
-            auto& stockpile = GetUniverse().get<cqspc::ResourceStockpile>(area);
-            resources += stockpile;
+            auto& stockpile = registry.get<cqspc::ResourceStockpile>(area);
+            resources += stockpile.ToLedger();
         }
     }
 
-    DrawLedgerTable("cityresources", GetUniverse(), resources);
+    DrawLedgerTable("cityresources", *snapshot, resources);
 }
 
 void SysPlanetInformation::IndustryTab() {
-    auto& city_industry = GetUniverse().get<cqspc::Industry>(selected_city_entity);
+    auto& city_industry = snapshot->registry.get<cqspc::Industry>(selected_city_entity);
 
     int height = 300;
     ImGui::TextFmt("Factories: {}", city_industry.industries.size());
     if (ImGui::IsItemHovered()) {
         ImGui::BeginTooltip();
         for (auto& at : city_industry.industries) {
-            ImGui::TextFmt("{}", gui::GetEntityType(GetUniverse(), at));
+            ImGui::TextFmt("{}", gui::GetEntityType(*snapshot, at));
         }
         ImGui::EndTooltip();
     }
@@ -338,29 +375,31 @@ void SysPlanetInformation::IndustryTabServicesChild() {
 }
 
 void SysPlanetInformation::IndustryTabManufacturingChild() {
-    auto& city_industry = GetUniverse().get<cqspc::Industry>(selected_city_entity);
+    const entt::registry& registry = snapshot->registry;
+    auto& city_industry = registry.get<cqspc::Industry>(selected_city_entity);
     ImGui::Text("Manufactuing Sector");
     // List all the stuff it produces
 
     cqspc::ResourceLedger input_resources;
     cqspc::ResourceLedger output_resources;
     double GDP_calculation = 0;
+    const uint32_t epoch = cqspc::Wallet::GetEpoch(snapshot->date);
     int count = 0;
     for (auto industry : city_industry.industries) {
-        if (GetUniverse().all_of<cqspc::ResourceConverter, cqspc::Factory>(industry)) {
+        if (registry.all_of<cqspc::ResourceConverter, cqspc::Factory>(industry)) {
             count++;
-            auto& generator = GetUniverse().get<cqspc::ResourceConverter>(industry);
-            auto& recipe = GetUniverse().get<cqspc::Recipe>(generator.recipe);
+            auto& generator = registry.get<cqspc::ResourceConverter>(industry);
+            auto& recipe = registry.get<cqspc::Recipe>(generator.recipe);
 
             double productivity = 1;
-            if (GetUniverse().any_of<cqspc::FactoryProductivity>(industry)) {
-                productivity = GetUniverse().get<cqspc::FactoryProductivity>(industry).current_production;
+            if (registry.any_of<cqspc::FactoryProductivity>(industry)) {
+                productivity = registry.get<cqspc::FactoryProductivity>(industry).current_production;
             }
 
             input_resources.MultiplyAdd(recipe.input, productivity);
             output_resources.MultiplyAdd(recipe.output, productivity);
-            if (GetUniverse().all_of<cqspc::Wallet>(industry)) {
-                GDP_calculation += GetUniverse().get<cqspc::Wallet>(industry).GetGDPChange();
+            if (registry.all_of<cqspc::Wallet>(industry)) {
+                GDP_calculation += registry.get<cqspc::Wallet>(industry).GetGDPChange(epoch);
             }
         }
     }
@@ -374,31 +413,33 @@ void SysPlanetInformation::IndustryTabManufacturingChild() {
 
     ImGui::Text("Output");
     // Output table
-    DrawLedgerTable("industryoutput", GetUniverse(), output_resources);
+    DrawLedgerTable("industryoutput", *snapshot, output_resources);
 
     ImGui::Text("Input");
-    DrawLedgerTable("industryinput", GetUniverse(), input_resources);
+    DrawLedgerTable("industryinput", *snapshot, input_resources);
 }
 
 void SysPlanetInformation::IndustryTabMiningChild() {
-    auto& city_industry = GetUniverse().get<cqspc::Industry>(selected_city_entity);
+    const entt::registry& registry = snapshot->registry;
+    auto& city_industry = registry.get<cqspc::Industry>(selected_city_entity);
     ImGui::Text("Mining Sector");
     // Get what resources they are making
     cqspc::ResourceLedger resources;
     double GDP_calculation = 0;
+    const uint32_t epoch = cqspc::Wallet::GetEpoch(snapshot->date);
     int mine_count = 0;
     for (auto mine : city_industry.industries) {
-        if (GetUniverse().all_of<cqspc::ResourceGenerator, cqspc::Mine>(mine)) {
-            auto& generator = GetUniverse().get<cqspc::ResourceGenerator>(mine);
+        if (registry.all_of<cqspc::ResourceGenerator, cqspc::Mine>(mine)) {
+            auto& generator = registry.get<cqspc::ResourceGenerator>(mine);
             double productivity = 1;
-            if (GetUniverse().any_of<cqspc::FactoryProductivity>(mine)) {
-                productivity = GetUniverse().get<cqspc::FactoryProductivity>(mine).current_production;
+            if (registry.any_of<cqspc::FactoryProductivity>(mine)) {
+                productivity = registry.get<cqspc::FactoryProductivity>(mine).current_production;
             }
 
             resources.MultiplyAdd(generator, productivity);
             mine_count++;
-            if (GetUniverse().all_of<cqspc::Wallet>(mine)) {
-                GDP_calculation += GetUniverse().get<cqspc::Wallet>(mine).GetGDPChange();
+            if (registry.all_of<cqspc::Wallet>(mine)) {
+                GDP_calculation += registry.get<cqspc::Wallet>(mine).GetGDPChange(epoch);
             }
         }
     }
@@ -411,28 +452,30 @@ void SysPlanetInformation::IndustryTabMiningChild() {
     }
 
     // Draw on table
-    DrawLedgerTable("mineproduction", GetUniverse(), resources);
+    DrawLedgerTable("mineproduction", *snapshot, resources);
 }
 
 void SysPlanetInformation::IndustryTabAgricultureChild() {
-    auto& city_industry = GetUniverse().get<cqspc::Industry>(selected_city_entity);
+    const entt::registry& registry = snapshot->registry;
+    auto& city_industry = registry.get<cqspc::Industry>(selected_city_entity);
     ImGui::Text("Agriculture Sector");
     // Get what resources they are making
     cqspc::ResourceLedger resources;
     double GDP_calculation = 0;
+    const uint32_t epoch = cqspc::Wallet::GetEpoch(snapshot->date);
     int mine_count = 0;
     for (auto mine : city_industry.industries) {
-        if (GetUniverse().all_of<cqspc::ResourceGenerator, cqspc::Farm>(mine)) {
-            auto& generator = GetUniverse().get<cqspc::ResourceGenerator>(mine);
+        if (registry.all_of<cqspc::ResourceGenerator, cqspc::Farm>(mine)) {
+            auto& generator = registry.get<cqspc::ResourceGenerator>(mine);
             double productivity = 1;
-            if (GetUniverse().any_of<cqspc::FactoryProductivity>(mine)) {
-                productivity = GetUniverse().get<cqspc::FactoryProductivity>(mine).current_production;
+            if (registry.any_of<cqspc::FactoryProductivity>(mine)) {
+                productivity = registry.get<cqspc::FactoryProductivity>(mine).current_production;
             }
 
             resources.MultiplyAdd(generator, productivity);
             mine_count++;
-            if (GetUniverse().all_of<cqspc::Wallet>(mine)) {
-                GDP_calculation += GetUniverse().get<cqspc::Wallet>(mine).GetGDPChange();
+            if (registry.all_of<cqspc::Wallet>(mine)) {
+                GDP_calculation += registry.get<cqspc::Wallet>(mine).GetGDPChange(epoch);
             }
         }
     }
@@ -445,23 +488,24 @@ void SysPlanetInformation::IndustryTabAgricultureChild() {
     }
 
     // Draw on table
-    DrawLedgerTable("farmproduction", GetUniverse(), resources);
+    DrawLedgerTable("farmproduction", *snapshot, resources);
 }
 
 void SysPlanetInformation::DemographicsTab() {
     using cqsp::common::components::Settlement;
     using cqsp::common::components::PopulationSegment;
 
-    auto& settlement = GetUniverse().get<Settlement>(selected_city_entity);
+    const entt::registry& registry = snapshot->registry;
+    auto& settlement = registry.get<Settlement>(selected_city_entity);
     for (auto &seg_entity : settlement.population) {
         ImGui::TextFmt("Population: {}",
-            cqsp::util::LongToHumanString(GetUniverse().get<PopulationSegment>(seg_entity).population));
-        gui::EntityTooltip(GetUniverse(), seg_entity);
-        if (GetUniverse().all_of<cqspc::Hunger>(seg_entity)) {
+            cqsp::util::LongToHumanString(registry.get<PopulationSegment>(seg_entity).population));
+        gui::EntityTooltip(*snapshot, seg_entity);
+        if (registry.all_of<cqspc::Hunger>(seg_entity)) {
             ImGui::TextFmt("Hungry");
         }
-        if (GetUniverse().any_of<cqsp::common::components::Employee>(seg_entity)) {
-            auto& employee = GetUniverse().get<cqspc::Employee>(seg_entity);
+        if (registry.any_of<cqsp::common::components::Employee>(seg_entity)) {
+            auto& employee = registry.get<cqspc::Employee>(seg_entity);
             ImGui::TextFmt("Working Population: {}/{}", cqsp::util::LongToHumanString(employee.employed_population),
                                                         cqsp::util::LongToHumanString(employee.working_population));
             if (employee.working_population > 0) {
@@ -470,9 +514,10 @@ void SysPlanetInformation::DemographicsTab() {
             }
         }
         // Get spending for population
-        if (GetUniverse().all_of<cqspc::Wallet>(seg_entity)) {
-            auto& wallet = GetUniverse().get<cqspc::Wallet>(seg_entity);
-            ImGui::TextFmt("Spending: {}", cqsp::util::LongToHumanString(wallet.GetGDPChange()));
+        if (registry.all_of<cqspc::Wallet>(seg_entity)) {
+            auto& wallet = registry.get<cqspc::Wallet>(seg_entity);
+            const uint32_t epoch = cqspc::Wallet::GetEpoch(snapshot->date);
+            ImGui::TextFmt("Spending: {}", cqsp::util::LongToHumanString(wallet.GetGDPChange(epoch)));
         }
     }
     // Then do demand and other things.
@@ -494,10 +539,12 @@ void SysPlanetInformation::ConstructionTab() {
         if (ImGui::BeginTabItem("Power Plant")) {
             ImGui::EndTabItem();
         }
-        if (!GetUniverse().any_of<cqspc::infrastructure::SpacePort>(selected_city_entity)) {
+        if (!snapshot->registry.any_of<cqspc::infrastructure::SpacePort>(selected_city_entity)) {
             if (ImGui::BeginTabItem("Space Port##Construction")) {
                 if (ImGui::Button("Construct Spaceport")) {
-                    GetUniverse().emplace<cqspc::infrastructure::SpacePort>(selected_city_entity);
+                    queued_actions.push_back([city = selected_city_entity](common::Universe& universe) {
+                        universe.emplace_or_replace<cqspc::infrastructure::SpacePort>(city);
+                    });
                 }
                 ImGui::EndTabItem();
             }
@@ -508,14 +555,14 @@ void SysPlanetInformation::ConstructionTab() {
 }
 
 void SysPlanetInformation::FactoryConstruction() {
-    auto recipes = GetUniverse().view<cqspc::Recipe>();
+    const entt::registry& registry = snapshot->registry;
     static int selected_recipe_index = -1;
     static entt::entity selected_recipe = entt::null;
     int index = 0;
 
-    entt::entity player = GetUniverse().view<common::components::Player>().front();
+    entt::entity player = registry.view<const common::components::Player>().front();
     auto& tech_progress =
-        GetUniverse().get<common::components::science::TechnologicalProgress>(player);
+        registry.get<common::components::science::TechnologicalProgress>(player);
 
     // Check for tech and stuff, I guess
     ImGui::BeginChild("constructionlist", ImVec2(0, 150), true, window_flags);
@@ -526,7 +573,7 @@ void SysPlanetInformation::FactoryConstruction() {
             selected_recipe = entity;
         }
         const bool selected = selected_recipe_index == index;
-        std::string name = gui::GetName(GetUniverse(), entity);
+        std::string name = gui::GetName(*snapshot, entity);
 
         if (CQSPGui::DefaultSelectable(fmt::format("{}", name).c_str(), selected)) {
             selected_recipe_index = index;
@@ -544,28 +591,28 @@ void SysPlanetInformation::FactoryConstruction() {
     ImGui::PopItemWidth();
     if (tech_progress.researched_recipes.size() > 0) {
         auto cost =
-                common::systems::actions::GetFactoryCost(GetUniverse(), selected_city_entity, selected_recipe, prod);
+                common::systems::actions::GetFactoryCost(registry, selected_city_entity, selected_recipe, prod);
 
         RecipeConstructionCostPanel(selected_recipe, prod, cost);
         RecipeConstructionConstructButton(selected_recipe, prod, cost);
 
         if (ImGui::IsItemHovered()) {
             ImGui::BeginTooltip();
-            DrawLedgerTable("building_cost_tooltip", GetUniverse(), cost);
+            DrawLedgerTable("building_cost_tooltip", *snapshot, cost);
             ImGui::EndTooltip();
         }
     }
 }
 
 void SysPlanetInformation::MineConstruction() {
+    const entt::registry& registry = snapshot->registry;
     ImGui::BeginChild("mineconstructionlist", ImVec2(0, 150), true, window_flags);
-    auto recipes = GetUniverse().view<cqspc::Good, cqspc::Mineral>();
     static int selected_good_index = -1;
     static entt::entity selected_good = entt::null;
     int index = 0;
-    entt::entity player = GetUniverse().view<common::components::Player>().front();
+    entt::entity player = registry.view<const common::components::Player>().front();
     auto& tech_progress =
-        GetUniverse().get<common::components::science::TechnologicalProgress>(player);
+        registry.get<common::components::science::TechnologicalProgress>(player);
 
     for (entt::entity entity : tech_progress.researched_mining) {
         if (selected_good_index == -1) {
@@ -573,7 +620,7 @@ void SysPlanetInformation::MineConstruction() {
             selected_good = entity;
         }
         const bool selected = selected_good_index == index;
-        std::string name = gui::GetName(GetUniverse(), entity);
+        std::string name = gui::GetName(*snapshot, entity);
         if (CQSPGui::DefaultSelectable(fmt::format("{}", name).c_str(), selected)) {
             selected_good_index = index;
             selected_good = entity;
@@ -595,23 +642,25 @@ void SysPlanetInformation::MineConstruction() {
             // Add demand to the market for the amount of resources
             // When construction takes time in the future, then do the costs.
             // So first charge it to the market
-            entt::entity city_market = GetUniverse().get<cqspc::MarketCenter>(selected_planet).market;
+            entt::entity city_market = registry.get<cqspc::MarketCenter>(selected_planet).market;
             /*auto cost = cqsp::common::systems::actions::GetFactoryCost(
                 GetUniverse(), selected_city_entity, selected_good, prod);
             GetUniverse().get<cqspc::Market>(city_market).demand += cost;
             GetUniverse().get<cqspc::ResourceStockpile>(city_market) -= cost;
             */
             // Buy things on the market
-            entt::entity factory = cqsp::common::systems::actions::CreateMine(
-                GetUniverse(), selected_city_entity, selected_good, 1, prod);
-            cqsp::common::systems::economy::AddParticipant(GetUniverse(), city_market, factory);
+            queued_actions.push_back([city = selected_city_entity, city_market, good = selected_good,
+                                      prod = prod](common::Universe& universe) {
+                entt::entity factory = cqsp::common::systems::actions::CreateMine(universe, city, good, 1, prod);
+                cqsp::common::systems::economy::AddParticipant(universe, city_market, factory);
+            });
         }
 
         if (ImGui::IsItemHovered()) {
             ImGui::BeginTooltip();
-            DrawLedgerTable("building_cost_tooltip", GetUniverse(),
+            DrawLedgerTable("building_cost_tooltip", *snapshot,
                         cqsp::common::systems::actions::GetMineCost(
-                                GetUniverse(), selected_city_entity, selected_good, prod));
+                                registry, selected_city_entity, selected_good, prod));
             ImGui::EndTooltip();
         }
     }
@@ -619,14 +668,15 @@ void SysPlanetInformation::MineConstruction() {
 
 void SysPlanetInformation::MineInformationPanel() {
     if (mine_list_panel) {
-        auto &city_industry = GetUniverse().get<cqspc::Industry>(selected_city_entity);
+        const entt::registry& registry = snapshot->registry;
+        auto &city_industry = registry.get<cqspc::Industry>(selected_city_entity);
         ImGui::Begin(fmt::format("Mines of {}", selected_city_entity).c_str(), &mine_list_panel);
         // List mines
         static int selected_mine = 0;
         int mine_index = 0;
         for (int i = 0; i < city_industry.industries.size(); i++) {
             entt::entity e = city_industry.industries[i];
-            if (GetUniverse().all_of<cqspc::Mine>(e)) {
+            if (registry.all_of<cqspc::Mine>(e)) {
                 // Then do the things
                 mine_index++;
             } else {
@@ -635,14 +685,14 @@ void SysPlanetInformation::MineInformationPanel() {
 
             const bool is_selected = (selected_mine == mine_index);
             std::string name = fmt::format("{}", e);
-            if (GetUniverse().all_of<cqspc::Name>(e)) {
-                name = GetUniverse().get<cqspc::Name>(e);
+            if (registry.all_of<cqspc::Name>(e)) {
+                name = registry.get<cqspc::Name>(e);
             }
             if (CQSPGui::DefaultSelectable(fmt::format("{}", name).c_str(), is_selected)) {
                 // Load
                 selected_mine = mine_index;
             }
-            gui::EntityTooltip(GetUniverse(), e);
+            gui::EntityTooltip(*snapshot, e);
         }
         ImGui::End();
     }
@@ -650,14 +700,15 @@ void SysPlanetInformation::MineInformationPanel() {
 
 void SysPlanetInformation::FactoryInformationPanel() {
     if (factory_list_panel) {
-        auto &city_industry = GetUniverse().get<cqspc::Industry>(selected_city_entity);
+        const entt::registry& registry = snapshot->registry;
+        auto &city_industry = registry.get<cqspc::Industry>(selected_city_entity);
         ImGui::Begin(fmt::format("Factories of {}", selected_city_entity).c_str(), &factory_list_panel);
         // List mines
         static int selected_factory = 0;
         int factory_index = 0;
         for (int i = 0; i < city_industry.industries.size(); i++) {
             entt::entity e = city_industry.industries[i];
-            if (GetUniverse().all_of<cqspc::Factory>(e)) {
+            if (registry.all_of<cqspc::Factory>(e)) {
                 // Then do the things
                 factory_index++;
             } else {
@@ -666,14 +717,14 @@ void SysPlanetInformation::FactoryInformationPanel() {
 
             const bool is_selected = (selected_factory == factory_index);
             std::string name = fmt::format("{}", e);
-            if (GetUniverse().all_of<cqspc::Name>(e)) {
-                name = GetUniverse().get<cqspc::Name>(e);
+            if (registry.all_of<cqspc::Name>(e)) {
+                name = registry.get<cqspc::Name>(e);
             }
             if (CQSPGui::DefaultSelectable(fmt::format("{}", name).c_str(), is_selected)) {
                 // Load
                 selected_factory = factory_index;
             }
-            gui::EntityTooltip(GetUniverse(), e);
+            gui::EntityTooltip(*snapshot, e);
         }
         ImGui::End();
     }
@@ -684,21 +735,26 @@ void SysPlanetInformation::SpacePortTab() {
     namespace cqsps = cqsp::common::components::ships;
     namespace cqspb = cqsp::common::components::bodies;
 
-if (ImGui::Button("Launch!")) {
-        entt::entity star_system = GetUniverse().get<cqspc::bodies::Body>(selected_planet).star_system;
-        cqsp::common::systems::actions::CreateShip(
-        GetUniverse(), entt::null, selected_planet, star_system);
+    if (ImGui::Button("Launch!")) {
+        queued_actions.push_back([planet = selected_planet](common::Universe& universe) {
+            entt::entity star_system = universe.get<cqspc::bodies::Body>(planet).star_system;
+            cqsp::common::systems::actions::CreateShip(universe, entt::null, planet, star_system);
+        });
     }
 }
 
 void SysPlanetInformation::InfrastructureTab() {
+    const entt::registry& registry = snapshot->registry;
     if (power_plant_output_panel) {
         ImGui::Begin("Power Plant", &power_plant_output_panel);
-        double& prod_d = GetUniverse().get<cqspc::infrastructure::PowerPlant>(power_plant_changing).production;
+        double prod_d = registry.get<cqspc::infrastructure::PowerPlant>(power_plant_changing).production;
         float prod = static_cast<float>(prod_d);
         ImGui::PushItemWidth(-1);
-        CQSPGui::DragFloat("power_plant_supply", &prod, 1, 1, INT_MAX);
-        prod_d = prod;
+        if (CQSPGui::DragFloat("power_plant_supply", &prod, 1, 1, INT_MAX)) {
+            queued_actions.push_back([plant = power_plant_changing, prod](common::Universe& universe) {
+                universe.get<cqspc::infrastructure::PowerPlant>(plant).production = prod;
+            });
+        }
         ImGui::PopItemWidth();
         ImGui::End();
     }
@@ -706,23 +762,23 @@ void SysPlanetInformation::InfrastructureTab() {
     // Get the areas that generate power
     ImGui::Separator();
     ImGui::Text("Power");
-    auto &city_industry = GetUniverse().get<cqspc::Industry>(selected_city_entity);
+    auto &city_industry = registry.get<cqspc::Industry>(selected_city_entity);
     double power_production = 0;
     double power_demand = 0;
-    if (GetUniverse().any_of<cqspc::infrastructure::CityPower>(selected_city_entity)) {
-        auto& power = GetUniverse().get<cqspc::infrastructure::CityPower>(selected_city_entity);
+    if (registry.any_of<cqspc::infrastructure::CityPower>(selected_city_entity)) {
+        auto& power = registry.get<cqspc::infrastructure::CityPower>(selected_city_entity);
         power_production = power.total_power_prod;
         power_demand = power.total_power_consumption;
     }
     std::vector<entt::entity> power_plants;
     for (int i = 0; i < city_industry.industries.size(); i++) {
         entt::entity industry = city_industry.industries[i];
-        if (GetUniverse().any_of<cqspc::infrastructure::PowerPlant>(industry)) {
+        if (registry.any_of<cqspc::infrastructure::PowerPlant>(industry)) {
             power_plants.push_back(industry);
         }
     }
     ImGui::TextFmt("Power Production: {}/{} MW", power_demand, power_production);
-    if (GetUniverse().any_of<cqspc::infrastructure::BrownOut>(selected_city_entity)) {
+    if (registry.any_of<cqspc::infrastructure::BrownOut>(selected_city_entity)) {
         ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(255, 0, 0, 1));
         // Get seriousness, then do random other things
         ImGui::TextFmt("Brown Out!");
@@ -730,7 +786,7 @@ void SysPlanetInformation::InfrastructureTab() {
     }
 
     for (entt::entity plant : power_plants) {
-        double prod = GetUniverse().get<cqspc::infrastructure::PowerPlant>(plant).production;
+        double prod = registry.get<cqspc::infrastructure::PowerPlant>(plant).production;
         ImGui::TextFmt("Power Plant: {} MW", prod);
         ImGui::SameLine();
         if (ImGui::Button("Change Power plant output")) {
@@ -741,36 +797,38 @@ void SysPlanetInformation::InfrastructureTab() {
 }
 
 void SysPlanetInformation::ScienceTab() {
-    if (!GetUniverse().valid(selected_planet)) {
+    const entt::registry& registry = snapshot->registry;
+    if (!registry.valid(selected_planet)) {
         return;
     }
-    auto &city_industry = GetUniverse().get<cqspc::Industry>(selected_city_entity);
+    auto &city_industry = registry.get<cqspc::Industry>(selected_city_entity);
     ImGui::Text("Science");
     // Get the science labs
     cqspc::ResourceLedger led;
     for (int i = 0; i < city_industry.industries.size(); i++) {
         entt::entity industry = city_industry.industries[i];
-        if (GetUniverse().any_of<cqspc::science::Lab>(industry)) {
+        if (registry.any_of<cqspc::science::Lab>(industry)) {
             ImGui::Text("Lab %d", i);
-            auto& lab = GetUniverse().get<cqspc::science::Lab>(industry);
+            auto& lab = registry.get<cqspc::science::Lab>(industry);
             led += lab.science_contribution;
         }
     }
     // Get all the combined science
     ImGui::Text("Science Contribution");
-    systems::DrawLedgerTable("science_contrib_table", GetUniverse(), led);
+    systems::DrawLedgerTable("science_contrib_table", *snapshot, led);
 }
 
 void SysPlanetInformation::MarketInformationTooltipContent() {
-    if (!GetUniverse().valid(selected_planet)) {
+    const entt::registry& registry = snapshot->registry;
+    if (!registry.valid(selected_planet)) {
         return;
     }
-    if (!GetUniverse().any_of<cqspc::MarketCenter>(selected_planet)) {
+    if (!registry.any_of<cqspc::MarketCenter>(selected_planet)) {
         ImGui::TextFmt("Market is not a market center");
         return;
     }
-    auto& center = GetUniverse().get<cqspc::MarketCenter>(selected_planet);
-    auto& market = GetUniverse().get<cqspc::Market>(center.market);
+    auto& center = registry.get<cqspc::MarketCenter>(selected_planet);
+    auto& market = registry.get<cqspc::Market>(center.market);
     ImGui::TextFmt("Has {} entities attached to it", market.participants.size());
 
     // Get resource stockpile
@@ -781,14 +839,14 @@ void SysPlanetInformation::MarketInformationTooltipContent() {
         ImGui::TableSetupColumn("Demand");
         ImGui::TableSetupColumn("S/D ratio");
         ImGui::TableHeadersRow();
-        for (const auto& good_information : market) {
+        for (entt::entity good : market.GetGoods()) {
             ImGui::TableNextRow();
             ImGui::TableSetColumnIndex(0);
-            ImGui::TextFmt("{}", GetUniverse().get<cqspc::Identifier>(good_information.first).identifier);
+            ImGui::TextFmt("{}", registry.get<cqspc::Identifier>(good).identifier);
             ImGui::TableSetColumnIndex(1);
-            ImGui::TextFmt("{}", good_information.second.price);
+            ImGui::TextFmt("{}", market.GetPrice(good));
             ImGui::TableSetColumnIndex(2);
-            auto& hist = market.last_market_information[good_information.first];
+            cqspc::MarketElementInformation hist = market.GetLast(good);
             ImGui::TextFmt("{}", cqsp::util::LongToHumanString(hist.supply));
             ImGui::TableSetColumnIndex(3);
             ImGui::TextFmt("{}", cqsp::util::LongToHumanString(hist.demand));
@@ -804,10 +862,13 @@ void SysPlanetInformation::MarketInformationTooltipContent() {
     }
 
     // Draw market information charts
-    if (GetUniverse().all_of<cqspc::MarketHistory>(center.market)) {
-        auto& history = GetUniverse().get<cqspc::MarketHistory>(center.market);
+    if (market_history_market == center.market) {
+        auto& history = market_history;
         if (ImGui::Button("Clear information")) {
-            GetUniverse().replace<cqspc::MarketHistory>(center.market);
+            queued_actions.push_back([market = center.market](common::Universe& universe) {
+                universe.replace<cqspc::MarketHistory>(market);
+            });
+            market_history = cqspc::MarketHistory();
         }
         if (ImPlot::BeginPlot("Price History", "Time", "Price", ImVec2(-1, 0),
                               ImPlotFlags_NoMousePos | ImPlotFlags_NoChild,
@@ -815,7 +876,7 @@ void SysPlanetInformation::MarketInformationTooltipContent() {
                               ImPlotAxisFlags_AutoFit)) {
             for (auto& hist : history.price_history) {
                 ImPlot::PlotLine(
-                    systems::gui::GetName(GetUniverse(), hist.first).c_str(), hist.second.data(),
+                    systems::gui::GetName(*snapshot, hist.first).c_str(), hist.second.data(),
                     hist.second.size());
             }
             ImPlot::EndPlot();
@@ -826,7 +887,7 @@ void SysPlanetInformation::MarketInformationTooltipContent() {
                               ImPlotAxisFlags_AutoFit)) {
             for (auto& hist : history.volume) {
                 ImPlot::PlotLine(
-                    (systems::gui::GetName(GetUniverse(), hist.first) +
+                    (systems::gui::GetName(*snapshot, hist.first) +
                         " Volume").c_str(),
                     hist.second.data(), hist.second.size());
             }
@@ -859,13 +920,14 @@ void SysPlanetInformation::ConstructionConfirmationPanel() {
 
 void SysPlanetInformation::RecipeConstructionCostPanel(entt::entity selected_recipe, double prod,
                                                        const common::components::ResourceLedger& cost) {
-    entt::entity city_market = GetUniverse().get<cqspc::MarketCenter>(selected_planet).market;
+    const entt::registry& registry = snapshot->registry;
+    entt::entity city_market = registry.get<cqspc::MarketCenter>(selected_planet).market;
     // Cost table
-    ImGui::TextFmt("Estimated Cost: {}", common::systems::economy::GetCost(GetUniverse(), city_market, cost));
+    ImGui::TextFmt("Estimated Cost: {}", common::systems::economy::GetCost(registry, city_market, cost));
     CQSPGui::SimpleTextTooltip("Estimated cost at current market prices");
 
     ImGui::Text("Resources Needed");
-    DrawLedgerTable("factory_cost", GetUniverse(), cost);
+    DrawLedgerTable("factory_cost", *snapshot, cost);
 }
 
 void
@@ -879,15 +941,18 @@ SysPlanetInformation::RecipeConstructionConstructButton(entt::entity selected_re
     // Construct things
     SPDLOG_INFO("Constructing factory with recipe {}", selected_recipe);
     // Create construction site and do the cost
-    entt::entity player = GetUniverse().view<cqspc::Player>().front();
-
-    entt::entity city_market = GetUniverse().get<cqspc::MarketCenter>(selected_planet).market;
-    entt::entity factory = common::systems::actions::OrderConstructionFactory(
-            GetUniverse(), selected_city_entity, city_market, selected_recipe, prod,
-            player);
-    if (factory == entt::null) {
-        return;
-    }
-    enable_construction_confirmation_panel = true;
+    const entt::registry& registry = snapshot->registry;
+    entt::entity player = registry.view<const cqspc::Player>().front();
+
+    entt::entity city_market = registry.get<cqspc::MarketCenter>(selected_planet).market;
+    queued_actions.push_back([this, city = selected_city_entity, city_market, selected_recipe, prod,
+                              player](common::Universe& universe) {
+        entt::entity factory = common::systems::actions::OrderConstructionFactory(
+                universe, city, city_market, selected_recipe, prod, player);
+        if (factory == entt::null) {
+            return;
+        }
+        enable_construction_confirmation_panel = true;
+    });
 }
 }  // namespace cqsp::client::systems
@@ -16,12 +16,17 @@
 */
 #pragma once
 
+#include <functional>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <entt/entt.hpp>
 
 #include "client/systems/sysgui.h"
 #include "engine/application.h"
+#include "common/universesnapshot.h"
+#include "common/components/history.h"
 #include "common/components/resource.h"
 
 namespace cqsp {
@@ -37,6 +42,8 @@ class SysPlanetInformation : public SysUserInterface {
     void Init();
     void DoUI(int delta_time);
     void DoUpdate(int delta_time);
+    bool ReadsSnapshotOnly() override { return true; }
+    bool DoUniverseUpdate(int delta_time) override;
 
     int selected_city_index = 0;
     enum class ViewMode { PLANET_VIEW, CITY_VIEW };
@@ -80,6 +87,17 @@ class SysPlanetInformation : public SysUserInterface {
 
     bool renaming_city = false;
     std::string city_founding_name;
+
+    // The panels are drawn from the snapshot, so that they are still shown while the simulation is ticking
+    std::shared_ptr<const common::UniverseSnapshot> snapshot;
+    // Changes to the universe, like renaming a city or building a factory, which are made the next time the
+    // universe is locked
+    std::vector<std::function<void(common::Universe&)>> queued_actions;
+    // Market histories grow every tick, so they aren't in the snapshot. The history of the market that is shown
+    // is copied from the universe once a tick instead.
+    common::components::MarketHistory market_history;
+    entt::entity market_history_market = entt::null;
+    int market_history_date = -1;
 };
 }  // namespace systems
 }  // namespace client
@@ -32,8 +32,9 @@ void SysStarSystemTree::Init() {
     // Sort all the planets in order
     namespace cqspb = cqsp::common::components::bodies;
     namespace cqspt = cqsp::common::components::types;
-    auto& orbital_system = GetUniverse().get<cqspb::OrbitalSystem>(GetUniverse().sun);
-    planets.emplace(GetUniverse().sun);
+    sun = GetUniverse().sun;
+    auto& orbital_system = GetUniverse().get<cqspb::OrbitalSystem>(sun);
+    planets.emplace(sun);
     planets.insert(orbital_system.children.begin(),
                    orbital_system.children.end());
     planets.sort([&](const entt::entity lhs, const entt::entity rhs) {
@@ -47,7 +48,9 @@ void SysStarSystemTree::DoUI(int delta_time) {
     namespace cqspcs = cqsp::client::systems;
     namespace cqspc = cqsp::common::components;
     // Get star system
-    selected_planet = cqsp::scene::GetCurrentViewingPlanet(GetUniverse());
+    selected_planet = cqsp::scene::GetCurrentViewingPlanet();
+    auto snapshot = cqsp::scene::GetUniverseSnapshot();
+    auto orbital_systems = snapshot->registry.view<const cqspb::OrbitalSystem>();
     ImGui::SetNextWindowPos(ImVec2(30, ImGui::GetIO().DisplaySize.y - 30),
                             ImGuiCond_Always, ImVec2(0.f, 1.f));
     ImGui::SetNextWindowSize(ImVec2(200, 400), ImGuiCond_Always);
@@ -55,28 +58,28 @@ void SysStarSystemTree::DoUI(int delta_time) {
     int index = 0;
     // Get selected planet
     // Sort by sma
-    entt::entity current_planet = cqsp::scene::GetCurrentViewingPlanet(GetUniverse());
+    entt::entity current_planet = cqsp::scene::GetCurrentViewingPlanet();
     for (auto entity : planets) {
-        if (!GetUniverse().any_of<cqspb::OrbitalSystem>(entity) || entity == GetUniverse().sun) {
+        if (!orbital_systems.contains(entity) || entity == sun) {
             SeePlanetSelectable(entity);
         } else {
-            std::string planet_name = gui::GetName(GetUniverse(), entity);
+            std::string planet_name = gui::GetName(*snapshot, entity);
             if (ImGui::TreeNodeEx(planet_name.c_str(), ImGuiTreeNodeFlags_OpenOnArrow)) {
                 // If it's double clicked
                 if (ImGui::IsItemHovered() && ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left)) {
                     // Go to the planet
-                    cqsp::scene::SeePlanet(GetApp(), entity);
+                    cqsp::scene::SeePlanet(entity);
                 }
                 // Get children
-                gui::EntityTooltip(GetUniverse(), entity);
+                gui::EntityTooltip(*snapshot, entity);
                 DoChildTree(entity);
                 ImGui::TreePop();
             } else {
                 if (ImGui::IsItemHovered() &&
                     ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left)) {
-                    cqsp::scene::SeePlanet(GetApp(), entity);
+                    cqsp::scene::SeePlanet(entity);
                 }
-                gui::EntityTooltip(GetUniverse(), entity);
+                gui::EntityTooltip(*snapshot, entity);
             }
         }
     }
@@ -86,7 +89,8 @@ void SysStarSystemTree::DoUI(int delta_time) {
 void SysStarSystemTree::DoUpdate(int delta_time) {}
 
 void SysStarSystemTree::SeePlanetSelectable(entt::entity entity) {
-    std::string planet_name = gui::GetName(GetUniverse(), entity);
+    auto snapshot = cqsp::scene::GetUniverseSnapshot();
+    std::string planet_name = gui::GetName(*snapshot, entity);
     bool is_selected = (entity == selected_planet);
     ImGui::Dummy(ImVec2(20, 16));
     ImGui::SameLine();
@@ -95,24 +99,25 @@ void SysStarSystemTree::SeePlanetSelectable(entt::entity entity) {
         // Selected object
         if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left)) {
             // Go to the planet
-            cqsp::scene::SeePlanet(GetApp(), entity);
+            cqsp::scene::SeePlanet(entity);
         }
     }
-     gui::EntityTooltip(GetUniverse(), entity);
+     gui::EntityTooltip(*snapshot, entity);
 }
 
 void SysStarSystemTree::DoChildTree(entt::entity entity) {
     namespace cqspb = cqsp::common::components::bodies;
-    for (auto child : GetUniverse().get<cqspb::OrbitalSystem>(entity).children) {
-        std::string child_name = gui::GetName(GetUniverse(), child);
+    auto snapshot = cqsp::scene::GetUniverseSnapshot();
+    for (auto child : snapshot->registry.get<cqspb::OrbitalSystem>(entity).children) {
+        std::string child_name = gui::GetName(*snapshot, child);
         bool is_selected = (child == selected_planet);
         if (CQSPGui::DefaultSelectable(child_name.c_str(), is_selected, ImGuiSelectableFlags_AllowDoubleClick)) {
             if (ImGui::IsMouseDoubleClicked(ImGuiMouseButton_Left)) {
                 // Go to the planet
-                cqsp::scene::SeePlanet(GetApp(), child);
+                cqsp::scene::SeePlanet(child);
             }
         }
-        gui::EntityTooltip(GetUniverse(), child);
+        gui::EntityTooltip(*snapshot, child);
     }
 }
 }  // namespace cqsp::client::systems
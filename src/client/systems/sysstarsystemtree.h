@@ -29,12 +29,14 @@ class SysStarSystemTree : public SysUserInterface {
     void Init();
     void DoUI(int delta_time);
     void DoUpdate(int delta_time);
+    bool ReadsSnapshotOnly() override { return true; }
 
     void SeePlanetSelectable(entt::entity entity);
     void DoChildTree(entt::entity entity);
  private:
     int selected_index = 0;
     entt::entity selected_planet;
+    entt::entity sun = entt::null;
     entt::sparse_set planets;
 };
 }  // namespace systems
@@ -22,6 +22,7 @@
 #include "common/components/science.h"
 
 #include "client/systems/gui/systooltips.h"
+#include "client/scenes/universescene.h"
 
 namespace cqsp::client::systems {
 void SysTechnologyViewer::Init() {
@@ -29,14 +30,16 @@ void SysTechnologyViewer::Init() {
 
 void SysTechnologyViewer::DoUI(int delta_time) {
     using common::components::science::TechnologicalProgress;
+    auto snapshot = cqsp::scene::GetUniverseSnapshot();
+    const entt::registry& registry = snapshot->registry;
     // Display UI
-    auto view = GetUniverse().view<common::components::Player>();
+    auto view = registry.view<const common::components::Player>();
     entt::entity player = view.front();
     ImGui::Begin("Technology Information");
-    if (GetUniverse().any_of<TechnologicalProgress>(player)) {
-        auto& progress = GetUniverse().get<TechnologicalProgress>(player);
+    if (player != entt::null && registry.any_of<TechnologicalProgress>(player)) {
+        auto& progress = registry.get<TechnologicalProgress>(player);
         for (entt::entity researched : progress.researched_techs) {
-            ImGui::TextFmt("{}", gui::GetName(GetUniverse(), researched));
+            ImGui::TextFmt("{}", gui::GetName(*snapshot, researched));
         }
     } else {
         ImGui::Text("Nope, no technology");
@@ -52,14 +55,16 @@ void SysTechnologyProjectViewer::Init() {
 
 void SysTechnologyProjectViewer::DoUI(int delta_time) {
     using common::components::science::ScientificResearch;
+    auto snapshot = cqsp::scene::GetUniverseSnapshot();
+    const entt::registry& registry = snapshot->registry;
     // Display UI
-    auto view = GetUniverse().view<common::components::Player>();
+    auto view = registry.view<const common::components::Player>();
     entt::entity player = view.front();
     ImGui::Begin("Technology Research");
-    if (GetUniverse().any_of<ScientificResearch>(player)) {
-        auto& progress = GetUniverse().get<ScientificResearch>(player);
+    if (player != entt::null && registry.any_of<ScientificResearch>(player)) {
+        auto& progress = registry.get<ScientificResearch>(player);
         for (auto& researched : progress.current_research) {
-            ImGui::TextFmt("{} {}", gui::GetName(GetUniverse(), researched.first), researched.second);
+            ImGui::TextFmt("{} {}", gui::GetName(*snapshot, researched.first), researched.second);
         }
 
         ImGui::Separator();
@@ -67,16 +72,21 @@ void SysTechnologyProjectViewer::DoUI(int delta_time) {
 
         std::vector<entt::entity> potential_research;
         for (const entt::entity& researched : progress.potential_research) {
-            ImGui::TextFmt("{}", gui::GetName(GetUniverse(), researched));
+            ImGui::TextFmt("{}", gui::GetName(*snapshot, researched));
             ImGui::SameLine();
             if (ImGui::Button(fmt::format("Queue Research##{}", researched).c_str())) {
                 // Add to tech queue
                 potential_research.push_back(researched);
             }
         }
-        for (entt::entity res : potential_research) {
-            progress.potential_research.erase(res);
-            progress.current_research[res] = 0;
+        if (!potential_research.empty()) {
+            queued_actions.push_back([player, potential_research](common::Universe& universe) {
+                auto& progress = universe.get<ScientificResearch>(player);
+                for (entt::entity res : potential_research) {
+                    progress.potential_research.erase(res);
+                    progress.current_research[res] = 0;
+                }
+            });
         }
     } else {
         ImGui::Text("No Tech Research");
@@ -86,4 +96,13 @@ void SysTechnologyProjectViewer::DoUI(int delta_time) {
 
 void SysTechnologyProjectViewer::DoUpdate(int delta_time) {
 }
+
+bool SysTechnologyProjectViewer::DoUniverseUpdate(int delta_time) {
+    bool changed = !queued_actions.empty();
+    for (auto& action : queued_actions) {
+        action(GetUniverse());
+    }
+    queued_actions.clear();
+    return changed;
+}
 }  // namespace cqsp::client::systems
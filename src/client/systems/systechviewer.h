@@ -16,6 +16,9 @@
  */
 #pragma once
 
+#include <functional>
+#include <vector>
+
 #include "client/systems/sysgui.h"
 
 namespace cqsp::client::systems {
@@ -27,6 +30,7 @@ class SysTechnologyViewer : public SysUserInterface {
     void Init() override;
     void DoUI(int delta_time) override;
     void DoUpdate(int delta_time) override;
+    bool ReadsSnapshotOnly() override { return true; }
 };
 
 class SysTechnologyProjectViewer : public SysUserInterface {
@@ -37,5 +41,11 @@ class SysTechnologyProjectViewer : public SysUserInterface {
     void Init() override;
     void DoUI(int delta_time) override;
     void DoUpdate(int delta_time) override;
+    bool ReadsSnapshotOnly() override { return true; }
+    bool DoUniverseUpdate(int delta_time) override;
+
+ private:
+    // Research that was queued, which is started the next time the universe is locked
+    std::vector<std::function<void(common::Universe&)>> queued_actions;
 };
 }  // namespace cqsp::client::systems
@@ -18,6 +18,7 @@
 
 #include <glad/glad.h>
 
+#include "client/scenes/universescene.h"
 #include "engine/gui.h"
 #include "engine/cqspgui.h"
 
@@ -28,14 +29,20 @@ void SysTurnSaveWindow::DoUI(int delta_time) {
     // Turn window
     ImGui::SetNextWindowPos(ImVec2(ImGui::GetIO().DisplaySize.x, 30),
                             ImGuiCond_Always, ImVec2(1.f, 0.f));
-    ImGui::SetNextWindowSize(ImVec2(170, 80), ImGuiCond_Always);
+    ImGui::SetNextWindowSize(ImVec2(200, 150), ImGuiCond_Always);
     bool to_show = true;
     ImGui::Begin("TS window", &to_show, ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize |
                                      ImGuiWindowFlags_AlwaysAutoResize | window_flags);
     // Show date
-    ImGui::TextFmt("Date: {} {}:00", GetUniverse().date.ToString(),
-                   GetUniverse().date.GetDate() % 24);
-    ImGui::TextFmt("Speed: {}", tick_speed);
+    auto snapshot = cqsp::scene::GetUniverseSnapshot();
+    const auto& date = snapshot->date;
+    ImGui::TextFmt("Date: {} {}:00", date.ToString(), date.GetDate() % 24);
+    if (cqsp::scene::IsFastForward()) {
+        ImGui::TextFmt("Speed: Fast forward");
+    } else {
+        ImGui::TextFmt("Speed: {}", tick_speed);
+    }
+    ImGui::TextFmt("Ticks/s: {:.1f}", ticks_per_second);
     // Get time
     if (CQSPGui::DefaultButton("<<")) {
         // Slower
@@ -54,6 +61,26 @@ void SysTurnSaveWindow::DoUI(int delta_time) {
             tick_speed++;
         }
     }
+    ImGui::SameLine();
+    if (CQSPGui::DefaultButton(">>>")) {
+        cqsp::scene::SetFastForward(!cqsp::scene::IsFastForward());
+    }
+
+    // Skip ahead some days
+    if (cqsp::scene::IsSkipping()) {
+        ImGui::TextFmt("Skipping...");
+        ImGui::SameLine();
+        if (CQSPGui::DefaultButton("Stop")) {
+            cqsp::scene::StopSkipping();
+        }
+    } else {
+        ImGui::SetNextItemWidth(80);
+        ImGui::InputInt("##skipdays", &skip_days);
+        ImGui::SameLine();
+        if (CQSPGui::DefaultButton("Skip days") && skip_days > 0) {
+            cqsp::scene::SkipToDate(date.GetDate() + skip_days * 24);
+        }
+    }
     ImGui::End();
 }
 
@@ -63,8 +90,19 @@ void SysTurnSaveWindow::DoUpdate(int delta_time) {
             TogglePlayState();
         }
     }
+    // Measure how fast the game is going
+    int date = cqsp::scene::GetUniverseSnapshot()->date.GetDate();
+    if (GetApp().GetTime() - last_measure > 0.5) {
+        if (last_measure > 0) {
+            ticks_per_second = (date - last_measure_date) / (GetApp().GetTime() - last_measure);
+        }
+        last_measure = GetApp().GetTime();
+        last_measure_date = date;
+    }
+
     // Update tick
-    if (to_tick && GetApp().GetTime() - last_tick > static_cast<float>(tick_speeds[tick_speed]) / 1000.f) {
+    if (to_tick && (cqsp::scene::IsFastForward() ||
+                    GetApp().GetTime() - last_tick > static_cast<float>(tick_speeds[tick_speed]) / 1000.f)) {
         GetUniverse().EnableTick();
         last_tick = GetApp().GetTime();
     }
@@ -33,6 +33,7 @@ class SysTurnSaveWindow : public SysUserInterface {
     void Init();
     void DoUI(int delta_time);
     void DoUpdate(int delta_time);
+    bool ReadsSnapshotOnly() override { return true; }
 
     void TogglePlayState();
 
@@ -41,6 +42,11 @@ class SysTurnSaveWindow : public SysUserInterface {
     bool to_tick = false;
     std::vector<int> tick_speeds{1000, 500, 333, 100, 50, 10, 1};
     int tick_speed = tick_speeds.size() / 2;
+
+    int skip_days = 365;
+    double last_measure = 0;
+    int last_measure_date = 0;
+    double ticks_per_second = 0;
 };
 }  // namespace systems
 }  // namespace client
@@ -33,6 +33,7 @@
 
 #include "client/components/planetrendering.h"
 #include "client/components/clientctx.h"
+#include "client/scenes/universescene.h"
 
 #include "engine/graphics/primitives/uvsphere.h"
 #include "engine/renderer/renderer.h"
@@ -90,6 +91,16 @@ struct PlanetOrbit {
         delete orbit_mesh;
     }
 };
+
+// Entities that are not in the snapshot are skipped instead of asserting
+template <typename Component>
+const Component* TryGetSnapshot(const entt::registry& registry, entt::entity entity) {
+    auto view = registry.view<const Component>();
+    if (!view.contains(entity)) {
+        return nullptr;
+    }
+    return &view.template get<const Component>(entity);
+}
 }  // namespace
 
 void SysStarSystemRenderer::Initialize() {
@@ -145,17 +156,20 @@ void SysStarSystemRenderer::Initialize() {
 }
 
 void SysStarSystemRenderer::OnTick() {
-    entt::entity current_planet = m_app.GetUniverse().view<FocusedPlanet>().front();
+    entt::entity current_planet = cqsp::scene::GetCurrentViewingPlanet();
     if (current_planet != entt::null) {
         view_center = CalculateObjectPos(m_viewing_entity);
     }
 
     namespace cqspb = cqsp::common::components::bodies;
 
-    auto system = m_app.GetUniverse().view<common::components::types::Orbit>();
+    auto system = m_snapshot->registry.view<const common::components::types::Orbit>();
     for (entt::entity ent : system) {
-        m_app.GetUniverse().get_or_emplace<ToRender>(ent);
+        m_render_registry.get_or_emplace<ToRender>(RenderEntity(ent));
     }
+    // Orbits and cities only change in a tick
+    GenerateOrbitLines();
+    CalculateCityPositions();
 }
 
 void SysStarSystemRenderer::Render(float deltaTime) {
@@ -163,7 +177,7 @@ void SysStarSystemRenderer::Render(float deltaTime) {
     namespace cqspb = cqsp::common::components::bodies;
 
     // Seeing new planet
-    entt::entity current_planet = m_app.GetUniverse().view<FocusedPlanet>().front();
+    entt::entity current_planet = cqsp::scene::GetCurrentViewingPlanet();
     if (current_planet != m_viewing_entity && current_planet != entt::null) {
         SPDLOG_INFO("Switched displaying planet, seeing {}", current_planet);
         m_viewing_entity = current_planet;
@@ -171,14 +185,10 @@ void SysStarSystemRenderer::Render(float deltaTime) {
         SeeEntity();
     }
 
-    FocusCityView();
-
     // Check for resized window
     window_ratio = static_cast<float>(m_app.GetWindowWidth()) /
                    static_cast<float>(m_app.GetWindowHeight());
 
-    GenerateOrbitLines();
-
     renderer.NewFrame(*m_app.GetWindow());
 
     glEnable(GL_DEPTH_TEST);
@@ -203,24 +213,25 @@ void SysStarSystemRenderer::Render(float deltaTime) {
 
 void SysStarSystemRenderer::SeeStarSystem() {
     namespace cqspb = cqsp::common::components::bodies;
-    m_universe.clear<ToRender>();
+    m_render_registry.clear<ToRender>();
 
     GenerateOrbitLines();
 
-    auto orbits = m_app.GetUniverse().view<common::components::types::Orbit>();
+    auto orbits = m_snapshot->registry.view<const common::components::types::Orbit>();
 
     for (auto body : orbits) {
         // Add a tag
-        m_universe.get_or_emplace<ToRender>(body);
+        m_render_registry.get_or_emplace<ToRender>(RenderEntity(body));
     }
 
     SPDLOG_INFO("Loading planet textures");
+    // The textures don't change, so they're read from the universe before the simulation starts ticking
     for (auto body : orbits) {
         if (!m_app.GetUniverse().all_of<cqspb::TexturedTerrain>(body)) {
             continue;
         }
         auto textures = m_app.GetUniverse().get<cqspb::TexturedTerrain>(body);
-        auto &data = m_universe.get_or_emplace<PlanetTexture>(body);
+        auto &data = m_render_registry.get_or_emplace<PlanetTexture>(RenderEntity(body));
         data.terrain = m_app.GetAssetManager().GetAsset<cqsp::asset::Texture>("core:" + textures.terrain_name);
         if (textures.normal_name != "") {
             data.normal = m_app.GetAssetManager().GetAsset<cqsp::asset::Texture>("core:" + textures.normal_name);
@@ -240,9 +251,8 @@ void SysStarSystemRenderer::SeeEntity() {
     view_center = CalculateObjectPos(m_viewing_entity);
 
     // Set the variable
-    if (m_app.GetUniverse().all_of<cqspb::Body>(m_viewing_entity)) {
-        scroll =
-            m_app.GetUniverse().get<cqspb::Body>(m_viewing_entity).radius * 2.5;
+    if (auto body = TryGetSnapshot<cqspb::Body>(m_snapshot->registry, m_viewing_entity)) {
+        scroll = body->radius * 2.5;
         if (scroll < 0.1) scroll = 0.1;
     } else {
         scroll = 5;
@@ -255,8 +265,6 @@ void SysStarSystemRenderer::Update(float deltaTime) {
     double deltaX = previous_mouseX - m_app.GetMouseX();
     double deltaY = previous_mouseY - m_app.GetMouseY();
 
-    is_founding_city = IsFoundingCity(m_universe);
-
     if (!ImGui::GetIO().WantCaptureMouse) {
         CalculateScroll();
 
@@ -276,7 +284,7 @@ void SysStarSystemRenderer::Update(float deltaTime) {
         previous_mouseY = m_app.GetMouseY();
 
         // If clicks on object, go to the planet
-        entt::entity ent = m_app.GetUniverse().view<MouseOverEntity>().front();
+        entt::entity ent = m_render_registry.view<MouseOverEntity>().front();
         if (m_app.MouseButtonIsReleased(engine::MouseInput::LEFT) && ent != entt::null && !m_app.MouseDragged()) {
             // Then go to the object
             SeePlanet(ent);
@@ -292,18 +300,9 @@ void SysStarSystemRenderer::Update(float deltaTime) {
                 double longitude = cqspt::toDegree(atan2(p.x, p.z));
                 SPDLOG_INFO("Founding city at {} {} {}", latitude, longitude, glm::length(p));
 
-                entt::entity settlement =
-                    cqsp::common::actions::CreateCity(m_app.GetUniverse(),
-                                                        on_planet, latitude, longitude);
-                // Set the name of the city
-                cqspc::Name& name = m_app.GetUniverse().emplace<cqspc::Name>(settlement);
-                name.name = m_app.GetUniverse().name_generators["Town Names"].Generate("1");
-                // Add population and economy
-                m_app.GetUniverse().emplace<cqspc::Industry>(settlement);
-
-                m_app.GetUniverse().clear<CityFounding>();
-
-                CalculateCityPositions();
+                // The simulation may be ticking, so the city is founded in `UpdateUniverse`
+                city_founding_queue.push_back({on_planet, latitude, longitude});
+                is_founding_city = false;
             }
         }
     }
@@ -332,9 +331,29 @@ void SysStarSystemRenderer::Update(float deltaTime) {
     }*/
 }
 
+bool SysStarSystemRenderer::UpdateUniverse() {
+    namespace cqspc = cqsp::common::components;
+    bool changed = !city_founding_queue.empty();
+    for (auto& order : city_founding_queue) {
+        entt::entity settlement =
+            cqsp::common::actions::CreateCity(m_universe, order.planet, order.latitude, order.longitude);
+        // Set the name of the city
+        cqspc::Name& name = m_universe.emplace<cqspc::Name>(settlement);
+        name.name = m_universe.name_generators["Town Names"].Generate("1");
+        // Add population and economy
+        m_universe.emplace<cqspc::Industry>(settlement);
+
+        m_universe.clear<CityFounding>();
+    }
+    city_founding_queue.clear();
+
+    is_founding_city = IsFoundingCity(m_universe);
+    FocusCityView();
+    return changed;
+}
+
 void SysStarSystemRenderer::SeePlanet(entt::entity ent) {
-    m_app.GetUniverse().clear<FocusedPlanet>();
-    m_app.GetUniverse().emplace<FocusedPlanet>(ent);
+    cqsp::scene::SeePlanet(ent);
 }
 
 void SysStarSystemRenderer::DoUI(float deltaTime) {
@@ -344,8 +363,7 @@ void SysStarSystemRenderer::DoUI(float deltaTime) {
     ImGui::TextFmt("{} {} {}", cam_pos.x, cam_pos.y, cam_pos.z);
     ImGui::TextFmt("{} {} {}", view_center.x, view_center.y, view_center.z);
     ImGui::TextFmt("{}", scroll);
-    ImGui::TextFmt("Focused planets: {}",
-        m_universe.view<cqsp::client::systems::FocusedPlanet>().size());
+    ImGui::TextFmt("Focused planet: {}", cqsp::scene::GetCurrentViewingPlanet());
     ImGui::End();
 }
 
@@ -354,9 +372,13 @@ void SysStarSystemRenderer::DrawStars() {
     // Draw stars
     namespace cqspb = cqsp::common::components::bodies;
     namespace cqsps = cqsp::common::components::ships;
-    auto stars = m_app.GetUniverse().view<ToRender, cqspb::Body, cqspb::LightEmitter>();
+    auto to_render = m_render_registry.view<ToRender>();
+    auto stars = m_snapshot->registry.view<const cqspb::Body, const cqspb::LightEmitter>();
     renderer.BeginDraw(physical_layer);
     for (auto ent_id : stars) {
+        if (!to_render.contains(ent_id)) {
+            continue;
+        }
         // Draw the star circle
         glm::vec3 object_pos = CalculateCenteredObject(ent_id);
         sun_position = object_pos;
@@ -370,7 +392,14 @@ void cqsp::client::systems::SysStarSystemRenderer::DrawBodies() {
     namespace cqspb = cqsp::common::components::bodies;
     namespace cqsps = cqsp::common::components::ships;
     // Draw other bodies
-    auto bodies = m_app.GetUniverse().view<ToRender, cqspb::Body>(entt::exclude<cqspb::LightEmitter>);
+    auto to_render = m_render_registry.view<ToRender>();
+    std::vector<entt::entity> bodies;
+    for (entt::entity body_entity :
+         m_snapshot->registry.view<const cqspb::Body>(entt::exclude<cqspb::LightEmitter>)) {
+        if (to_render.contains(body_entity)) {
+            bodies.push_back(body_entity);
+        }
+    }
     const double dist = 0.4;
     renderer.BeginDraw(planet_icon_layer);
     glDepthFunc(GL_ALWAYS);
@@ -411,7 +440,7 @@ void cqsp::client::systems::SysStarSystemRenderer::DrawBodies() {
                 // Do empty terrain
                 // Check if the planet has the thing
                 //DrawPlanet(object_pos, body_entity);
-            if (m_app.GetUniverse().all_of<cqspb::TexturedTerrain>(body_entity)) {
+            if (m_render_registry.view<PlanetTexture>().contains(body_entity)) {
                 DrawTexturedPlanet(object_pos, body_entity);
             } else {
                 DrawTerrainlessPlanet(body_entity, object_pos);
@@ -435,11 +464,15 @@ void SysStarSystemRenderer::DrawShips() {
     ZoneScoped;
     namespace cqsps = cqsp::common::components::ships;
     // Draw Ships
-    auto ships = m_app.GetUniverse().view<ToRender, cqsps::Ship>();
+    auto to_render = m_render_registry.view<ToRender>();
+    auto ships = m_snapshot->registry.view<const cqsps::Ship>();
 
     renderer.BeginDraw(ship_icon_layer);
     ship_overlay.shaderProgram->UseProgram();
     for (auto ent_id : ships) {
+        if (!to_render.contains(ent_id)) {
+            continue;
+        }
         glm::vec3 object_pos = CalculateCenteredObject(ent_id);
         ship_overlay.shaderProgram->setVec4("color", 1, 0, 0, 1);
         DrawShipIcon(object_pos);
@@ -465,8 +498,8 @@ void SysStarSystemRenderer::DrawEntityName(glm::vec3 &object_pos,
                                            entt::entity ent_id) {
     using cqsp::common::components::Name;
     std::string text = "";
-    if (m_app.GetUniverse().all_of<Name>(ent_id)) {
-        text = m_app.GetUniverse().get<Name>(ent_id);
+    if (auto name = TryGetSnapshot<Name>(m_snapshot->registry, ent_id)) {
+        text = name->name;
     } else {
         text = fmt::format("{}", ent_id);
     }
@@ -509,8 +542,8 @@ void cqsp::client::systems::SysStarSystemRenderer::DrawPlanetBillboards(const en
                                                                         const glm::vec3& object_pos) {
     using cqsp::common::components::Name;
     std::string text = "";
-    if (m_app.GetUniverse().all_of<Name>(ent_id)) {
-        text = m_app.GetUniverse().get<Name>(ent_id);
+    if (auto name = TryGetSnapshot<Name>(m_snapshot->registry, ent_id)) {
+        text = name->name;
     } else {
         text = fmt::format("{}", ent_id);
     }
@@ -592,8 +625,8 @@ void SysStarSystemRenderer::DrawShipIcon(glm::vec3 &object_pos) {
 
 void SysStarSystemRenderer::DrawTexturedPlanet(glm::vec3 &object_pos, entt::entity entity) {
     bool have_normal = false;
-    if (m_universe.all_of<PlanetTexture>(entity)) {
-        auto& terrain_data = m_universe.get<PlanetTexture>(entity);
+    if (m_render_registry.view<PlanetTexture>().contains(entity)) {
+        auto& terrain_data = m_render_registry.get<PlanetTexture>(entity);
         textured_planet.textures.clear();
         textured_planet.textures.push_back(terrain_data.terrain);
         if (terrain_data.normal) {
@@ -604,12 +637,12 @@ void SysStarSystemRenderer::DrawTexturedPlanet(glm::vec3 &object_pos, entt::enti
 
     namespace cqspb = cqsp::common::components::bodies;
     namespace cqspt = cqsp::common::components::types;
-    auto& body = m_universe.get<cqspb::Body>(entity);
+    auto& body = m_snapshot->registry.get<cqspb::Body>(entity);
 
     glm::mat4 position = glm::mat4(1.f);
     position = glm::translate(position, object_pos);
     // Time
-    float rot = (float)(m_universe.date.ToSecond() / body.rotation * cqspt::TWOPI);
+    float rot = (float)(m_snapshot->date.ToSecond() / body.rotation * cqspt::TWOPI);
     if (body.rotation == 0) {
         rot = 0;
     }
@@ -649,8 +682,8 @@ void SysStarSystemRenderer::DrawTexturedPlanet(glm::vec3 &object_pos, entt::enti
 }
 
 void SysStarSystemRenderer::DrawPlanet(glm::vec3 &object_pos, entt::entity entity) {
-    if (m_universe.all_of<TerrainTextureData>(entity)) {
-        auto& terrain_data = m_universe.get<TerrainTextureData>(entity);
+    if (m_render_registry.view<TerrainTextureData>().contains(entity)) {
+        auto& terrain_data = m_render_registry.get<TerrainTextureData>(entity);
         planet.textures.clear();
         planet.textures.push_back(terrain_data.terrain_albedo);
         planet.textures.push_back(terrain_data.heightmap);
@@ -672,8 +705,9 @@ void SysStarSystemRenderer::DrawPlanet(glm::vec3 &object_pos, entt::entity entit
     planet.shaderProgram->setVec3("viewPos", cam_pos);
 
     using cqsp::common::components::bodies::TerrainData;
-    entt::entity terrain = m_universe.get<cqsp::common::components::bodies::Terrain>(entity).terrain_type;
-    planet.shaderProgram->Set("seaLevel", m_universe.get<TerrainData>(terrain).sea_level);
+    const entt::registry& registry = m_snapshot->registry;
+    entt::entity terrain = registry.get<cqsp::common::components::bodies::Terrain>(entity).terrain_type;
+    planet.shaderProgram->Set("seaLevel", registry.get<TerrainData>(terrain).sea_level);
     engine::Draw(planet);
 }
 
@@ -683,7 +717,7 @@ void SysStarSystemRenderer::DrawStar(const entt::entity& entity, glm::vec3 &obje
 
     glm::mat4 transform = glm::mat4(1.f);
     // Scale it by radius
-    const double& radius = m_universe.get<common::components::bodies::Body>(entity).radius;
+    const double& radius = m_snapshot->registry.get<common::components::bodies::Body>(entity).radius;
     double scale = radius;
     transform = glm::scale(transform, glm::vec3(scale, scale, scale));
     position = position * transform;
@@ -699,8 +733,8 @@ void SysStarSystemRenderer::DrawTerrainlessPlanet(const entt::entity& entity, gl
     glm::mat4 position = glm::mat4(1.f);
     position = glm::translate(position, object_pos);
     float scale = 300;
-    if (m_universe.any_of<cqspb::Body>(entity)) {
-        scale = m_universe.get<cqspb::Body>(entity).radius;
+    if (auto body = TryGetSnapshot<cqspb::Body>(m_snapshot->registry, entity)) {
+        scale = body->radius;
     }
 
     position = glm::scale(position, glm::vec3(scale));
@@ -717,23 +751,21 @@ void SysStarSystemRenderer::RenderCities(glm::vec3 &object_pos, const entt::enti
     // Draw Cities
     namespace cqspc = cqsp::common::components;
     namespace cqspt = cqsp::common::components::types;
-    if (!m_app.GetUniverse().all_of<cqspc::Habitation>(body_entity)) {
-        return;
-    }
-    std::vector<entt::entity> cities = m_app.GetUniverse().get<cqspc::Habitation>(body_entity).settlements;
-    if (cities.empty()) {
+    auto habitation = TryGetSnapshot<cqspc::Habitation>(m_snapshot->registry, body_entity);
+    if (habitation == nullptr || habitation->settlements.empty()) {
         return;
     }
 
     // Put in same layer as ships
     city.shaderProgram->UseProgram();
     city.shaderProgram->setVec4("color", 0.5, 0.5, 0.5, 1);
-    for (auto city_entity : cities) {
-        // Calculate position to render
-        if (!m_app.GetUniverse().any_of<Offset>(city_entity)) {
-            // Calculate offset
+    auto offsets = m_render_registry.view<Offset>();
+    for (auto city_entity : habitation->settlements) {
+        // Offsets are calculated for the cities of the planet that is viewed
+        if (!offsets.contains(city_entity)) {
+            continue;
         }
-        glm::vec3 city_pos = m_app.GetUniverse().get<Offset>(city_entity).offset;
+        glm::vec3 city_pos = offsets.get<Offset>(city_entity).offset;
         // Check if line of sight and city position intersects the sphere that is the planet
 
         glm::vec3 city_world_pos = city_pos + object_pos;
@@ -765,34 +797,29 @@ void SysStarSystemRenderer::CalculateCityPositions() {
     namespace cqspc = cqsp::common::components;
     namespace cqspt = cqsp::common::components::types;
     // Calculate offset for all cities on planet if they exist
-    if (!m_app.GetUniverse().valid(m_viewing_entity)) {
-        return;
-    }
-    if (!m_app.GetUniverse().all_of<cqspc::Habitation>(m_viewing_entity)) {
-        return;
-    }
-    std::vector<entt::entity> cities = m_app.GetUniverse().get<cqspc::Habitation>(m_viewing_entity).settlements;
-    if (cities.empty()) {
+    auto habitation = TryGetSnapshot<cqspc::Habitation>(m_snapshot->registry, m_viewing_entity);
+    if (habitation == nullptr || habitation->settlements.empty()) {
         return;
     }
-    for (auto city_entity : cities) {
-        if (!m_app.GetUniverse().all_of<cqspt::SurfaceCoordinate>(city_entity)) {
+    for (auto city_entity : habitation->settlements) {
+        auto coord = TryGetSnapshot<cqspt::SurfaceCoordinate>(m_snapshot->registry, city_entity);
+        if (coord == nullptr) {
             continue;
         }
-        auto& coord = m_app.GetUniverse().get<cqspt::SurfaceCoordinate>(city_entity);
-        m_app.GetUniverse().emplace_or_replace<Offset>(city_entity, cqspt::toVec3(coord,  1));
+        m_render_registry.emplace_or_replace<Offset>(RenderEntity(city_entity), cqspt::toVec3(*coord,  1));
     }
-    SPDLOG_INFO("Calculated offset");
+    SPDLOG_TRACE("Calculated offset");
 }
 
 void cqsp::client::systems::SysStarSystemRenderer::CalculateScroll() {
     namespace cqspb = cqsp::common::components::bodies;
     double min_scroll;
-    if (m_viewing_entity == entt::null || !m_app.GetUniverse().all_of<cqspb::Body>(m_viewing_entity)) {
+    auto body = TryGetSnapshot<cqspb::Body>(m_snapshot->registry, m_viewing_entity);
+    if (body == nullptr) {
         // Scroll i
         min_scroll = 0.1;
     } else {
-        min_scroll = std::max(m_app.GetUniverse().get<cqspb::Body>(m_viewing_entity).radius * 1.1, 0.1);
+        min_scroll = std::max(body->radius * 1.1, 0.1);
     }
     if (scroll - m_app.GetScrollAmount() * 3 * scroll / 33 <= min_scroll) {
         return;
@@ -824,12 +851,19 @@ void cqsp::client::systems::SysStarSystemRenderer::FocusCityView() {
     scroll = 1.5;
 }
 
+entt::entity SysStarSystemRenderer::RenderEntity(entt::entity entity) {
+    if (!m_render_registry.valid(entity)) {
+        // Keep the same id as in the universe
+        m_render_registry.create(entity);
+    }
+    return entity;
+}
+
 glm::vec3 SysStarSystemRenderer::CalculateObjectPos(const entt::entity &ent) {
     namespace cqspt = cqsp::common::components::types;
     // Get the position
-    if (m_universe.all_of<cqspt::Kinematics>(ent)) {
-        auto& kin = m_universe.get<cqspt::Kinematics>(ent);
-        const auto& pos = kin.position + kin.center;
+    if (auto kin = TryGetSnapshot<cqspt::Kinematics>(m_snapshot->registry, ent)) {
+        const auto& pos = kin->position + kin->center;
         return glm::vec3(pos.x, pos.z, pos.y);
     }
     return glm::vec3(0, 0, 0);
@@ -868,7 +902,7 @@ void SysStarSystemRenderer::MoveCamera(double deltaTime) {
     glm::vec3 forward = glm::normalize(glm::vec3(glm::sin(view_x), 0, glm::cos(view_x)));
     glm::vec3 right = glm::normalize(glm::cross(forward, cam_up));
     auto post_move = [&]() {
-        m_universe.clear<cqsp::client::systems::FocusedPlanet>();
+        cqsp::scene::SeePlanet(entt::null);
         m_viewing_entity = entt::null;
     };
     if (m_app.ButtonIsHeld(engine::KeyInput::KEY_W)) {
@@ -935,7 +969,7 @@ float SysStarSystemRenderer::GetWindowRatio() {
 
 void SysStarSystemRenderer::GenerateOrbitLines() {
     SPDLOG_TRACE("Creating planet orbits");
-    auto orbits = m_app.GetUniverse().view<common::components::types::Orbit>();
+    auto orbits = m_snapshot->registry.view<const common::components::types::Orbit>();
     /* auto system =
         m_app.GetUniverse().get<common::components::bodies::OrbitalSystem>(
         m_app.GetUniverse().sun);*/
@@ -943,7 +977,7 @@ void SysStarSystemRenderer::GenerateOrbitLines() {
     // Get sun orbits
     for (auto body : orbits) {
         // Generate the orbit
-        auto& orb = m_universe.get<common::components::types::Orbit>(body);
+        auto& orb = orbits.get<const common::components::types::Orbit>(body);
         if (orb.semi_major_axis == 0) {
             continue;
         }
@@ -955,9 +989,10 @@ void SysStarSystemRenderer::GenerateOrbitLines() {
             // Convert to opengl
             orbit_points.push_back(glm::vec3(vec.x, vec.z, vec.y));
         }
-        auto& line = m_universe.emplace_or_replace<PlanetOrbit>(body);
+        auto& line = m_render_registry.get_or_emplace<PlanetOrbit>(RenderEntity(body));
         // Get the orbit line
         // Do the points
+        delete line.orbit_mesh;
         line.orbit_mesh = engine::primitive::CreateLineSequence(orbit_points);
     }
 }
@@ -965,8 +1000,13 @@ void SysStarSystemRenderer::GenerateOrbitLines() {
 glm::vec3 SysStarSystemRenderer::GetMouseIntersectionOnObject(int mouse_x, int mouse_y) {
     // Normalize 3d device coordinates
     namespace cqspb = cqsp::common::components::bodies;
-    auto bodies = m_app.GetUniverse().view<ToRender, cqspb::Body>();
+    auto to_render = m_render_registry.view<ToRender>();
+    auto stars = m_snapshot->registry.view<const cqspb::LightEmitter>();
+    auto bodies = m_snapshot->registry.view<const cqspb::Body>();
     for (entt::entity ent_id : bodies) {
+        if (!to_render.contains(ent_id)) {
+            continue;
+        }
         glm::vec3 object_pos = CalculateCenteredObject(ent_id);
         float x = (2.0f * mouse_x) / m_app.GetWindowWidth() - 1.0f;
         float y = 1.0f - (2.0f * mouse_y) / m_app.GetWindowHeight();
@@ -975,7 +1015,7 @@ glm::vec3 SysStarSystemRenderer::GetMouseIntersectionOnObject(int mouse_x, int m
         glm::vec3 ray_wor = CalculateMouseRay(glm::vec3(x, y, z));
 
         float radius = 1;
-        if (m_app.GetUniverse().all_of<cqspb::LightEmitter>(ent_id)) {
+        if (stars.contains(ent_id)) {
             radius = 10;
         }
 
@@ -998,10 +1038,16 @@ glm::vec3 SysStarSystemRenderer::GetMouseIntersectionOnObject(int mouse_x, int m
 
 entt::entity SysStarSystemRenderer::GetMouseOnObject(int mouse_x, int mouse_y) {
     namespace cqspb = cqsp::common::components::bodies;
+    m_render_registry.clear<MouseOverEntity>();
 
     // Loop through objects
-    auto bodies = m_app.GetUniverse().view<ToRender, cqspb::Body>();
+    auto to_render = m_render_registry.view<ToRender>();
+    auto stars = m_snapshot->registry.view<const cqspb::LightEmitter>();
+    auto bodies = m_snapshot->registry.view<const cqspb::Body>();
     for (entt::entity ent_id : bodies) {
+        if (!to_render.contains(ent_id)) {
+            continue;
+        }
         glm::vec3 object_pos = CalculateCenteredObject(ent_id);
         // Check if the sphere is rendered or not
         if (glm::distance(object_pos, cam_pos) > 100) {
@@ -1015,7 +1061,7 @@ entt::entity SysStarSystemRenderer::GetMouseOnObject(int mouse_x, int mouse_y) {
             float dim = circle_size * m_app.GetWindowHeight();
             if (glm::distance(glm::vec2(pos.x, m_app.GetWindowHeight() - pos.y),
                     glm::vec2(mouse_x, mouse_y)) <= dim) {
-                m_app.GetUniverse().emplace<MouseOverEntity>(ent_id);
+                m_render_registry.emplace<MouseOverEntity>(ent_id);
                 return ent_id;
             }
         } else {
@@ -1027,7 +1073,7 @@ entt::entity SysStarSystemRenderer::GetMouseOnObject(int mouse_x, int mouse_y) {
             glm::vec3 ray_wor = CalculateMouseRay(glm::vec3(x, y, z));
 
             float radius = 1;
-            if (m_app.GetUniverse().all_of<cqspb::LightEmitter>(ent_id)) {
+            if (stars.contains(ent_id)) {
                 radius = 10;
             }
 
@@ -1039,7 +1085,7 @@ entt::entity SysStarSystemRenderer::GetMouseOnObject(int mouse_x, int mouse_y) {
 
             // Get the closer value
             if ((b * b - c) >= 0) {
-                m_app.GetUniverse().emplace<MouseOverEntity>(ent_id);
+                m_render_registry.emplace<MouseOverEntity>(ent_id);
                 return ent_id;
             }
         }
@@ -1052,14 +1098,14 @@ bool cqsp::client::systems::SysStarSystemRenderer::IsFoundingCity(common::Univer
 }
 
 void SysStarSystemRenderer::DrawOrbit(const entt::entity &entity) {
-    if (!m_universe.any_of<PlanetOrbit>(entity)) {
+    if (!m_render_registry.view<PlanetOrbit>().contains(entity)) {
         return;
     }
     glm::vec3 center = glm::vec3(0, 0, 0);
     // If it has a parent, draw around the parent
-    entt::entity ref;
-    if ((ref = m_universe.get<common::components::types::Orbit>(entity).reference_body) != entt::null) {
-        center = CalculateObjectPos(ref);
+    auto orb = TryGetSnapshot<common::components::types::Orbit>(m_snapshot->registry, entity);
+    if (orb != nullptr && orb->reference_body != entt::null) {
+        center = CalculateObjectPos(orb->reference_body);
     }
     glm::mat4 transform = glm::mat4(1.f);
     transform = glm::translate(transform, CalculateCenteredObject(center));
@@ -1067,7 +1113,7 @@ void SysStarSystemRenderer::DrawOrbit(const entt::entity &entity) {
     orbit_shader->SetMVP(transform, camera_matrix, m_app.Get3DProj());
     orbit_shader->Set("color", glm::vec4(1, 1, 1, 1));
     // Set to the center of the universe
-    auto& orbit = m_universe.get<PlanetOrbit>(entity);
+    auto& orbit = m_render_registry.get<PlanetOrbit>(entity);
     orbit.orbit_mesh->Draw();
 }
 
@@ -17,11 +17,15 @@
 #pragma once
 
 #include <map>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include <entt/entt.hpp>
 #include <glm/glm.hpp>
 
 #include "common/universe.h"
+#include "common/universesnapshot.h"
 #include "engine/graphics/renderable.h"
 #include "engine/renderer/framebuffer.h"
 #include "engine/renderer/renderer.h"
@@ -39,8 +43,6 @@ struct ToRender {};
 
 struct MouseOverEntity {};
 
-// Planet that the camera center is at
-struct FocusedPlanet {};
 // City to look at
 struct FocusedCity {};
 
@@ -54,11 +56,26 @@ class SysStarSystemRenderer {
     SysStarSystemRenderer(cqsp::common::Universe &,
                           cqsp::engine::Application &);
     void Initialize();
+    /// <summary>
+    /// Updates the renderer after a new snapshot is set.
+    /// </summary>
     void OnTick();
+    /// <summary>
+    /// Sets the snapshot that the positions of objects are read from.
+    /// </summary>
+    void SetSnapshot(std::shared_ptr<const cqsp::common::UniverseSnapshot> snapshot) {
+        m_snapshot = std::move(snapshot);
+    }
     void Render(float deltaTime);
     void SeeStarSystem();
     void SeeEntity();
     void Update(float deltaTime);
+    /// <summary>
+    /// Does the changes to the universe that were queued by `Update`, like founding cities, and reads the
+    /// client tags that the interfaces set in the universe. Only call this while the universe is locked.
+    /// </summary>
+    /// <returns>If the universe was changed</returns>
+    bool UpdateUniverse();
     void SeePlanet(entt::entity);
     void DoUI(float deltaTime);
 
@@ -95,6 +112,19 @@ class SysStarSystemRenderer {
 
     cqsp::common::Universe &m_universe;
     cqsp::engine::Application &m_app;
+    // The simulation writes to the universe while ticking, so everything that is rendered is read from here
+    std::shared_ptr<const cqsp::common::UniverseSnapshot> m_snapshot;
+    // Renderer state of the entities of the universe, like tags and orbit meshes. Entities keep the ids they
+    // have in the universe. Only the main thread uses it, so it can be changed while the simulation is ticking.
+    entt::registry m_render_registry;
+
+    struct CityFoundingOrder {
+        entt::entity planet;
+        double latitude;
+        double longitude;
+    };
+    // Cities that were clicked on, which are founded the next time the universe is locked
+    std::vector<CityFoundingOrder> city_founding_queue;
 
     cqsp::engine::Renderable planet;
     cqsp::engine::Renderable textured_planet;
@@ -144,6 +174,8 @@ class SysStarSystemRenderer {
 
     void FocusCityView();
 
+    entt::entity RenderEntity(entt::entity);
+
     glm::vec3 CalculateObjectPos(const entt::entity &);
     glm::vec3 CalculateCenteredObject(const entt::entity &);
     glm::vec3 CalculateCenteredObject(const glm::vec3 &);
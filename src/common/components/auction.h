@@ -16,6 +16,7 @@
 */
 #pragma once
 
+#include <deque>
 #include <vector>
 #include <functional>
 #include <map>
@@ -72,9 +73,151 @@ typedef SortedOrderList<std::greater<Order>> DescendingSortedOrderList;
 /// </summary>
 typedef SortedOrderList<std::less<Order>> AscendingSortedOrderList;
 
+/// <summary>
+/// The orders on one side of the market for a good, grouped into price levels. The best price level is first,
+/// and the orders in a level are filled in the order that they were put.
+/// </summary>
+/// The total quantity and number of orders are kept up to date as orders are put and filled, so they don't have
+/// to be summed up.
+template <class Compare>
+class OrderBook {
+ public:
+    typedef std::map<double, std::deque<Order>, Compare> LevelMap;
+
+    void put(const Order& order) {
+        levels[order.price].push_back(order);
+        quantity += order.quantity;
+        count++;
+    }
+
+    /// <summary>
+    /// Takes up to `amount` from the orders, best price first, while the price of the level matches.
+    /// </summary>
+    /// Filled orders are removed, and the levels that were emptied are removed all at once at the end.
+    /// <returns>The amount that could not be filled</returns>
+    template <typename Matches>
+    double Fill(double amount, Matches matches) {
+        auto level = levels.begin();
+        while (level != levels.end() && amount > 0 && matches(level->first)) {
+            std::deque<Order>& orders = level->second;
+            while (!orders.empty() && amount > 0) {
+                Order& first = orders.front();
+                if (first.quantity > amount) {
+                    first.quantity -= amount;
+                    quantity -= amount;
+                    amount = 0;
+                    break;
+                }
+                amount -= first.quantity;
+                quantity -= first.quantity;
+                orders.pop_front();
+                count--;
+            }
+            if (!orders.empty()) {
+                break;
+            }
+            level++;
+        }
+        levels.erase(levels.begin(), level);
+        if (count == 0) {
+            // So that rounding doesn't leave quantity in an empty book
+            quantity = 0;
+        }
+        return amount;
+    }
+
+    /// <summary>
+    /// The first order that would be filled.
+    /// </summary>
+    const Order& front() const { return levels.begin()->second.front(); }
+
+    /// <summary>
+    /// The total quantity of every order.
+    /// </summary>
+    double GetQuantity() const { return quantity; }
+
+    /// <summary>
+    /// The number of orders.
+    /// </summary>
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    const LevelMap& GetLevels() const { return levels; }
+
+ private:
+    LevelMap levels;
+    double quantity = 0;
+    size_t count = 0;
+};
+
+/// <summary>
+/// Cheapest first
+/// </summary>
+typedef OrderBook<std::less<double>> SellOrderBook;
+
+/// <summary>
+/// Most expensive first
+/// </summary>
+typedef OrderBook<std::greater<double>> BuyOrderBook;
+
+/// <summary>
+/// The orders for a good that are cleared together, at a single price, at the end of the tick.
+/// </summary>
+struct CallOrders {
+    std::vector<Order> bids;
+    std::vector<Order> asks;
+};
+
+/// <summary>
+/// How much of an order was filled when a call auction cleared.
+/// </summary>
+struct OrderFill {
+    entt::entity agent;
+    double quantity;
+};
+
+/// <summary>
+/// The price and volume that a good cleared at, and what every order that was filled got.
+/// </summary>
+struct ClearingResult {
+    double price = 0;
+    double volume = 0;
+    std::vector<OrderFill> bought;
+    std::vector<OrderFill> sold;
+};
+
+/// <summary>
+/// Orders that are collected apart from the auction house, such as by the agents that one thread trades, and then
+/// submitted to it all at once, so that agents can place orders in parallel.
+/// </summary>
+struct OrderBatch {
+    struct Entry {
+        entt::entity good;
+        bool buy;
+        Order order;
+    };
+    std::vector<Entry> entries;
+
+    void Buy(entt::entity good, const Order& order) { entries.push_back({good, true, order}); }
+    void Sell(entt::entity good, const Order& order) { entries.push_back({good, false, order}); }
+};
+
 struct AuctionHouse {
-    std::map<entt::entity, DescendingSortedOrderList> sell_orders;
-    std::map<entt::entity, AscendingSortedOrderList> buy_orders;
+    std::map<entt::entity, SellOrderBook> sell_orders;
+    std::map<entt::entity, BuyOrderBook> buy_orders;
+
+    // Orders for the call auction, which are cleared with `ClearCallAuctions` instead of being matched when they
+    // are placed
+    std::map<entt::entity, CallOrders> call_orders;
+    // What every good cleared at the last time the call auctions were cleared
+    std::map<entt::entity, ClearingResult> clearing_results;
+
+    void Submit(const OrderBatch& batch) {
+        for (const OrderBatch::Entry& entry : batch.entries) {
+            CallOrders& orders = call_orders[entry.good];
+            (entry.buy ? orders.bids : orders.asks).push_back(entry.order);
+        }
+    }
 
     void AddSellOrder(entt::entity good, Order &&order) {
         sell_orders[good].put(order);
@@ -84,22 +227,14 @@ struct AuctionHouse {
         buy_orders[good].put(order);
     }
 
-    double GetDemand(entt::entity good) {
-        const AscendingSortedOrderList& buy_list = buy_orders[good];
-        double demand = 0;
-        for (const Order& order : buy_list) {
-            demand += order.quantity;
-        }
-        return demand;
+    double GetDemand(entt::entity good) const {
+        auto it = buy_orders.find(good);
+        return it == buy_orders.end() ? 0 : it->second.GetQuantity();
     }
 
-    double GetSupply(entt::entity good) {
-        const DescendingSortedOrderList& sell_list = sell_orders[good];
-        double supply = 0;
-        for (const Order& order : sell_list) {
-            supply += order.quantity;
-        }
-        return supply;
+    double GetSupply(entt::entity good) const {
+        auto it = sell_orders.find(good);
+        return it == sell_orders.end() ? 0 : it->second.GetQuantity();
     }
 };
 }  // namespace components
@@ -0,0 +1,528 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "common/components/denseledger.h"
+
+#include <algorithm>
+#include <string>
+
+#include "common/components/ledgermerge.h"
+#include "common/components/resource.h"
+
+namespace cqsp::common::components {
+namespace {
+template <typename Map>
+double Lookup(const Map& map, entt::entity good) {
+    auto it = map.find(good);
+    return it == map.end() ? 0 : it->second;
+}
+}  // namespace
+
+DenseLedger::DenseLedger(const GoodIndex& index, const ResourceLedger& ledger) : index(&index) {
+    AssignFrom(ledger);
+}
+
+void DenseLedger::Bind(const GoodIndex& new_index) {
+    if (index == &new_index) {
+        return;
+    }
+    // The positions of the goods are different in the new index, so every good has to be moved
+    ResourceLedger entries = ToLedger();
+    index = &new_index;
+    amounts.clear();
+    present.clear();
+    overflow.clear();
+    AssignFrom(entries);
+}
+
+void DenseLedger::AdoptIndex(const DenseLedger& other) {
+    if (index == nullptr && other.index != nullptr) {
+        Bind(*other.index);
+    }
+}
+
+void DenseLedger::Grow(size_t size) {
+    if (amounts.size() < size) {
+        amounts.resize(size, 0);
+        present.resize(size, 0);
+    }
+}
+
+double& DenseLedger::operator[](entt::entity good) {
+    int position = Find(good);
+    if (position == GoodIndex::none) {
+        return overflow[good];
+    }
+    Grow(position + 1);
+    present[position] = 1;
+    return amounts[position];
+}
+
+bool DenseLedger::HasGood(entt::entity good) const {
+    int position = Find(good);
+    if (position == GoodIndex::none) {
+        return overflow.find(good) != overflow.end();
+    }
+    return position < static_cast<int>(present.size()) && present[position];
+}
+
+double DenseLedger::Get(entt::entity good) const {
+    int position = Find(good);
+    if (position == GoodIndex::none) {
+        return Lookup(overflow, good);
+    }
+    return position < static_cast<int>(amounts.size()) ? amounts[position] : 0;
+}
+
+void DenseLedger::operator+=(const DenseLedger& other) {
+    AdoptIndex(other);
+    if (!SameIndex(other)) {
+        *this += other.ToLedger();
+        return;
+    }
+    const size_t size = other.amounts.size();
+    Grow(size);
+    double* a = amounts.data();
+    const double* b = other.amounts.data();
+    uint8_t* p = present.data();
+    const uint8_t* q = other.present.data();
+    for (size_t i = 0; i < size; i++) {
+        a[i] += b[i];
+        p[i] |= q[i];
+    }
+    for (const auto& [good, amount] : other.overflow) {
+        overflow[good] += amount;
+    }
+}
+
+void DenseLedger::operator-=(const DenseLedger& other) {
+    AdoptIndex(other);
+    if (!SameIndex(other)) {
+        *this -= other.ToLedger();
+        return;
+    }
+    const size_t size = other.amounts.size();
+    Grow(size);
+    double* a = amounts.data();
+    const double* b = other.amounts.data();
+    uint8_t* p = present.data();
+    const uint8_t* q = other.present.data();
+    for (size_t i = 0; i < size; i++) {
+        a[i] -= b[i];
+        p[i] |= q[i];
+    }
+    for (const auto& [good, amount] : other.overflow) {
+        overflow[good] -= amount;
+    }
+}
+
+void DenseLedger::MultiplyAdd(const DenseLedger& other, double value) {
+    AdoptIndex(other);
+    if (!SameIndex(other)) {
+        MultiplyAdd(other.ToLedger(), value);
+        return;
+    }
+    const size_t size = other.amounts.size();
+    Grow(size);
+    double* a = amounts.data();
+    const double* b = other.amounts.data();
+    uint8_t* p = present.data();
+    const uint8_t* q = other.present.data();
+    for (size_t i = 0; i < size; i++) {
+        a[i] += b[i] * value;
+        p[i] |= q[i];
+    }
+    for (const auto& [good, amount] : other.overflow) {
+        overflow[good] += amount * value;
+    }
+}
+
+void DenseLedger::MultiplyAdd(std::span<const double> other, double value) {
+    Grow(other.size());
+    double* a = amounts.data();
+    const double* b = other.data();
+    uint8_t* p = present.data();
+    for (size_t i = 0; i < other.size(); i++) {
+        a[i] += b[i] * value;
+        p[i] |= b[i] != 0;
+    }
+}
+
+void DenseLedger::operator+=(const ResourceLedger& other) {
+    for (const auto& [good, amount] : other) {
+        (*this)[good] += amount;
+    }
+}
+
+void DenseLedger::operator-=(const ResourceLedger& other) {
+    for (const auto& [good, amount] : other) {
+        (*this)[good] -= amount;
+    }
+}
+
+void DenseLedger::MultiplyAdd(const ResourceLedger& other, double value) {
+    for (const auto& [good, amount] : other) {
+        (*this)[good] += amount * value;
+    }
+}
+
+void DenseLedger::operator+=(const SmallLedger& other) {
+    for (const auto& [good, amount] : other) {
+        (*this)[good] += amount;
+    }
+}
+
+void DenseLedger::operator-=(const SmallLedger& other) {
+    for (const auto& [good, amount] : other) {
+        (*this)[good] -= amount;
+    }
+}
+
+void DenseLedger::MultiplyAdd(const SmallLedger& other, double value) {
+    for (const auto& [good, amount] : other) {
+        (*this)[good] += amount * value;
+    }
+}
+
+void DenseLedger::operator*=(const double value) {
+    // Goods that aren't present are 0, so they can be multiplied too
+    for (double& amount : amounts) {
+        amount *= value;
+    }
+    for (auto& [good, amount] : overflow) {
+        amount *= value;
+    }
+}
+
+void DenseLedger::operator*=(const DenseLedger& other) {
+    if (index == other.index) {
+        const size_t common = std::min(amounts.size(), other.amounts.size());
+        double* a = amounts.data();
+        const double* b = other.amounts.data();
+        for (size_t i = 0; i < common; i++) {
+            a[i] *= b[i];
+        }
+        // Not in the other ledger
+        std::fill(amounts.begin() + common, amounts.end(), 0);
+    } else {
+        for (size_t i = 0; i < amounts.size(); i++) {
+            amounts[i] *= other.Get(index->GetGood(static_cast<int>(i)));
+        }
+    }
+    for (auto& [good, amount] : overflow) {
+        amount *= other.Get(good);
+    }
+}
+
+DenseLedger DenseLedger::operator+(const DenseLedger& other) const {
+    DenseLedger ledger = *this;
+    ledger += other;
+    return ledger;
+}
+
+DenseLedger DenseLedger::operator-(const DenseLedger& other) const {
+    DenseLedger ledger = *this;
+    ledger -= other;
+    return ledger;
+}
+
+DenseLedger DenseLedger::operator*(double value) const {
+    DenseLedger ledger = *this;
+    ledger *= value;
+    return ledger;
+}
+
+DenseLedger DenseLedger::operator*(const DenseLedger& other) const {
+    DenseLedger ledger = *this;
+    ledger *= other;
+    return ledger;
+}
+
+template <typename Comparison>
+bool DenseLedger::Compare(const DenseLedger& other, Comparison comparison) const {
+    if (!SameIndex(other)) {
+        return MergeCompare(ToLedger(), other.ToLedger(), 0, comparison);
+    }
+    const size_t common = std::min(amounts.size(), other.amounts.size());
+    const double* a = amounts.data();
+    const double* b = other.amounts.data();
+    const uint8_t* p = present.data();
+    const uint8_t* q = other.present.data();
+    // Bitwise operators so that there are no branches in the loop
+    bool result = true;
+    for (size_t i = 0; i < common; i++) {
+        result &= !(p[i] | q[i]) | comparison(a[i], b[i]);
+    }
+    for (size_t i = common; i < amounts.size(); i++) {
+        result &= !p[i] | comparison(a[i], 0.);
+    }
+    for (size_t i = common; i < other.amounts.size(); i++) {
+        result &= !q[i] | comparison(0., b[i]);
+    }
+    return result && MergeCompare(overflow, other.overflow, 0, comparison);
+}
+
+template <typename Comparison>
+bool DenseLedger::Compare(double value, Comparison comparison) const {
+    if (empty()) {
+        return comparison(0., value);
+    }
+    bool result = true;
+    for (size_t i = 0; i < amounts.size(); i++) {
+        result &= !present[i] | comparison(amounts[i], value);
+    }
+    for (const auto& [good, amount] : overflow) {
+        result &= comparison(amount, value);
+    }
+    return result;
+}
+
+bool DenseLedger::operator<(const DenseLedger& other) const {
+    return Compare(other, [](double a, double b) { return a < b; });
+}
+
+bool DenseLedger::operator>(const DenseLedger& other) const {
+    return Compare(other, [](double a, double b) { return a > b; });
+}
+
+bool DenseLedger::operator<=(const DenseLedger& other) const {
+    return Compare(other, [](double a, double b) { return a <= b; });
+}
+
+bool DenseLedger::operator>=(const DenseLedger& other) const {
+    return Compare(other, [](double a, double b) { return a >= b; });
+}
+
+bool DenseLedger::operator==(const DenseLedger& other) const {
+    return Compare(other, [](double a, double b) { return a == b; });
+}
+
+bool DenseLedger::operator>(const double& value) const {
+    return Compare(value, [](double a, double b) { return a > b; });
+}
+
+bool DenseLedger::operator<(const double& value) const {
+    return Compare(value, [](double a, double b) { return a < b; });
+}
+
+bool DenseLedger::operator==(const double& value) const {
+    return Compare(value, [](double a, double b) { return a == b; });
+}
+
+bool DenseLedger::operator<=(const double& value) const {
+    return Compare(value, [](double a, double b) { return a <= b; });
+}
+
+bool DenseLedger::operator>=(const double& value) const {
+    return Compare(value, [](double a, double b) { return a >= b; });
+}
+
+bool DenseLedger::EnoughToTransfer(const DenseLedger& amount) const {
+    if (index != amount.index) {
+        return EnoughToTransfer(amount.ToLedger());
+    }
+    const size_t common = std::min(amounts.size(), amount.amounts.size());
+    const double* a = amounts.data();
+    const double* b = amount.amounts.data();
+    const uint8_t* q = amount.present.data();
+    bool result = true;
+    for (size_t i = 0; i < common; i++) {
+        result &= !q[i] | (a[i] >= b[i]);
+    }
+    for (size_t i = common; i < amount.amounts.size(); i++) {
+        result &= !q[i] | (0 >= b[i]);
+    }
+    for (const auto& [good, value] : amount.overflow) {
+        result &= Get(good) >= value;
+    }
+    return result;
+}
+
+bool DenseLedger::EnoughToTransfer(const ResourceLedger& amount) const {
+    bool result = true;
+    for (const auto& [good, value] : amount) {
+        result &= Get(good) >= value;
+    }
+    return result;
+}
+
+void DenseLedger::AssignFrom(const DenseLedger& other) {
+    AdoptIndex(other);
+    if (!SameIndex(other)) {
+        AssignFrom(other.ToLedger());
+        return;
+    }
+    const size_t size = other.amounts.size();
+    Grow(size);
+    double* a = amounts.data();
+    const double* b = other.amounts.data();
+    uint8_t* p = present.data();
+    const uint8_t* q = other.present.data();
+    for (size_t i = 0; i < size; i++) {
+        a[i] = q[i] ? b[i] : a[i];
+        p[i] |= q[i];
+    }
+    for (const auto& [good, amount] : other.overflow) {
+        overflow[good] = amount;
+    }
+}
+
+void DenseLedger::AssignFrom(const ResourceLedger& other) {
+    for (const auto& [good, amount] : other) {
+        (*this)[good] = amount;
+    }
+}
+
+void DenseLedger::TransferTo(DenseLedger& ledger_to, const ResourceLedger& amount) {
+    for (const auto& [good, value] : amount) {
+        (*this)[good] -= value;
+        ledger_to[good] += value;
+    }
+}
+
+void DenseLedger::RemoveResourcesLimited(const DenseLedger& other) {
+    AdoptIndex(other);
+    if (!SameIndex(other)) {
+        RemoveResourcesLimited(other.ToLedger());
+        return;
+    }
+    const size_t size = other.amounts.size();
+    Grow(size);
+    double* a = amounts.data();
+    const double* b = other.amounts.data();
+    uint8_t* p = present.data();
+    const uint8_t* q = other.present.data();
+    for (size_t i = 0; i < size; i++) {
+        double remaining = std::max(a[i] - b[i], 0.);
+        a[i] = q[i] ? remaining : a[i];
+        p[i] |= q[i];
+    }
+    for (const auto& [good, amount] : other.overflow) {
+        double& t = overflow[good];
+        t = std::max(t - amount, 0.);
+    }
+}
+
+void DenseLedger::RemoveResourcesLimited(const ResourceLedger& other) {
+    for (const auto& [good, amount] : other) {
+        double& t = (*this)[good];
+        t = std::max(t - amount, 0.);
+    }
+}
+
+ResourceLedger DenseLedger::LimitedRemoveResources(const ResourceLedger& other) {
+    ResourceLedger removed;
+    for (const auto& [good, amount] : other) {
+        double& t = (*this)[good];
+        if (t > amount) {
+            removed[good] = amount;
+            t -= amount;
+        } else {
+            removed[good] = t;
+            t = 0;
+        }
+    }
+    return removed;
+}
+
+double DenseLedger::GetSum() const {
+    // Four separate sums, because floating point addition isn't associative, so the compiler can't vectorize
+    // a single sum by itself
+    double sums[4] = {0, 0, 0, 0};
+    const size_t size = amounts.size();
+    const double* a = amounts.data();
+    size_t i = 0;
+    for (; i + 4 <= size; i += 4) {
+        sums[0] += a[i];
+        sums[1] += a[i + 1];
+        sums[2] += a[i + 2];
+        sums[3] += a[i + 3];
+    }
+    for (; i < size; i++) {
+        sums[0] += a[i];
+    }
+    double sum = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    for (const auto& [good, amount] : overflow) {
+        sum += amount;
+    }
+    return sum;
+}
+
+double DenseLedger::MultiplyAndGetSum(const DenseLedger& other) const {
+    double sum = 0;
+    if (index == other.index) {
+        double sums[4] = {0, 0, 0, 0};
+        const size_t common = std::min(amounts.size(), other.amounts.size());
+        const double* a = amounts.data();
+        const double* b = other.amounts.data();
+        size_t i = 0;
+        for (; i + 4 <= common; i += 4) {
+            sums[0] += a[i] * b[i];
+            sums[1] += a[i + 1] * b[i + 1];
+            sums[2] += a[i + 2] * b[i + 2];
+            sums[3] += a[i + 3] * b[i + 3];
+        }
+        for (; i < common; i++) {
+            sums[0] += a[i] * b[i];
+        }
+        sum = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    } else {
+        for (size_t i = 0; i < amounts.size(); i++) {
+            sum += amounts[i] * other.Get(index->GetGood(static_cast<int>(i)));
+        }
+    }
+    for (const auto& [good, amount] : overflow) {
+        sum += amount * other.Get(good);
+    }
+    return sum;
+}
+
+ResourceLedger DenseLedger::ToLedger() const {
+    ResourceLedger ledger;
+    for (const auto& [good, amount] : *this) {
+        ledger[good] = amount;
+    }
+    return ledger;
+}
+
+
+std::string DenseLedger::to_string() const {
+    std::string str = "{";
+    for (const auto& [good, amount] : *this) {
+        str.append(" ");
+        str.append(std::to_string(static_cast<std::uint32_t>(good)));
+        str.append(",");
+        str.append(std::to_string(amount));
+    }
+    str.append("}");
+    return str;
+}
+
+bool DenseLedger::empty() const {
+    return overflow.empty() && std::none_of(present.begin(), present.end(), [](uint8_t p) { return p != 0; });
+}
+
+size_t DenseLedger::size() const {
+    return overflow.size() + static_cast<size_t>(std::count(present.begin(), present.end(), 1));
+}
+
+void DenseLedger::clear() {
+    // Keep the memory, because the ledger will most likely be filled again
+    std::fill(amounts.begin(), amounts.end(), 0);
+    std::fill(present.begin(), present.end(), 0);
+    overflow.clear();
+}
+}  // namespace cqsp::common::components
@@ -0,0 +1,295 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "common/components/goodindex.h"
+
+namespace cqsp {
+namespace common {
+namespace components {
+class ResourceLedger;
+class SmallLedger;
+
+/// <summary>
+/// A ledger that stores the amount of every good contiguously, by the index of the good in a `GoodIndex`.
+/// </summary>
+/// It has the same interface as `ResourceLedger`, but operations between two ledgers that are indexed by the
+/// same `GoodIndex` are loops over arrays, which the compiler vectorizes, instead of walks over trees.
+///
+/// Like `ResourceLedger`, a good is only in the ledger after it has been set, even if its amount is zero, so
+/// every amount has a flag for if the good is present. Entities that aren't in the index are kept in a map,
+/// so a ledger that isn't bound to an index still works, only slower.
+class DenseLedger {
+ public:
+    DenseLedger() = default;
+    explicit DenseLedger(const GoodIndex& index) : index(&index) {}
+    DenseLedger(const GoodIndex& index, const ResourceLedger& ledger);
+
+    /// <summary>
+    /// Sets the index that this ledger uses, and moves the goods that are in the index out of the overflow.
+    /// </summary>
+    void Bind(const GoodIndex& index);
+    const GoodIndex* GetIndex() const { return index; }
+
+    /// <summary>
+    /// This resource ledger has enough resources inside to transfer "amount" amount of resources away
+    /// </summary>
+    bool EnoughToTransfer(const DenseLedger& amount) const;
+    bool EnoughToTransfer(const ResourceLedger& amount) const;
+
+    DenseLedger operator-(const DenseLedger&) const;
+    DenseLedger operator+(const DenseLedger&) const;
+    DenseLedger operator*(double value) const;
+
+    /// <summary>
+    /// Multiplies the resource with the resource value in other ledger
+    /// </summary>
+    DenseLedger operator*(const DenseLedger&) const;
+
+    void operator-=(const DenseLedger&);
+    void operator+=(const DenseLedger&);
+    void operator-=(const ResourceLedger&);
+    void operator+=(const ResourceLedger&);
+    void operator-=(const SmallLedger&);
+    void operator+=(const SmallLedger&);
+    void operator*=(const double value);
+
+    /// <summary>
+    /// Multiplies the resource with the resource value in other ledger
+    /// </summary>
+    void operator*=(const DenseLedger&);
+
+    /// <summary>
+    /// All resources in this ledger are smaller than than the other ledger
+    /// </summary>
+    bool operator<(const DenseLedger&) const;
+
+    /// <summary>
+    /// All resources in this ledger are greater than the other ledger
+    /// </summary>
+    bool operator>(const DenseLedger&) const;
+
+    /// <summary>
+    /// All resources in this ledger are smaller than or equal to than the other ledger
+    /// </summary>
+    bool operator<=(const DenseLedger&) const;
+
+    /// <summary>
+    /// All resources in this ledger are greater than or equal to the other ledger
+    /// </summary>
+    bool operator>=(const DenseLedger&) const;
+
+    bool operator==(const DenseLedger&) const;
+
+    /// <summary>
+    /// All resources in this ledger are greater than the number
+    /// </summary>
+    bool operator>(const double&) const;
+
+    /// <summary>
+    /// All resources in this ledger are less than than the number
+    /// </summary>
+    bool operator<(const double&) const;
+
+    bool operator==(const double&) const;
+
+    bool operator<=(const double&) const;
+    bool operator>=(const double&) const;
+
+    void AssignFrom(const DenseLedger&);
+    void AssignFrom(const ResourceLedger&);
+
+    void TransferTo(DenseLedger&, const ResourceLedger&);
+    // Equivalant to this += other * double
+    void MultiplyAdd(const DenseLedger&, double);
+    void MultiplyAdd(const ResourceLedger&, double);
+    void MultiplyAdd(const SmallLedger&, double);
+
+    /// <summary>
+    /// Adds amounts that are in the order of the goods in the index of this ledger, multiplied by the value.
+    /// Goods with an amount of 0 aren't added to the ledger.
+    /// </summary>
+    void MultiplyAdd(std::span<const double> amounts, double value);
+
+    /// <summary>
+    /// Removes the resources, and if the amount of resources removed are more than the resources
+    /// inside the stockpile, it will set that resource to zero.
+    /// </summary>
+    void RemoveResourcesLimited(const DenseLedger&);
+    void RemoveResourcesLimited(const ResourceLedger&);
+
+    /// <summary>
+    /// Same as RemoveResourcesLimited, except that it returns how much resources
+    /// it took out.
+    /// </summary>
+    ResourceLedger LimitedRemoveResources(const ResourceLedger&);
+
+    bool HasGood(entt::entity good) const;
+
+    /// <returns>the amount of the good, or 0 if it isn't in the ledger</returns>
+    double Get(entt::entity good) const;
+
+    double GetSum() const;
+
+    /// <summary>
+    /// Multiplies the numbers stated in the resource ledger. Used for calculating the price, becuase
+    /// usually the resource ledger will be the price.
+    /// </summary>
+    double MultiplyAndGetSum(const DenseLedger& ledger) const;
+
+    std::string to_string() const;
+
+    ResourceLedger ToLedger() const;
+
+    double& operator[](entt::entity good);
+
+    bool empty() const;
+    size_t size() const;
+    void clear();
+
+    /// <summary>
+    /// The number of goods that there is space for without allocating.
+    /// </summary>
+    size_t capacity() const { return amounts.capacity(); }
+    typedef std::map<entt::entity, double> OverflowMap;
+    const OverflowMap& GetOverflow() const { return overflow; }
+
+    /// <summary>
+    /// Iterates over the goods in the ledger, first the indexed goods in the order of the index, and then the
+    /// goods in the overflow.
+    /// </summary>
+    template <bool Const>
+    class Iterator {
+        using Ledger = std::conditional_t<Const, const DenseLedger, DenseLedger>;
+        using Amount = std::conditional_t<Const, const double&, double&>;
+        using OverflowIterator =
+            std::conditional_t<Const, OverflowMap::const_iterator, OverflowMap::iterator>;
+
+     public:
+        using value_type = std::pair<entt::entity, Amount>;
+        using reference = value_type;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::forward_iterator_tag;
+
+        struct pointer {
+            value_type value;
+            const value_type* operator->() const { return &value; }
+        };
+
+        Iterator(Ledger* ledger, size_t position, OverflowIterator overflow)
+            : ledger(ledger), position(position), overflow(overflow) {
+            SkipAbsent();
+        }
+
+        reference operator*() const {
+            if (position < ledger->amounts.size()) {
+                return value_type(ledger->index->GetGood(static_cast<int>(position)), ledger->amounts[position]);
+            }
+            return value_type(overflow->first, overflow->second);
+        }
+
+        pointer operator->() const { return pointer {**this}; }
+
+        Iterator& operator++() {
+            if (position < ledger->amounts.size()) {
+                position++;
+                SkipAbsent();
+            } else {
+                ++overflow;
+            }
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return position == other.position && overflow == other.overflow;
+        }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+     private:
+        void SkipAbsent() {
+            while (position < ledger->amounts.size() && !ledger->present[position]) {
+                position++;
+            }
+        }
+
+        Ledger* ledger;
+        size_t position;
+        OverflowIterator overflow;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    iterator begin() { return iterator(this, 0, overflow.begin()); }
+    iterator end() { return iterator(this, amounts.size(), overflow.end()); }
+    const_iterator begin() const { return const_iterator(this, 0, overflow.cbegin()); }
+    const_iterator end() const { return const_iterator(this, amounts.size(), overflow.cend()); }
+    const_iterator cbegin() const { return begin(); }
+    const_iterator cend() const { return end(); }
+
+ private:
+    /// <summary>
+    /// If the other ledger uses the same index, so that the amounts can be combined directly.
+    /// </summary>
+    bool SameIndex(const DenseLedger& other) const { return index == other.index; }
+
+    /// <summary>
+    /// Binds an unbound ledger to the index of the other ledger, so that it can be combined directly with it.
+    /// </summary>
+    void AdoptIndex(const DenseLedger& other);
+
+    /// <summary>
+    /// Makes sure that there is an amount for every good up to `size`.
+    /// </summary>
+    void Grow(size_t size);
+
+    /// <returns>the position of the good in the amounts, or `GoodIndex::none` if it isn't indexed</returns>
+    int Find(entt::entity good) const { return index == nullptr ? GoodIndex::none : index->Find(good); }
+
+    template <typename Comparison>
+    bool Compare(const DenseLedger& other, Comparison comparison) const;
+
+    template <typename Comparison>
+    bool Compare(double value, Comparison comparison) const;
+
+    const GoodIndex* index = nullptr;
+    std::vector<double> amounts;
+    // If the good at the index has been set, uint8_t instead of bool so that it can be vectorized
+    std::vector<uint8_t> present;
+    OverflowMap overflow;
+};
+}  // namespace components
+}  // namespace common
+}  // namespace cqsp
@@ -16,54 +16,255 @@
  */
 #include "common/components/economy.h"
 
+#include <algorithm>
+#include <utility>
+
+using cqsp::common::components::GoodIndex;
 using cqsp::common::components::Market;
+using cqsp::common::components::MarketColumns;
+using cqsp::common::components::MarketElement;
+using cqsp::common::components::MarketElementInformation;
 using cqsp::common::components::ResourceStockpile;
+using cqsp::common::components::SmallLedger;
+
+void MarketColumns::resize(int goods) {
+    supply.resize(goods, 0);
+    demand.resize(goods, 0);
+    price.resize(goods, 0);
+    sd_ratio.resize(goods, 0);
+}
+
+void MarketColumns::ClearTrades(uint32_t new_epoch) {
+    std::fill(supply.begin(), supply.end(), 0);
+    std::fill(demand.begin(), demand.end(), 0);
+    for (auto& [good, element] : overflow) {
+        element.supply = 0;
+        element.demand = 0;
+    }
+    epoch = new_epoch;
+}
+
+MarketColumns& Market::Current() {
+    MarketColumns& buffer = columns[current];
+    if (buffer.epoch != epoch) {
+        buffer.ClearTrades(epoch);
+    }
+    return buffer;
+}
+
+void Market::Bind(const GoodIndex& index) {
+    this->index = &index;
+    Resize();
+}
+
+void Market::Resize() {
+    if (index == nullptr) {
+        return;
+    }
+    const int goods = index->size();
+    if (goods > static_cast<int>(listed.size())) {
+        listed.resize(goods, false);
+    }
+    for (MarketColumns& buffer : columns) {
+        if (goods > buffer.size()) {
+            buffer.resize(goods);
+        }
+        // Goods that were added to the index after they were put on the market
+        for (auto it = buffer.overflow.begin(); it != buffer.overflow.end();) {
+            int position = index->Find(it->first);
+            if (position == GoodIndex::none) {
+                ++it;
+                continue;
+            }
+            buffer.supply[position] = it->second.supply;
+            buffer.demand[position] = it->second.demand;
+            buffer.price[position] = it->second.price;
+            buffer.sd_ratio[position] = it->second.sd_ratio;
+            listed[position] = true;
+            it = buffer.overflow.erase(it);
+        }
+    }
+}
+
+int Market::Find(entt::entity good) const {
+    if (index == nullptr) {
+        return GoodIndex::none;
+    }
+    int position = index->Find(good);
+    if (position >= Current().size()) {
+        // The good was added to the index after the columns were last resized, so it isn't on the market
+        return GoodIndex::none;
+    }
+    return position;
+}
+
+int Market::FindOrResize(entt::entity good) {
+    if (index == nullptr) {
+        return GoodIndex::none;
+    }
+    int position = index->Find(good);
+    if (position != GoodIndex::none && position >= std::as_const(*this).Current().size()) {
+        Resize();
+    }
+    return position;
+}
+
+std::vector<entt::entity> Market::GetGoods() const {
+    std::vector<entt::entity> goods;
+    for (size_t i = 0; i < listed.size(); i++) {
+        if (listed[i]) {
+            goods.push_back(index->GetGood(static_cast<int>(i)));
+        }
+    }
+    for (const auto& element : Current().overflow) {
+        goods.push_back(element.first);
+    }
+    return goods;
+}
+
+MarketElement Market::operator[](entt::entity good) {
+    MarketColumns& buffer = Current();
+    int position = FindOrResize(good);
+    if (position == GoodIndex::none) {
+        MarketElementInformation& information = buffer.overflow[good];
+        return {information.supply, information.demand, information.price, information.sd_ratio};
+    }
+    listed[position] = true;
+    return buffer.Element(position);
+}
+
+MarketElementInformation Market::Get(const MarketColumns& columns, int position, entt::entity good) {
+    if (position != GoodIndex::none) {
+        return columns.Information(position);
+    }
+    auto it = columns.overflow.find(good);
+    if (it == columns.overflow.end()) {
+        return MarketElementInformation();
+    }
+    return it->second;
+}
+
+MarketElementInformation Market::Get(entt::entity good) const {
+    MarketElementInformation information = Get(Current(), Find(good), good);
+    if (!HasTrades()) {
+        information.supply = 0;
+        information.demand = 0;
+    }
+    return information;
+}
+
+MarketElementInformation Market::GetLast(entt::entity good) const {
+    if (!HasLast()) {
+        // Nothing was traded in the epoch before, so the good was traded at the price it has now
+        MarketElementInformation information = Get(good);
+        information.supply = 0;
+        information.demand = 0;
+        return information;
+    }
+    return Get(Last(), Find(good), good);
+}
 
 void Market::AddSupply(const ResourceLedger& stockpile) {
     for (const auto& stockpile_element : stockpile) {
-        market_information[stockpile_element.first].supply += stockpile_element.second;
+        (*this)[stockpile_element.first].supply += stockpile_element.second;
     }
 }
 
 void Market::AddSupply(const ResourceLedger& stockpile, double multiplier) {
     for (const auto& stockpile_element : stockpile) {
-        market_information[stockpile_element.first].supply +=
-            stockpile_element.second * multiplier;
+        (*this)[stockpile_element.first].supply += stockpile_element.second * multiplier;
     }
 }
 
 void Market::AddDemand(const ResourceLedger& stockpile) {
     for (const auto& stockpile_element : stockpile) {
-        market_information[stockpile_element.first].demand += stockpile_element.second;
+        (*this)[stockpile_element.first].demand += stockpile_element.second;
     }
 }
 
 void Market::AddDemand(const ResourceLedger& stockpile, double multiplier) {
     for (const auto& stockpile_element : stockpile) {
-        market_information[stockpile_element.first].demand += stockpile_element.second * multiplier;
+        (*this)[stockpile_element.first].demand += stockpile_element.second * multiplier;
+    }
+}
+
+void Market::AddSupply(const SmallLedger& stockpile) {
+    for (const auto& stockpile_element : stockpile) {
+        (*this)[stockpile_element.first].supply += stockpile_element.second;
+    }
+}
+
+void Market::AddDemand(const SmallLedger& stockpile) {
+    for (const auto& stockpile_element : stockpile) {
+        (*this)[stockpile_element.first].demand += stockpile_element.second;
+    }
+}
+
+namespace {
+void AddColumn(std::span<const double> amounts, double* column, std::vector<uint8_t>& listed) {
+    for (size_t i = 0; i < amounts.size(); i++) {
+        column[i] += amounts[i];
+        listed[i] |= (amounts[i] != 0);
+    }
+}
+}  // namespace
+
+void Market::AddSupply(std::span<const double> amounts) {
+    // Adding nothing isn't a trade, so the market isn't marked as traded on
+    if (index == nullptr || std::all_of(amounts.begin(), amounts.end(), [](double amount) { return amount == 0; })) {
+        return;
+    }
+    if (static_cast<int>(amounts.size()) > std::as_const(*this).Current().size()) {
+        Resize();
+    }
+    AddColumn(amounts, Current().supply.data(), listed);
+}
+
+void Market::AddDemand(std::span<const double> amounts) {
+    // Adding nothing isn't a trade, so the market isn't marked as traded on
+    if (index == nullptr || std::all_of(amounts.begin(), amounts.end(), [](double amount) { return amount == 0; })) {
+        return;
+    }
+    if (static_cast<int>(amounts.size()) > std::as_const(*this).Current().size()) {
+        Resize();
     }
+    AddColumn(amounts, Current().demand.data(), listed);
 }
 
-double Market::GetPrice(const ResourceLedger& stockpile) {
+double Market::GetPrice(const ResourceLedger& stockpile) const {
     double price = 0;
     for (const auto& element : stockpile) {
-        price += market_information[element.first].price * element.second;
+        price += GetPrice(element.first) * element.second;
     }
     return price;
 }
 
-double Market::GetSDRatio(const entt::entity& good) {
-    return market_information[good].sd_ratio;
+double Market::GetPrice(const SmallLedger& stockpile) const {
+    double price = 0;
+    for (const auto& element : stockpile) {
+        price += GetPrice(element.first) * element.second;
+    }
+    return price;
 }
 
-double Market::GetSupply(const entt::entity& good) {
-    return market_information[good].supply;
+void Market::GetPrices(std::span<double> prices) const {
+    const MarketColumns& buffer = Current();
+    // Goods that aren't on the market yet have a price of 0
+    const size_t known = std::min(prices.size(), static_cast<size_t>(buffer.size()));
+    std::copy_n(buffer.price.begin(), known, prices.begin());
+    std::fill(prices.begin() + known, prices.end(), 0);
 }
 
-double Market::GetDemand(const entt::entity& good) {
-    return market_information[good].demand;
-}
+double Market::GetSDRatio(const entt::entity& good) const { return Get(good).sd_ratio; }
+
+double Market::GetSupply(const entt::entity& good) const { return Get(good).supply; }
 
-double Market::GetPrice(const entt::entity& good) {
-    return market_information[good].price;
+double Market::GetDemand(const entt::entity& good) const { return Get(good).demand; }
+
+double Market::GetPrice(const entt::entity& good) const {
+    int position = Find(good);
+    if (position != GoodIndex::none) {
+        return Current().price[position];
+    }
+    return Get(Current(), position, good).price;
 }
@@ -16,14 +16,19 @@
 */
 #pragma once
 
+#include <cstdint>
+#include <map>
+#include <span>
 #include <string>
 #include <vector>
-#include <set>
-#include <map>
 
 #include <entt/entt.hpp>
 
+#include "common/stardate.h"
+#include "common/components/goodindex.h"
 #include "common/components/resource.h"
+#include "common/util/entityset.h"
+#include "common/util/epochaccumulator.h"
 
 namespace cqsp {
 namespace common {
@@ -40,45 +45,204 @@ struct MarketInformation {
 
 struct MarketElementInformation {
     // Sum of the resources traded last time.
-    double supply;
-    double demand;
-    double price;
-    double sd_ratio;
+    double supply = 0;
+    double demand = 0;
+    double price = 0;
+    double sd_ratio = 0;
+};
+
+/// <summary>
+/// References to the information of a good on a market, so that it can be changed in place.
+/// </summary>
+struct MarketElement {
+    double& supply;
+    double& demand;
+    double& price;
+    double& sd_ratio;
 };
 
+/// <summary>
+/// The information of every good on a market, with every field as a separate column indexed by the good index, so
+/// that the whole market can be updated with loops over arrays.
+/// </summary>
+struct MarketColumns {
+    std::vector<double> supply;
+    std::vector<double> demand;
+    std::vector<double> price;
+    std::vector<double> sd_ratio;
+    // Goods that aren't in the good index
+    std::map<entt::entity, MarketElementInformation> overflow;
+    // The epoch of the market that the supply and demand were added up in
+    uint32_t epoch = 0;
+
+    int size() const { return static_cast<int>(price.size()); }
+    void resize(int goods);
+    /// <summary>
+    /// Sets the supply and demand of every good to 0, and keeps the prices.
+    /// </summary>
+    void ClearTrades(uint32_t new_epoch);
+    MarketElement Element(int good) { return {supply[good], demand[good], price[good], sd_ratio[good]}; }
+    MarketElementInformation Information(int good) const {
+        return {supply[good], demand[good], price[good], sd_ratio[good]};
+    }
+};
+
+/// <summary>
+/// The supply, demand and price of the goods on a market.
+/// </summary>
+/// The market is double buffered: agents add to the current columns during the tick, and SysMarket computes the new
+/// prices into the other columns and swaps them, so the information of the tick before is kept without copying it.
+///
+/// Every time SysMarket clears the market starts a new epoch. The columns are stamped with the epoch that their supply
+/// and demand were added up in, and supply and demand from an earlier epoch read as 0, so SysMarket doesn't have to
+/// clear them. They are only cleared when the columns are next written to, so markets that nobody trades on cost
+/// nothing to clear.
 struct Market {
-    std::map<entt::entity, MarketElementInformation> market_information;
-    std::map<entt::entity, MarketElementInformation> last_market_information;
+    Market() = default;
+    explicit Market(const GoodIndex& index) : index(&index) {}
+
+    /// <summary>
+    /// Sets the index that the columns of the market are indexed by. Goods that were on the market before are
+    /// moved into the columns.
+    /// </summary>
+    void Bind(const GoodIndex& index);
+    const GoodIndex* GetIndex() const { return index; }
 
-    std::set<entt::entity> participants;
+    /// <summary>
+    /// Makes space in the columns for every good in the index.
+    /// </summary>
+    void Resize();
+
+    /// <summary>
+    /// The columns that the agents add to, which are cleared first if they are from an earlier epoch.
+    /// </summary>
+    /// This marks the market as traded on in this epoch, so only use it to write to the columns, and read from the
+    /// const columns instead.
+    MarketColumns& Current();
+    /// <summary>
+    /// The columns that the agents add to, which may have supply and demand from an earlier epoch in them.
+    /// </summary>
+    const MarketColumns& Current() const { return columns[current]; }
+    /// <summary>
+    /// The columns that the market information of the tick before is in, and that the next tick is computed into.
+    /// </summary>
+    MarketColumns& Last() { return columns[current ^ 1]; }
+    const MarketColumns& Last() const { return columns[current ^ 1]; }
+    /// <summary>
+    /// Ends the epoch of the market, and makes the columns of this epoch the last market information.
+    /// </summary>
+    void Swap() {
+        current ^= 1;
+        epoch++;
+    }
+    /// <summary>
+    /// Ends the epoch of a market that wasn't traded on. The prices stay the same, so the columns aren't swapped.
+    /// </summary>
+    void Advance() { epoch++; }
+
+    uint32_t GetEpoch() const { return epoch; }
+    /// <returns>if anything was added to the market in this epoch</returns>
+    bool HasTrades() const { return columns[current].epoch == epoch; }
+    /// <returns>if the last columns have the market information of the epoch before, instead of an older one</returns>
+    bool HasLast() const { return columns[current ^ 1].epoch + 1 == epoch; }
+
+    /// <summary>
+    /// If the good has been traded on the market, by the index of the good.
+    /// </summary>
+    const std::vector<uint8_t>& GetListed() const { return listed; }
+
+    /// <returns>the goods that have been traded on the market, in the order of the index</returns>
+    std::vector<entt::entity> GetGoods() const;
+
+    util::EntitySet participants;
+
+    // Added up as agents trade on the market, and cleared when SysMarketHistory records them, so that the history
+    // doesn't have to go through every participant.
+    // The money that was spent buying from the market
+    double gdp = 0;
+    // The amount of goods that were sold to the market
+    double volume = 0;
 
     // Math
     void AddSupply(const ResourceLedger& stockpile);
     void AddSupply(const ResourceLedger& stockpile, double multiplier);
     void AddDemand(const ResourceLedger& stockpile);
     void AddDemand(const ResourceLedger& stockpile, double multiplier);
+    // Agents trade a few goods at a time, so these don't need to build a full ledger
+    void AddSupply(const SmallLedger& stockpile);
+    void AddDemand(const SmallLedger& stockpile);
+    /// <summary>
+    /// Adds amounts that are in the order of the goods in the index of the market
+    /// </summary>
+    void AddSupply(std::span<const double> amounts);
+    void AddDemand(std::span<const double> amounts);
 
-    double GetPrice(const ResourceLedger& stockpile);
-    double GetPrice(const entt::entity& good);
-    double GetSDRatio(const entt::entity& good);
-    double GetSupply(const entt::entity& good);
-    double GetDemand(const entt::entity& good);
+    double GetPrice(const ResourceLedger& stockpile) const;
+    double GetPrice(const SmallLedger& stockpile) const;
+    double GetPrice(const entt::entity& good) const;
+    double GetSDRatio(const entt::entity& good) const;
+    double GetSupply(const entt::entity& good) const;
+    double GetDemand(const entt::entity& good) const;
+    /// <summary>
+    /// Writes the prices of the goods in the index of the market into the span, in the order of the index.
+    /// </summary>
+    void GetPrices(std::span<double> prices) const;
+
+    /// <returns>the information of the good in this tick, or zeros if it isn't on the market</returns>
+    MarketElementInformation Get(entt::entity good) const;
+    /// <returns>the information of the good in the tick before. If nothing was traded then, it has no supply or
+    /// demand, and the current price</returns>
+    MarketElementInformation GetLast(entt::entity good) const;
 
     void AddParticipant(entt::entity participant) {
         participants.insert(participant);
     }
 
-    MarketElementInformation& operator[](entt::entity ent) {
-        return market_information[ent];
-    }
+    /// <summary>
+    /// The information of the good in this tick, which is added to the market if it isn't on it.
+    /// </summary>
+    MarketElement operator[](entt::entity good);
 
-    auto begin() {
-        return market_information.begin();
-    }
+ private:
+    /// <returns>the index of the good in the columns, or GoodIndex::none if it is in the overflow</returns>
+    int Find(entt::entity good) const;
+    int FindOrResize(entt::entity good);
+    static MarketElementInformation Get(const MarketColumns& columns, int position, entt::entity good);
 
-    auto end() {
-        return market_information.end();
-    }
+    const GoodIndex* index = nullptr;
+    MarketColumns columns[2];
+    int current = 0;
+    uint32_t epoch = 0;
+    std::vector<uint8_t> listed;
+};
+
+/// <summary>
+/// The production of every agent on a market, as matrices with a row for every agent and a column for every good in
+/// the universe's good index, so that the trades of a whole market can be computed at once.
+/// </summary>
+/// SysAgent builds it, and rebuilds it when agents join or leave the market, or their generator or recipe changes.
+/// Consumption changes every tick, so it isn't kept in the matrix.
+struct TradeMatrix {
+    bool dirty = true;
+    // The number of goods in the good index when the matrix was built
+    int goods = 0;
+
+    std::vector<entt::entity> agents;
+    // Row major, with a row of `goods` amounts for every agent
+    std::vector<double> generation;
+    std::vector<double> recipe_input;
+    std::vector<double> recipe_output;
+    // If the rows of the agent are not empty, uint8_t instead of bool so that they can be read in parallel
+    std::vector<uint8_t> generates;
+    std::vector<uint8_t> converts;
+    std::vector<uint8_t> sells_recipe;
+    std::vector<uint8_t> buys_recipe;
+
+    // Agents that trade something that isn't in the good index, so have to be traded one by one
+    std::vector<entt::entity> unindexed;
+
+    // The prices of the market when the agents were last traded
+    std::vector<double> prices;
 };
 
 /// <summary>
@@ -110,47 +274,71 @@ struct Currency {};
 struct CostTable : public ResourceLedger {};
 
 // TODO(EhWhoAmI): Add multiple currency support
+/// <summary>
+/// The money of an agent, with the changes to it added up over an interval of `interval` ticks.
+/// </summary>
+/// The wallet doesn't know the date, so the interval is passed to everything that changes or reads the changes,
+/// see `GetEpoch`.
 struct Wallet {
+    /// <summary>
+    /// The number of ticks that the changes to the wallet are added up over.
+    /// </summary>
+    static constexpr int interval = 25;
+
     Wallet() = default;
     Wallet(entt::entity _currency, double _balance) : balance(_balance), currency(_currency) {}
 
-    Wallet& operator+=(double amount) {
+    /// <returns>the interval that the date is in, with the ticks before the first tick in an interval of their own
+    /// </returns>
+    static uint32_t GetEpoch(const StarDate& date) {
+        if (date.GetDate() < 0) {
+            return 0;
+        }
+        return static_cast<uint32_t>(date.GetDate() / interval) + 1;
+    }
+
+    /// <summary>
+    /// Adds money to the wallet, and to the change of the interval.
+    /// </summary>
+    void Add(double amount, uint32_t epoch) {
         this->balance += amount;
-        change += amount;
-        return *this;
+        change.Add(epoch, amount);
     }
-    Wallet& operator-=(double amount) {
+    /// <summary>
+    /// Takes money out of the wallet, and adds it to the spending of the interval.
+    /// </summary>
+    void Spend(double amount, uint32_t epoch) {
         this->balance -= amount;
-        change -= amount;
-        GDP_change += amount;
-        // Record the money delta since last reset
-        return *this;
+        // Record the money delta since the start of the interval
+        change.Add(epoch, -amount);
+        GDP_change.Add(epoch, amount);
     }
 
     operator double() const { return balance; }
 
-    Wallet& operator=(double _balance) {
-        change += (_balance - balance);
+    /// <summary>
+    /// Sets the balance, and adds the difference to the change of the interval.
+    /// </summary>
+    void Set(double _balance, uint32_t epoch) {
+        change.Add(epoch, _balance - balance);
         if ((_balance - balance) < 0) {
-            GDP_change += _balance - balance;
+            GDP_change.Add(epoch, _balance - balance);
         }
         balance = _balance;
-        return *this;
     }
 
     double GetBalance() const { return balance; }
 
-    void Reset() {
-        change = 0;
-        GDP_change = 0;
-    }
-    double GetGDPChange() { return GDP_change; }
+    /// <returns>how much the balance changed since the start of the interval</returns>
+    double GetChange(uint32_t epoch) const { return change.Get(epoch); }
+    double GetGDPChange(uint32_t epoch) const { return GDP_change.Get(epoch); }
 
  private:
     double balance = 0;
-    double change = 0;
+    // Changes from an earlier interval read as 0, so the wallets don't have to be reset
+    util::EpochAccumulator<double> change;
     // Only records when spending money, so when money decreases
-    double GDP_change = 0;
+    util::EpochAccumulator<double> GDP_change;
     entt::entity currency;
 };
 
@@ -0,0 +1,79 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <vector>
+
+#include <entt/entt.hpp>
+
+namespace cqsp {
+namespace common {
+namespace components {
+/// <summary>
+/// Maps every good to a dense index from 0 to the number of goods, in the order that they were loaded.
+/// </summary>
+/// Goods are added when they are loaded, and never removed, so ledgers that are indexed by it stay valid.
+class GoodIndex {
+ public:
+    static constexpr int none = -1;
+
+    /// <summary>
+    /// Adds the good to the end of the index, if it isn't already in it.
+    /// </summary>
+    /// <returns>the index of the good</returns>
+    int Add(entt::entity good) {
+        int index = Find(good);
+        if (index != none) {
+            return index;
+        }
+        auto id = static_cast<size_t>(entt::to_entity(good));
+        if (id >= indices.size()) {
+            indices.resize(id + 1, none);
+        }
+        indices[id] = static_cast<int>(goods.size());
+        goods.push_back(good);
+        return indices[id];
+    }
+
+    /// <returns>the index of the good, or `none` if it isn't a good</returns>
+    int Find(entt::entity good) const {
+        if (good == entt::null) {
+            return none;
+        }
+        auto id = static_cast<size_t>(entt::to_entity(good));
+        if (id >= indices.size() || indices[id] == none || goods[indices[id]] != good) {
+            return none;
+        }
+        return indices[id];
+    }
+
+    entt::entity GetGood(int index) const { return goods[index]; }
+    int size() const { return static_cast<int>(goods.size()); }
+
+    void clear() {
+        goods.clear();
+        indices.clear();
+    }
+
+ private:
+    std::vector<entt::entity> goods;
+    // Index of every good, by the id of the entity
+    std::vector<int> indices;
+};
+}  // namespace components
+}  // namespace common
+}  // namespace cqsp
@@ -33,7 +33,9 @@ class MarketHistory {
     std::map<entt::entity, std::vector<double>> supply;
     std::map<entt::entity, std::vector<double>> demand;
     std::map<entt::entity, std::vector<double>> volume;
+    // The money spent on the market, and the amount of goods sold to it, since the last record
     std::vector<double> gdp;
+    std::vector<double> total_volume;
 };
 }  // namespace components
 }  // namespace common
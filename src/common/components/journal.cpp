@@ -0,0 +1,123 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "common/components/journal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "common/components/economy.h"
+
+using cqsp::common::components::Journal;
+using cqsp::common::components::JournalEntry;
+
+namespace {
+std::atomic<uint64_t> next_journal_id = 1;
+
+auto SortKey(const JournalEntry& entry) {
+    return std::make_tuple(entt::to_integral(entry.payer), entt::to_integral(entry.payee),
+                           entt::to_integral(entry.good), entry.amount, entry.quantity);
+}
+}  // namespace
+
+Journal::Journal() : id(next_journal_id++) {}
+
+Journal::ThreadJournal& Journal::Local() {
+    struct LocalJournal {
+        uint64_t journal_id;
+        ThreadJournal* journal;
+        // Only used to tell if the journal was destroyed
+        std::weak_ptr<ThreadJournal> owner;
+    };
+    // The journals that the thread has written to
+    thread_local std::vector<LocalJournal> locals;
+    for (LocalJournal& local : locals) {
+        if (local.journal_id == id) {
+            return *local.journal;
+        }
+    }
+    // Forget the journals that were destroyed, so the list doesn't grow with every journal the thread wrote to
+    std::erase_if(locals, [](const LocalJournal& local) { return local.owner.expired(); });
+    std::lock_guard<std::mutex> lock(mutex);
+    journals.push_back(std::make_shared<ThreadJournal>());
+    locals.push_back({id, journals.back().get(), journals.back()});
+    return *journals.back();
+}
+
+void Journal::Record(std::span<const JournalEntry> entries) {
+    if (entries.empty()) {
+        return;
+    }
+    ThreadJournal& local = Local();
+    local.entries.insert(local.entries.end(), entries.begin(), entries.end());
+    for (const JournalEntry& entry : entries) {
+        local.pending_debits[entry.payer] += entry.amount;
+    }
+    // Only written once a tick, so that threads that record at the same time don't keep writing the same flag
+    if (!has_pending_debits.load(std::memory_order_relaxed)) {
+        has_pending_debits = true;
+    }
+}
+
+double Journal::GetPendingDebit(entt::entity payer) const {
+    if (!has_pending_debits) {
+        return 0;
+    }
+    double debit = 0;
+    for (const auto& journal : journals) {
+        auto it = journal->pending_debits.find(payer);
+        if (it != journal->pending_debits.end()) {
+            debit += it->second;
+        }
+    }
+    return debit;
+}
+
+size_t Journal::GetPendingCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t count = 0;
+    for (const auto& journal : journals) {
+        count += journal->entries.size();
+    }
+    return count;
+}
+
+void Journal::Settle(entt::registry& registry, const StarDate& date) {
+    std::lock_guard<std::mutex> lock(mutex);
+    settled.clear();
+    has_pending_debits = false;
+    for (auto& journal : journals) {
+        settled.insert(settled.end(), journal->entries.begin(), journal->entries.end());
+        journal->entries.clear();
+        journal->pending_debits.clear();
+    }
+    std::sort(settled.begin(), settled.end(),
+              [](const JournalEntry& a, const JournalEntry& b) { return SortKey(a) < SortKey(b); });
+
+    const uint32_t epoch = Wallet::GetEpoch(date);
+    for (const JournalEntry& entry : settled) {
+        if (auto* wallet = registry.try_get<Wallet>(entry.payer); wallet != nullptr) {
+            wallet->Spend(entry.amount, epoch);
+        }
+        if (auto* wallet = registry.try_get<Wallet>(entry.payee); wallet != nullptr) {
+            wallet->Add(entry.amount, epoch);
+        }
+    }
+}
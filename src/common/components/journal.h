@@ -0,0 +1,116 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "common/stardate.h"
+
+namespace cqsp {
+namespace common {
+namespace components {
+/// <summary>
+/// A payment for goods, from the wallet of the payer to the wallet of the payee.
+/// </summary>
+struct JournalEntry {
+    entt::entity payer = entt::null;
+    entt::entity payee = entt::null;
+    double amount = 0;
+    entt::entity good = entt::null;
+    double quantity = 0;
+};
+
+/// <summary>
+/// The trades of a tick, which are paid into the wallets all at once at the end of the tick.
+/// </summary>
+/// Every thread writes into a journal of its own, so trades can be recorded from several threads without locking, and
+/// wallets that many agents pay from, or into, are only changed by `Settle`. The entries are sorted before they are
+/// settled, so the balances don't depend on which thread recorded which trade. The pending debits are kept by every
+/// thread next to its entries too, and are only added up when they are read.
+class Journal {
+ public:
+    Journal();
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+
+    void Record(const JournalEntry& entry) { Record(std::span<const JournalEntry>(&entry, 1)); }
+    void Record(std::span<const JournalEntry> entries);
+
+    /// <summary>
+    /// The money that the payer has spent in entries that are waiting to be settled. Purchases have to be checked
+    /// against the balance of the wallet minus this, or several purchases in one tick can spend more than the
+    /// wallet has.
+    /// </summary>
+    /// Adds up the debits of every thread without locking, so it must not be called while other threads are
+    /// recording. Threads can read it at the same time as each other, such as when trades are planned in parallel
+    /// before they are recorded.
+    double GetPendingDebit(entt::entity payer) const;
+
+    /// <summary>
+    /// Pays every entry that was recorded since the last settlement into the wallets of the payers and payees.
+    /// Entities without a wallet are skipped, such as markets, which don't keep money.
+    /// </summary>
+    /// Must not be called while other threads are recording.
+    /// <param name="date">The date that the payments are added to the changes of the wallets by</param>
+    void Settle(entt::registry& registry, const StarDate& date);
+
+    /// <summary>
+    /// The entries that were paid by the last `Settle`, in the order that they were paid in.
+    /// </summary>
+    const std::vector<JournalEntry>& GetSettled() const { return settled; }
+
+    /// <summary>
+    /// The number of entries that are waiting to be settled.
+    /// </summary>
+    size_t GetPendingCount();
+
+ private:
+    /// <summary>
+    /// What one thread recorded since the last settlement.
+    /// </summary>
+    struct ThreadJournal {
+        std::vector<JournalEntry> entries;
+        // By the payer
+        std::unordered_map<entt::entity, double> pending_debits;
+    };
+
+    /// <returns>the journal of the calling thread</returns>
+    ThreadJournal& Local();
+
+    // Told apart from journals that were at the same address before
+    uint64_t id;
+    // Only held to add the journal of a thread, and to settle
+    std::mutex mutex;
+    // Shared with the threads that write to them, which only keep a weak pointer, so that the threads drop them once
+    // the journal is destroyed
+    std::vector<std::shared_ptr<ThreadJournal>> journals;
+    std::vector<JournalEntry> settled;
+    // So that agents can be checked without adding up the debits of every thread when nothing was bought this tick
+    std::atomic<bool> has_pending_debits = false;
+};
+}  // namespace components
+}  // namespace common
+}  // namespace cqsp
@@ -0,0 +1,209 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <type_traits>
+#include <utility>
+
+#include <entt/entt.hpp>
+
+namespace cqsp {
+namespace common {
+namespace components {
+/// <summary>
+/// Base of every lazily evaluated ledger expression.
+/// </summary>
+/// Arithmetic on `ResourceLedger`s builds a tree of expressions instead of new ledgers, which is only evaluated
+/// when it is assigned to a ledger or added to one, in a single pass over all of the ledgers in it. Every
+/// expression has a cursor that walks the goods in the result in order, so expressions can be merged the same
+/// way that ledgers are.
+///
+/// Expressions only hold references to the ledgers in them, so they have to be evaluated before those ledgers
+/// are destroyed. Don't store them in `auto` variables.
+struct LedgerExpression {};
+
+template <typename T>
+constexpr bool IsLedgerExpression = std::is_base_of_v<LedgerExpression, T>;
+
+/// <summary>
+/// A ledger in an expression.
+/// </summary>
+template <typename Ledger>
+class LedgerTerm : public LedgerExpression {
+    using Iterator = decltype(std::declval<const Ledger&>().begin());
+
+ public:
+    explicit LedgerTerm(const Ledger& ledger) : ledger(&ledger) {}
+
+    class Cursor {
+     public:
+        Cursor(Iterator it, Iterator end) : it(it), end(end) {}
+        bool Done() const { return it == end; }
+        entt::entity Good() const { return it->first; }
+        double Amount() const { return it->second; }
+        void Next() { ++it; }
+
+     private:
+        Iterator it;
+        Iterator end;
+    };
+
+    Cursor Begin() const { return Cursor(ledger->begin(), ledger->end()); }
+
+ private:
+    const Ledger* ledger;
+};
+
+/// <summary>
+/// Every amount in the expression multiplied by a number.
+/// </summary>
+template <typename Expression>
+class LedgerScale : public LedgerExpression {
+ public:
+    LedgerScale(Expression expression, double factor) : expression(expression), factor(factor) {}
+
+    class Cursor {
+     public:
+        Cursor(typename Expression::Cursor cursor, double factor) : cursor(cursor), factor(factor) {}
+        bool Done() const { return cursor.Done(); }
+        entt::entity Good() const { return cursor.Good(); }
+        double Amount() const { return cursor.Amount() * factor; }
+        void Next() { cursor.Next(); }
+
+     private:
+        typename Expression::Cursor cursor;
+        double factor;
+    };
+
+    Cursor Begin() const { return Cursor(expression.Begin(), factor); }
+
+ private:
+    Expression expression;
+    double factor;
+};
+
+/// <summary>
+/// Combines the amounts of every good in either of the expressions with `Operation`, where goods that are only
+/// in one of them are 0 in the other. This is the sum and difference of two ledgers.
+/// </summary>
+template <typename Left, typename Right, typename Operation>
+class LedgerMerge : public LedgerExpression {
+ public:
+    LedgerMerge(Left left, Right right) : left(left), right(right) {}
+
+    class Cursor {
+     public:
+        Cursor(typename Left::Cursor left, typename Right::Cursor right) : left(left), right(right) {}
+
+        bool Done() const { return left.Done() && right.Done(); }
+
+        entt::entity Good() const {
+            if (left.Done() || (!right.Done() && right.Good() < left.Good())) {
+                return right.Good();
+            }
+            return left.Good();
+        }
+
+        double Amount() const {
+            const entt::entity good = Good();
+            const double left_amount = InLeft(good) ? left.Amount() : 0;
+            const double right_amount = InRight(good) ? right.Amount() : 0;
+            return Operation()(left_amount, right_amount);
+        }
+
+        void Next() {
+            const entt::entity good = Good();
+            if (InLeft(good)) {
+                left.Next();
+            }
+            if (InRight(good)) {
+                right.Next();
+            }
+        }
+
+     private:
+        bool InLeft(entt::entity good) const { return !left.Done() && left.Good() == good; }
+        bool InRight(entt::entity good) const { return !right.Done() && right.Good() == good; }
+
+        typename Left::Cursor left;
+        typename Right::Cursor right;
+    };
+
+    Cursor Begin() const { return Cursor(left.Begin(), right.Begin()); }
+
+ private:
+    Left left;
+    Right right;
+};
+
+/// <summary>
+/// The goods in the left expression, multiplied by the amount of the same good in the right expression, the same
+/// as `ResourceLedger::operator*=`.
+/// </summary>
+template <typename Left, typename Right>
+class LedgerProduct : public LedgerExpression {
+ public:
+    LedgerProduct(Left left, Right right) : left(left), right(right) {}
+
+    class Cursor {
+     public:
+        Cursor(typename Left::Cursor left, typename Right::Cursor right) : left(left), right(right) { Align(); }
+        bool Done() const { return left.Done(); }
+        entt::entity Good() const { return left.Good(); }
+        double Amount() const {
+            return (!right.Done() && right.Good() == left.Good()) ? left.Amount() * right.Amount() : 0;
+        }
+        void Next() {
+            left.Next();
+            Align();
+        }
+
+     private:
+        // Moves the right cursor to the good that the left cursor is on, or the one after it
+        void Align() {
+            while (!left.Done() && !right.Done() && right.Good() < left.Good()) {
+                right.Next();
+            }
+        }
+
+        typename Left::Cursor left;
+        typename Right::Cursor right;
+    };
+
+    Cursor Begin() const { return Cursor(left.Begin(), right.Begin()); }
+
+ private:
+    Left left;
+    Right right;
+};
+
+struct LedgerAdd {
+    double operator()(double a, double b) const { return a + b; }
+};
+
+struct LedgerSubtract {
+    double operator()(double a, double b) const { return a - b; }
+};
+
+template <typename Left, typename Right>
+using LedgerSum = LedgerMerge<Left, Right, LedgerAdd>;
+
+template <typename Left, typename Right>
+using LedgerDifference = LedgerMerge<Left, Right, LedgerSubtract>;
+}  // namespace components
+}  // namespace common
+}  // namespace cqsp
@@ -0,0 +1,67 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+namespace cqsp {
+namespace common {
+namespace components {
+/// <summary>
+/// Walks two ledgers that are sorted by good at the same time, and calls `emit` with every good in either
+/// of them, and the result of `func` on the amounts. Goods that are only in one ledger are `identity` in the other.
+/// </summary>
+/// Both `ResourceLedger` and `SmallLedger` are sorted by good, so this works on any combination of them. The goods
+/// are emitted in order, so the result can be appended to without searching.
+template <class Ledger1, class Ledger2, class Function, class Emit>
+void merge_apply(const Ledger1& m1, const Ledger2& m2, double identity, Function func, Emit emit) {
+    auto it1 = m1.begin();
+    auto it2 = m2.begin();
+    const auto end1 = m1.end();
+    const auto end2 = m2.end();
+    while (it1 != end1 && it2 != end2) {
+        if (it1->first < it2->first) {
+            emit(it1->first, func(it1->second, identity));
+            ++it1;
+        } else if (it2->first < it1->first) {
+            emit(it2->first, func(identity, it2->second));
+            ++it2;
+        } else {
+            emit(it1->first, func(it1->second, it2->second));
+            ++it1;
+            ++it2;
+        }
+    }
+    for (; it1 != end1; ++it1) {
+        emit(it1->first, func(it1->second, identity));
+    }
+    for (; it2 != end2; ++it2) {
+        emit(it2->first, func(identity, it2->second));
+    }
+}
+
+/// <summary>
+/// If `func` is true for the amounts of every good in either of the ledgers, where goods that are only in one
+/// ledger are `identity` in the other.
+/// </summary>
+template <class Ledger1, class Ledger2, class Function>
+bool MergeCompare(const Ledger1& m1, const Ledger2& m2, double identity, Function func) {
+    bool op = true;
+    merge_apply(m1, m2, identity, func, [&op](auto, bool result) { op &= result; });
+    return op;
+}
+}  // namespace components
+}  // namespace common
+}  // namespace cqsp
@@ -20,76 +20,13 @@
 
 #include <utility>
 
-namespace {
-using cqsp::common::components::ResourceLedger;
-template<class Function>
-ResourceLedger merge_apply(const ResourceLedger &m1, const ResourceLedger &m2,
-                           ResourceLedger::mapped_type identity, Function func) {
-    auto it1 = m1.begin();
-    auto it2 = m2.begin();
-
-    auto comp = m1.value_comp();
-    ResourceLedger res;
-    while (true) {
-        bool end1 = it1 == m1.end();
-        bool end2 = it2 == m2.end();
-        if (end1 && end2) break;
-
-        if (end2 || (!end1 && comp(*it1, *it2))) {
-            res.emplace(it1->first, func(it1->second, identity));
-            ++it1;
-            continue;
-        }
-        if (end1 || comp(*it2, *it1)) {
-            res.emplace(it2->first, func(identity, it2->second));
-            ++it2;
-            continue;
-        }
-        res.emplace(it1->first, func(it1->second, it2->second));
-        ++it1;
-        ++it2;
-    }
-    return res;
-}
-
-template<class Function>
-bool MergeCompare(const ResourceLedger &m1, const ResourceLedger&m2,
-                  ResourceLedger::mapped_type identity, Function func) {
-    auto it1 = m1.begin();
-    auto it2 = m2.begin();
-
-    auto comp = m1.value_comp();
-    bool op = true;
-    while (true) {
-        bool end1 = it1 == m1.end();
-        bool end2 = it2 == m2.end();
-        if (end1 && end2) break;
-
-        if (end2 || (!end1 && comp(*it1, *it2))) {
-            // Compare
-            op &= func(it1->second, identity);
-            ++it1;
-            continue;
-        }
-        if (end1 || comp(*it2, *it1)) {
-            // Compare
-            op &= func(identity, it2->second);
-            ++it2;
-            continue;
-        }
-        op &= func(it1->second, it2->second);
-        ++it1;
-        ++it2;
-    }
-    return op;
-}
-}  // namespace
+#include "common/components/ledgermerge.h"
 
 using cqsp::common::components::ResourceLedger;
-
+using cqsp::common::components::SmallLedger;
 
 #ifdef TRACY_ENABLE
-int ResourceLedger::stockpile_additions = 0;
+std::atomic<int> ResourceLedger::stockpile_additions = 0;
 #define STOCKPILE_ADDITION ++ResourceLedger::stockpile_additions;
 #else
 #define STOCKPILE_ADDITION
@@ -103,35 +40,6 @@ bool ResourceLedger::EnoughToTransfer(const ResourceLedger &amount) {
     return b;
 }
 
-ResourceLedger ResourceLedger::operator-(const ResourceLedger &other) {
-    ResourceLedger ledger;
-    ledger = *this;
-    ledger -= other;
-    return ledger;
-}
-
-ResourceLedger ResourceLedger::operator+(const ResourceLedger &other) {
-    ResourceLedger ledger;
-    ledger = *this;
-    ledger += other;
-    return ledger;
-}
-
-ResourceLedger ResourceLedger::operator*(double value) {
-    ResourceLedger ledger;
-    for (auto iterator = this->begin(); iterator != this->end(); iterator++) {
-        ledger[iterator->first] = iterator->second * value;
-    }
-    return ledger;
-}
-
-ResourceLedger ResourceLedger::operator*(ResourceLedger &other) {
-    ResourceLedger ledger;
-    ledger = *this;
-    ledger *= other;
-    return ledger;
-}
-
 void ResourceLedger::operator-=(const ResourceLedger &other) {
     for (auto iterator = other.begin(); iterator != other.end(); iterator++) {
         (*this)[iterator->first] -= iterator->second;
@@ -228,6 +136,13 @@ void ResourceLedger::MultiplyAdd(const ResourceLedger & other, double value) {
     }
 }
 
+void ResourceLedger::MultiplyAdd(const SmallLedger& other, double value) {
+    STOCKPILE_ADDITION;
+    for (const auto& [good, amount] : other) {
+        (*this)[good] += amount * value;
+    }
+}
+
 void ResourceLedger::RemoveResourcesLimited(const ResourceLedger & other) {
     for (auto iterator = other.begin(); iterator != other.end(); iterator++) {
         double &t = (*this)[iterator->first];
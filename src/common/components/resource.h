@@ -16,13 +16,18 @@
 */
 #pragma once
 
+#include <atomic>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include <map>
 #include <iostream>
 
 #include <entt/entt.hpp>
 
+#include "common/components/denseledger.h"
+#include "common/components/ledgerexpression.h"
+#include "common/components/smallledger.h"
 #include "common/components/units.h"
 
 namespace cqsp {
@@ -66,15 +71,37 @@ class ResourceLedger : private LedgerMap {
     /// <returns></returns>
     bool EnoughToTransfer(const ResourceLedger& amount);
 
-    ResourceLedger operator-(const ResourceLedger&);
-    ResourceLedger operator+(const ResourceLedger&);
-    ResourceLedger operator*(double value);
+    /// <summary>
+    /// Evaluates a ledger expression, such as `a * 2 + b`, into this ledger.
+    /// </summary>
+    template <typename Expression, typename = std::enable_if_t<IsLedgerExpression<Expression>>>
+    ResourceLedger(const Expression& expression) {  // NOLINT(runtime/explicit)
+        // The goods come out of the expression in order, so they can always be added at the end
+        for (auto cursor = expression.Begin(); !cursor.Done(); cursor.Next()) {
+            LedgerMap::emplace_hint(LedgerMap::end(), cursor.Good(), cursor.Amount());
+        }
+    }
+
+    template <typename Expression, typename = std::enable_if_t<IsLedgerExpression<Expression>>>
+    ResourceLedger& operator=(const Expression& expression) {
+        // Evaluated into a new ledger first, in case the expression reads this ledger
+        ResourceLedger result(expression);
+        LedgerMap::swap(result);
+        return *this;
+    }
 
     /// <summary>
-    /// Multiplies the resource with the resource value in other ledger
+    /// Adds a ledger expression in a single pass, so `ledger += other * 2` doesn't create another ledger.
     /// </summary>
-    /// <param name=""></param>
-    ResourceLedger operator*(ResourceLedger&);
+    template <typename Expression, typename = std::enable_if_t<IsLedgerExpression<Expression>>>
+    void operator+=(const Expression& expression) {
+        Accumulate(expression, 1);
+    }
+
+    template <typename Expression, typename = std::enable_if_t<IsLedgerExpression<Expression>>>
+    void operator-=(const Expression& expression) {
+        Accumulate(expression, -1);
+    }
 
     void operator-=(const ResourceLedger&);
     void operator+=(const ResourceLedger&);
@@ -128,6 +155,7 @@ class ResourceLedger : private LedgerMap {
     void TransferTo(ResourceLedger&, const ResourceLedger&);
     // Equivalant to this += other * double
     void MultiplyAdd(const ResourceLedger&, double);
+    void MultiplyAdd(const SmallLedger&, double);
 
     /// <summary>
     /// Removes the resources, and if the amount of resources removed are more than the resources
@@ -170,19 +198,85 @@ class ResourceLedger : private LedgerMap {
     using LedgerMap::rend;
     using LedgerMap::clear;
     using LedgerMap::empty;
+    using LedgerMap::size;
     using LedgerMap::emplace;
     using LedgerMap::value_comp;
     using LedgerMap::mapped_type;
 
 #ifdef TRACY_ENABLE
     // Debug value to determine how many stockpile operations are done in the tick
-    static int stockpile_additions;
+    // Atomic because systems can run in parallel
+    static std::atomic<int> stockpile_additions;
 #endif  // TRACY_ENABLE
+
+ private:
+    template <typename Expression>
+    void Accumulate(const Expression& expression, double sign) {
+        // Walk this ledger alongside the expression, so that every good is found without searching the tree
+        auto position = LedgerMap::begin();
+        for (auto cursor = expression.Begin(); !cursor.Done(); cursor.Next()) {
+            const entt::entity good = cursor.Good();
+            while (position != LedgerMap::end() && position->first < good) {
+                ++position;
+            }
+            if (position != LedgerMap::end() && position->first == good) {
+                position->second += sign * cursor.Amount();
+            } else {
+                position = LedgerMap::emplace_hint(position, good, sign * cursor.Amount());
+            }
+        }
+    }
 };
 
+// Arithmetic on ledgers creates expressions, which are only evaluated when they are assigned to a ledger
+template <typename T>
+constexpr bool IsLedgerOperand = std::is_base_of_v<ResourceLedger, T> || IsLedgerExpression<T>;
+
+template <typename T>
+auto MakeLedgerOperand(const T& operand) {
+    if constexpr (IsLedgerExpression<T>) {
+        return operand;
+    } else {
+        return LedgerTerm<ResourceLedger>(operand);
+    }
+}
+
+template <typename Left, typename Right,
+          typename = std::enable_if_t<IsLedgerOperand<Left> && IsLedgerOperand<Right>>>
+auto operator+(const Left& left, const Right& right) {
+    auto l = MakeLedgerOperand(left);
+    auto r = MakeLedgerOperand(right);
+    return LedgerSum<decltype(l), decltype(r)>(l, r);
+}
+
+template <typename Left, typename Right,
+          typename = std::enable_if_t<IsLedgerOperand<Left> && IsLedgerOperand<Right>>>
+auto operator-(const Left& left, const Right& right) {
+    auto l = MakeLedgerOperand(left);
+    auto r = MakeLedgerOperand(right);
+    return LedgerDifference<decltype(l), decltype(r)>(l, r);
+}
+
+template <typename Left, typename = std::enable_if_t<IsLedgerOperand<Left>>>
+auto operator*(const Left& left, double value) {
+    auto l = MakeLedgerOperand(left);
+    return LedgerScale<decltype(l)>(l, value);
+}
+
+/// <summary>
+/// Multiplies the resource with the resource value in other ledger
+/// </summary>
+template <typename Left, typename Right,
+          typename = std::enable_if_t<IsLedgerOperand<Left> && IsLedgerOperand<Right>>>
+auto operator*(const Left& left, const Right& right) {
+    auto l = MakeLedgerOperand(left);
+    auto r = MakeLedgerOperand(right);
+    return LedgerProduct<decltype(l), decltype(r)>(l, r);
+}
+
 struct Recipe {
-    ResourceLedger input;
-    ResourceLedger output;
+    SmallLedger input;
+    SmallLedger output;
 
     float interval;
 };
@@ -215,15 +309,19 @@ struct FactoryTimer {
     float time_left;
 };
 
-struct ResourceGenerator : public ResourceLedger {};
+struct ResourceGenerator : public SmallLedger {};
 
-struct ResourceConsumption : public ResourceLedger {};
+struct ResourceConsumption : public SmallLedger {};
 
 struct ResourceConverter {
     entt::entity recipe;
 };
 
-struct ResourceStockpile : public ResourceLedger { };
+/// <summary>
+/// Stockpiles hold many different goods, so they are dense ledgers. The universe binds them to its good index
+/// when they are created.
+/// </summary>
+struct ResourceStockpile : public DenseLedger { };
 
 struct ResourceDemand : public ResourceLedger { };
 
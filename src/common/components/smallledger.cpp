@@ -0,0 +1,293 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "common/components/smallledger.h"
+
+#include <algorithm>
+
+#include "common/components/ledgermerge.h"
+#include "common/components/resource.h"
+
+using cqsp::common::components::ResourceLedger;
+using cqsp::common::components::SmallLedger;
+
+namespace {
+bool EntryBefore(const SmallLedger::Entry& entry, entt::entity good) { return entry.first < good; }
+}  // namespace
+
+SmallLedger::SmallLedger(const ResourceLedger& ledger) {
+    for (const auto& [good, amount] : ledger) {
+        // The ledger is sorted the same way
+        Append(good, amount);
+    }
+}
+
+const SmallLedger::Entry* SmallLedger::Find(entt::entity good) const {
+    const Entry* position = std::lower_bound(begin(), end(), good, EntryBefore);
+    if (position != end() && position->first == good) {
+        return position;
+    }
+    return end();
+}
+
+SmallLedger::Entry* SmallLedger::Insert(const Entry* position, entt::entity good, double amount) {
+    const size_t offset = position - data();
+    if (!OnHeap() && inline_size < inline_capacity) {
+        Entry* entries = inline_entries.data();
+        std::move_backward(entries + offset, entries + inline_size, entries + inline_size + 1);
+        entries[offset] = Entry(good, amount);
+        inline_size++;
+        return entries + offset;
+    }
+    if (!OnHeap()) {
+        // Doesn't fit inline anymore, so move everything to the heap
+        heap_entries.reserve(inline_capacity * 2);
+        heap_entries.assign(inline_entries.begin(), inline_entries.begin() + inline_size);
+        inline_size = 0;
+    }
+    return &*heap_entries.insert(heap_entries.begin() + offset, Entry(good, amount));
+}
+
+void SmallLedger::Append(entt::entity good, double amount) {
+    Insert(end(), good, amount);
+}
+
+double& SmallLedger::operator[](entt::entity good) {
+    Entry* position = std::lower_bound(begin(), end(), good, EntryBefore);
+    if (position != end() && position->first == good) {
+        return position->second;
+    }
+    return Insert(position, good, 0)->second;
+}
+
+std::pair<SmallLedger::Entry*, bool> SmallLedger::emplace(entt::entity good, double amount) {
+    Entry* position = std::lower_bound(begin(), end(), good, EntryBefore);
+    if (position != end() && position->first == good) {
+        return {position, false};
+    }
+    return {Insert(position, good, amount), true};
+}
+
+double SmallLedger::Get(entt::entity good) const {
+    const Entry* position = Find(good);
+    return position == end() ? 0 : position->second;
+}
+
+SmallLedger SmallLedger::operator-(const SmallLedger& other) const {
+    SmallLedger ledger;
+    merge_apply(*this, other, 0, [](double a, double b) { return a - b; },
+                [&ledger](entt::entity good, double amount) { ledger.Append(good, amount); });
+    return ledger;
+}
+
+SmallLedger SmallLedger::operator+(const SmallLedger& other) const {
+    SmallLedger ledger;
+    merge_apply(*this, other, 0, [](double a, double b) { return a + b; },
+                [&ledger](entt::entity good, double amount) { ledger.Append(good, amount); });
+    return ledger;
+}
+
+SmallLedger SmallLedger::operator*(double value) const {
+    SmallLedger ledger = *this;
+    ledger *= value;
+    return ledger;
+}
+
+SmallLedger SmallLedger::operator*(const SmallLedger& other) const {
+    // Only the goods in this ledger are kept, the same as ResourceLedger
+    SmallLedger ledger = *this;
+    for (Entry& entry : ledger) {
+        entry.second *= other.Get(entry.first);
+    }
+    return ledger;
+}
+
+void SmallLedger::operator+=(const SmallLedger& other) {
+    MultiplyAdd(other, 1);
+}
+
+void SmallLedger::operator-=(const SmallLedger& other) {
+    MultiplyAdd(other, -1);
+}
+
+void SmallLedger::operator+=(const ResourceLedger& other) {
+    MultiplyAdd(other, 1);
+}
+
+void SmallLedger::operator-=(const ResourceLedger& other) {
+    MultiplyAdd(other, -1);
+}
+
+void SmallLedger::operator*=(const double value) {
+    for (Entry& entry : *this) {
+        entry.second *= value;
+    }
+}
+
+void SmallLedger::MultiplyAdd(const SmallLedger& other, double value) {
+    // Both ledgers are sorted, so walk them together, and only insert the goods that this ledger doesn't have
+    Entry* it = begin();
+    for (const Entry& entry : other) {
+        while (it != end() && it->first < entry.first) {
+            ++it;
+        }
+        if (it != end() && it->first == entry.first) {
+            it->second += entry.second * value;
+        } else {
+            it = Insert(it, entry.first, entry.second * value);
+        }
+        ++it;
+    }
+}
+
+void SmallLedger::MultiplyAdd(const ResourceLedger& other, double value) {
+    Entry* it = begin();
+    for (const auto& [good, amount] : other) {
+        while (it != end() && it->first < good) {
+            ++it;
+        }
+        if (it != end() && it->first == good) {
+            it->second += amount * value;
+        } else {
+            it = Insert(it, good, amount * value);
+        }
+        ++it;
+    }
+}
+
+void SmallLedger::AssignFrom(const SmallLedger& other) {
+    for (const Entry& entry : other) {
+        (*this)[entry.first] = entry.second;
+    }
+}
+
+void SmallLedger::AssignFrom(const ResourceLedger& other) {
+    for (const auto& [good, amount] : other) {
+        (*this)[good] = amount;
+    }
+}
+
+bool SmallLedger::EnoughToTransfer(const SmallLedger& amount) const {
+    bool result = true;
+    for (const Entry& entry : amount) {
+        result &= Get(entry.first) >= entry.second;
+    }
+    return result;
+}
+
+bool SmallLedger::operator>=(const SmallLedger& ledger) const {
+    return MergeCompare(*this, ledger, 0, [](double a, double b) { return a >= b; });
+}
+
+bool SmallLedger::operator==(const SmallLedger& ledger) const {
+    return MergeCompare(*this, ledger, 0, [](double a, double b) { return a == b; });
+}
+
+bool SmallLedger::operator<(const SmallLedger& ledger) const {
+    return MergeCompare(*this, ledger, 0, [](double a, double b) { return a < b; });
+}
+
+bool SmallLedger::operator>(const SmallLedger& ledger) const {
+    return MergeCompare(*this, ledger, 0, [](double a, double b) { return a > b; });
+}
+
+bool SmallLedger::operator<=(const SmallLedger& ledger) const {
+    return MergeCompare(*this, ledger, 0, [](double a, double b) { return a <= b; });
+}
+
+bool SmallLedger::operator>=(const ResourceLedger& ledger) const {
+    return MergeCompare(*this, ledger, 0, [](double a, double b) { return a >= b; });
+}
+
+bool SmallLedger::operator<=(const ResourceLedger& ledger) const {
+    return MergeCompare(*this, ledger, 0, [](double a, double b) { return a <= b; });
+}
+
+namespace {
+template <typename Comparison>
+bool CompareAll(const SmallLedger& ledger, double value, Comparison comparison) {
+    if (ledger.empty()) {
+        return comparison(0, value);
+    }
+    bool op = true;
+    for (const auto& entry : ledger) {
+        op &= comparison(entry.second, value);
+    }
+    return op;
+}
+}  // namespace
+
+bool SmallLedger::operator>(const double& value) const {
+    return CompareAll(*this, value, [](double a, double b) { return a > b; });
+}
+
+bool SmallLedger::operator<(const double& value) const {
+    return CompareAll(*this, value, [](double a, double b) { return a < b; });
+}
+
+bool SmallLedger::operator==(const double& value) const {
+    return CompareAll(*this, value, [](double a, double b) { return a == b; });
+}
+
+bool SmallLedger::operator<=(const double& value) const {
+    return CompareAll(*this, value, [](double a, double b) { return a <= b; });
+}
+
+bool SmallLedger::operator>=(const double& value) const {
+    return CompareAll(*this, value, [](double a, double b) { return a >= b; });
+}
+
+double SmallLedger::GetSum() const {
+    double sum = 0;
+    for (const Entry& entry : *this) {
+        sum += entry.second;
+    }
+    return sum;
+}
+
+double SmallLedger::MultiplyAndGetSum(const SmallLedger& other) const {
+    double sum = 0;
+    merge_apply(*this, other, 0, [](double a, double b) { return a * b; },
+                [&sum](entt::entity, double product) { sum += product; });
+    return sum;
+}
+
+double SmallLedger::MultiplyAndGetSum(const ResourceLedger& other) const {
+    double sum = 0;
+    merge_apply(*this, other, 0, [](double a, double b) { return a * b; },
+                [&sum](entt::entity, double product) { sum += product; });
+    return sum;
+}
+
+std::string SmallLedger::to_string() const {
+    std::string str = "{";
+    for (const Entry& entry : *this) {
+        str.append(" ");
+        str.append(std::to_string(static_cast<std::uint32_t>(entry.first)));
+        str.append(",");
+        str.append(std::to_string(entry.second));
+    }
+    str.append("}");
+    return str;
+}
+
+ResourceLedger SmallLedger::ToLedger() const {
+    ResourceLedger ledger;
+    for (const Entry& entry : *this) {
+        ledger[entry.first] = entry.second;
+    }
+    return ledger;
+}
@@ -0,0 +1,201 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+namespace cqsp {
+namespace common {
+namespace components {
+class ResourceLedger;
+
+/// <summary>
+/// A ledger for the few goods that a recipe, generator or consumption has, sorted by good in an array inside the
+/// ledger, so it doesn't allocate until it has more than `inline_capacity` goods.
+/// </summary>
+/// It has the same interface as `ResourceLedger` and is sorted the same way, so the two can be merged with each
+/// other directly. Once a ledger has more goods than fit inline, the goods are moved to the heap, and stay there
+/// until it is cleared.
+class SmallLedger {
+ public:
+    typedef std::pair<entt::entity, double> Entry;
+    static constexpr size_t inline_capacity = 8;
+
+    SmallLedger() = default;
+    explicit SmallLedger(const ResourceLedger& ledger);
+    /// <summary>
+    /// A ledger that allocates from the resource once it outgrows the inline entries, such as a `TickArena` for
+    /// scratch ledgers. Copies of it allocate from the default resource again.
+    /// </summary>
+    explicit SmallLedger(std::pmr::memory_resource* resource) : heap_entries(resource) {}
+
+    /// <summary>
+    /// This resource ledger has enough resources inside to transfer "amount" amount of resources away
+    /// </summary>
+    bool EnoughToTransfer(const SmallLedger& amount) const;
+
+    SmallLedger operator-(const SmallLedger&) const;
+    SmallLedger operator+(const SmallLedger&) const;
+    SmallLedger operator*(double value) const;
+
+    /// <summary>
+    /// Multiplies the resource with the resource value in other ledger
+    /// </summary>
+    SmallLedger operator*(const SmallLedger&) const;
+
+    void operator-=(const SmallLedger&);
+    void operator+=(const SmallLedger&);
+    void operator-=(const ResourceLedger&);
+    void operator+=(const ResourceLedger&);
+    void operator*=(const double value);
+
+    /// <summary>
+    /// All resources in this ledger are smaller than than the other ledger
+    /// </summary>
+    bool operator<(const SmallLedger&) const;
+
+    /// <summary>
+    /// All resources in this ledger are greater than the other ledger
+    /// </summary>
+    bool operator>(const SmallLedger&) const;
+
+    /// <summary>
+    /// All resources in this ledger are smaller than or equal to than the other ledger
+    /// </summary>
+    bool operator<=(const SmallLedger&) const;
+
+    /// <summary>
+    /// All resources in this ledger are greater than or equal to the other ledger
+    /// </summary>
+    bool operator>=(const SmallLedger&) const;
+
+    bool operator==(const SmallLedger&) const;
+
+    /// <summary>
+    /// All resources in this ledger are greater than or equal to the resources in a full ledger
+    /// </summary>
+    bool operator>=(const ResourceLedger&) const;
+    bool operator<=(const ResourceLedger&) const;
+
+    /// <summary>
+    /// All resources in this ledger are greater than the number
+    /// </summary>
+    bool operator>(const double&) const;
+
+    /// <summary>
+    /// All resources in this ledger are less than than the number
+    /// </summary>
+    bool operator<(const double&) const;
+
+    bool operator==(const double&) const;
+
+    bool operator<=(const double&) const;
+    bool operator>=(const double&) const;
+
+    void AssignFrom(const SmallLedger&);
+    void AssignFrom(const ResourceLedger&);
+
+    // Equivalant to this += other * double
+    void MultiplyAdd(const SmallLedger&, double);
+    void MultiplyAdd(const ResourceLedger&, double);
+
+    bool HasGood(entt::entity good) const { return Find(good) != end(); }
+
+    /// <returns>the amount of the good, or 0 if it isn't in the ledger</returns>
+    double Get(entt::entity good) const;
+
+    double GetSum() const;
+
+    /// <summary>
+    /// Multiplies the numbers stated in the resource ledger. Used for calculating the price, becuase
+    /// usually the resource ledger will be the price.
+    /// </summary>
+    double MultiplyAndGetSum(const SmallLedger& ledger) const;
+    double MultiplyAndGetSum(const ResourceLedger& ledger) const;
+
+    std::string to_string() const;
+
+    ResourceLedger ToLedger() const;
+
+    double& operator[](entt::entity good);
+
+    /// <summary>
+    /// Adds the good if it isn't in the ledger yet, like `std::map::emplace`.
+    /// </summary>
+    std::pair<Entry*, bool> emplace(entt::entity good, double amount);
+
+    // The keys of the entries must not be changed, or the ledger won't be sorted anymore
+    Entry* begin() { return data(); }
+    Entry* end() { return data() + size(); }
+    const Entry* begin() const { return data(); }
+    const Entry* end() const { return data() + size(); }
+    const Entry* cbegin() const { return begin(); }
+    const Entry* cend() const { return end(); }
+
+    bool empty() const { return size() == 0; }
+    size_t size() const { return OnHeap() ? heap_entries.size() : inline_size; }
+
+    /// <summary>
+    /// Removes every good, and moves back to the inline entries. The heap entries keep their capacity.
+    /// </summary>
+    void clear() {
+        inline_size = 0;
+        heap_entries.clear();
+    }
+
+    /// <summary>
+    /// The number of entries that the ledger has allocated on the heap.
+    /// </summary>
+    size_t heap_capacity() const { return heap_entries.capacity(); }
+
+    /// <summary>
+    /// If the entries have been moved to the heap.
+    /// </summary>
+    bool OnHeap() const { return !heap_entries.empty(); }
+
+ private:
+    Entry* data() { return OnHeap() ? heap_entries.data() : inline_entries.data(); }
+    const Entry* data() const { return OnHeap() ? heap_entries.data() : inline_entries.data(); }
+
+    const Entry* Find(entt::entity good) const;
+
+    /// <summary>
+    /// Inserts the good at the position, which has to keep the ledger sorted.
+    /// </summary>
+    Entry* Insert(const Entry* position, entt::entity good, double amount);
+
+    /// <summary>
+    /// Adds a good that is after every good in the ledger, so that merges can build the ledger without searching.
+    /// </summary>
+    void Append(entt::entity good, double amount);
+
+    std::array<Entry, inline_capacity> inline_entries;
+    uint32_t inline_size = 0;
+    // When there are more goods than fit inline, all of the goods are here instead
+    std::pmr::vector<Entry> heap_entries;
+};
+}  // namespace components
+}  // namespace common
+}  // namespace cqsp
@@ -16,7 +16,7 @@
 */
 #include "common/game.h"
 
-cqsp::common::Game::Game() {
+cqsp::common::Game::Game(int seed) : universe(seed) {
     script_interface.Init();
 }
 
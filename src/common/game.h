@@ -27,7 +27,8 @@ namespace common {
 /// </summary>
 class Game {
  public:
-    Game();
+    /// <param name="seed">Seed of the random number generator of the universe</param>
+    explicit Game(int seed = Universe::default_seed);
     ~Game();
 
     Universe& GetUniverse() { return universe; }
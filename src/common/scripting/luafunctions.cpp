@@ -221,7 +221,7 @@ void FunctionEconomy(cqsp::common::Universe& universe, cqsp::scripting::ScriptIn
         auto& market = universe.get<cqsp::common::components::Market>(market_entity);
         for (entt::entity entity : view) {
             // Assign price to market
-            market.market_information[entity].price = universe.get<cqspc::Price>(entity);
+            market[entity].price = universe.get<cqspc::Price>(entity);
         }
         return market_entity;
         // return entity;
@@ -237,7 +237,7 @@ void FunctionEconomy(cqsp::common::Universe& universe, cqsp::scripting::ScriptIn
     });
 
     REGISTER_FUNCTION("add_cash", [&](entt::entity participant, double balance) {
-        universe.get_or_emplace<cqspc::Wallet>(participant) += balance;
+        universe.get_or_emplace<cqspc::Wallet>(participant).Add(balance, cqspc::Wallet::GetEpoch(universe.date));
     });
 
     REGISTER_FUNCTION("create_mine", [&](entt::entity city, entt::entity resource, int amount, float productivity) {
@@ -17,21 +17,23 @@
 #include "common/simulation.h"
 
 #include <spdlog/spdlog.h>
+#include <tracy/Tracy.hpp>
 
 #include <vector>
 #include <memory>
 #include <string>
+#include <thread>
 
 #include "common/components/area.h"
 #include "common/components/name.h"
 #include "common/components/resource.h"
 #include "common/util/profiler.h"
+#include "common/util/tickarena.h"
 #include "common/systems/movement/sysmovement.h"
 #include "common/systems/economy/syspopulation.h"
 #include "common/systems/economy/sysinfrastructure.h"
 #include "common/systems/scriptrunner.h"
 #include "common/systems/economy/sysmarket.h"
-#include "common/systems/economy/sysfinance.h"
 #include "common/systems/economy/sysagent.h"
 #include "common/systems/economy/sysfactory.h"
 #include "common/systems/history/sysmarkethistory.h"
@@ -49,10 +51,10 @@
 using cqsp::common::systems::simulation::Simulation;
 using cqsp::common::Universe;
 
-Simulation::Simulation(cqsp::common::Game &game) : m_game(game), m_universe(game.GetUniverse()) {
+Simulation::Simulation(cqsp::common::Game &game) : m_game(game), m_universe(game.GetUniverse()),
+                                        scheduler(std::thread::hardware_concurrency()) {
     namespace cqspcs = cqsp::common::systems;
     AddSystem<cqspcs::SysScript>();
-    AddSystem<cqspcs::SysWalletReset>();
 
     AddSystem<cqspcs::SysNavyControl>();
 
@@ -65,6 +67,9 @@ Simulation::Simulation(cqsp::common::Game &game) : m_game(game), m_universe(game
     AddSystem<cqspcs::history::SysMarketHistory>();
     AddSystem<cqspcs::SysOrbit>();
     AddSystem<cqspcs::SysPath>();
+
+    TracyPlotConfig("Tick arena high water", tracy::PlotFormatType::Memory, true, true, 0);
+    TracyPlotConfig("Tick arena blocks allocated", tracy::PlotFormatType::Number, true, false, 0);
 }
 
 void Simulation::tick() {
@@ -77,11 +82,14 @@ void Simulation::tick() {
     auto start = std::chrono::high_resolution_clock::now();
     BEGIN_TIMED_BLOCK(Game_Loop);
 
-    for (auto& sys : system_list) {
-        if (m_universe.date.GetDate() % sys->Interval() == 0) {
-            sys->DoSystem();
-        }
-    }
+    scheduler.Run(scheduler.GetDueSystems(m_universe.date.GetDate()));
+    // Trades are paid after every system has run, so that systems don't race on the wallets they pay into
+    m_universe.journal.Settle(m_universe, m_universe.date);
+    // Everything that the systems allocated for this tick is freed at once
+    util::TickArena::ResetAll();
+    const util::TickArenaStats arena = util::TickArena::GetStats();
+    TracyPlot("Tick arena high water", static_cast<int64_t>(arena.high_water));
+    TracyPlot("Tick arena blocks allocated", static_cast<int64_t>(arena.block_allocations));
     END_TIMED_BLOCK(Game_Loop);
     auto end = std::chrono::high_resolution_clock::now();
     int len = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
@@ -21,6 +21,7 @@
 
 #include "common/game.h"
 #include "common/systems/isimulationsystem.h"
+#include "common/systems/systemscheduler.h"
 
 namespace cqsp {
 namespace common {
@@ -35,6 +36,9 @@ namespace simulation {
 /// AddSystem<SimSystemName>();
 /// ```
 ///
+/// Systems that are due in the same tick and don't touch the same components are run in parallel.
+/// Declare the components the system uses by overriding `ISimulationSystem::DeclareAccess`, or else
+/// the system will run by itself.
 class Simulation {
  public:
     explicit Simulation(cqsp::common::Game &game);
@@ -44,10 +48,22 @@ class Simulation {
     /// </summary>
     void tick();
 
+    /// <summary>
+    /// How long each system has taken to run, in the order the systems were added.
+    /// </summary>
+    const std::vector<SystemTiming>& GetSystemTimings() const { return scheduler.GetTimings(); }
+
+    /// <summary>
+    /// Spreads the work of systems that run every n ticks across every tick, so that there
+    /// isn't a spike every n ticks. See `ISimulationSystem::CanSlice`.
+    /// </summary>
+    void SetAmortized(bool amortize) { scheduler.SetAmortized(amortize); }
+
     template <class T>
     void AddSystem() {
         static_assert(std::is_base_of<cqsp::common::systems::ISimulationSystem, T>::value);
         system_list.push_back(std::make_unique<T>(m_game));
+        scheduler.AddSystem(system_list.back().get(), m_universe, entt::type_id<T>().name());
     }
 
  private:
@@ -57,6 +73,7 @@ class Simulation {
     /// </summary>
     std::vector<std::unique_ptr<cqsp::common::systems::ISimulationSystem>> system_list;
     cqsp::common::Universe &m_universe;
+    SystemScheduler scheduler;
 };
 }  // namespace simulation
 }  // namespace systems
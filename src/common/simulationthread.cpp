@@ -0,0 +1,181 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "common/simulationthread.h"
+
+#include <utility>
+
+#include <tracy/Tracy.hpp>
+
+namespace cqsp::common::systems::simulation {
+SimulationThread::SimulationThread(Simulation& simulation, Universe& universe)
+    : simulation(simulation), universe(universe), snapshot(TakeSnapshot(universe)) {
+    thread = std::thread(&SimulationThread::Run, this);
+}
+
+SimulationThread::~SimulationThread() {
+    Cancel();
+    {
+        std::lock_guard<std::mutex> lock(tick_mutex);
+        stopping = true;
+    }
+    tick_condition.notify_all();
+    thread.join();
+}
+
+bool SimulationThread::RequestTick() { return Request(std::chrono::microseconds(0), -1); }
+
+bool SimulationThread::RequestTicks(std::chrono::microseconds budget) { return Request(budget, -1); }
+
+bool SimulationThread::RequestTicksUntil(int date) { return Request(std::chrono::microseconds(0), date); }
+
+bool SimulationThread::Request(std::chrono::microseconds budget, int date) {
+    {
+        std::lock_guard<std::mutex> lock(tick_mutex);
+        if (ticking) {
+            return false;
+        }
+        tick_budget = budget;
+        target_date = date;
+        cancelled = false;
+        tick_requested = true;
+        ticking = true;
+    }
+    tick_condition.notify_one();
+    return true;
+}
+
+void SimulationThread::Cancel() {
+    {
+        // Set under the handoff lock, so that the simulation thread can't miss it while waiting for a handoff
+        std::lock_guard<std::mutex> lock(handoff_mutex);
+        cancelled = true;
+    }
+    handoff_condition.notify_all();
+}
+
+void SimulationThread::WaitForTick() {
+    std::unique_lock<std::mutex> lock(tick_mutex);
+    done_condition.wait(lock, [this] { return !ticking; });
+}
+
+std::unique_lock<std::mutex> SimulationThread::TryLockUniverse() {
+    std::unique_lock<std::mutex> lock(universe_mutex, std::try_to_lock);
+    if (lock.owns_lock()) {
+        OnUniverseLocked();
+    } else {
+        std::lock_guard<std::mutex> handoff_lock(handoff_mutex);
+        lock_wanted = true;
+    }
+    return lock;
+}
+
+std::unique_lock<std::mutex> SimulationThread::LockUniverse() {
+    {
+        std::lock_guard<std::mutex> handoff_lock(handoff_mutex);
+        lock_wanted = true;
+    }
+    std::unique_lock<std::mutex> lock(universe_mutex);
+    OnUniverseLocked();
+    return lock;
+}
+
+bool SimulationThread::IsLockWanted() {
+    std::lock_guard<std::mutex> lock(handoff_mutex);
+    return lock_wanted;
+}
+
+void SimulationThread::OnUniverseLocked() {
+    {
+        std::lock_guard<std::mutex> lock(handoff_mutex);
+        lock_wanted = false;
+    }
+    handoff_condition.notify_all();
+}
+
+std::shared_ptr<const UniverseSnapshot> SimulationThread::GetSnapshot() const {
+    std::lock_guard<std::mutex> lock(snapshot_mutex);
+    return snapshot;
+}
+
+void SimulationThread::PublishSnapshot() {
+    auto next = TakeSnapshot(universe);
+    std::lock_guard<std::mutex> lock(snapshot_mutex);
+    snapshot = std::move(next);
+}
+
+void SimulationThread::Run() {
+    tracy::SetThreadName("Simulation");
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(tick_mutex);
+            tick_condition.wait(lock, [this] { return tick_requested || stopping; });
+            if (stopping) {
+                return;
+            }
+            tick_requested = false;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        int ticks = 0;
+        bool done = false;
+        while (!done) {
+            std::shared_ptr<const UniverseSnapshot> next;
+            {
+                // Run ticks in batches, so that the snapshot is updated and the universe is unlocked every now
+                // and then if a lot of ticks are run
+                std::lock_guard<std::mutex> lock(universe_mutex);
+                auto batch_start = std::chrono::steady_clock::now();
+                while (!(done = IsRequestDone(start, ticks)) &&
+                       std::chrono::steady_clock::now() - batch_start < snapshot_interval) {
+                    simulation.tick();
+                    ticks++;
+                }
+                next = TakeSnapshot(universe);
+            }
+            {
+                std::lock_guard<std::mutex> lock(snapshot_mutex);
+                snapshot = std::move(next);
+            }
+            if (!done) {
+                // Let the thread that wants the universe take it before the next batch. This is bounded by the
+                // snapshot interval, so that the ticks keep going if that thread stops asking for it
+                std::unique_lock<std::mutex> lock(handoff_mutex);
+                handoff_condition.wait_for(lock, snapshot_interval, [this] { return !lock_wanted || cancelled; });
+                lock_wanted = false;
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(tick_mutex);
+            target_date = -1;
+            ticking = false;
+        }
+        done_condition.notify_all();
+    }
+}
+
+bool SimulationThread::IsRequestDone(std::chrono::steady_clock::time_point start, int ticks) {
+    if (cancelled) {
+        return true;
+    }
+    if (target_date >= 0) {
+        // Checked before the first tick too, so nothing is run if the date is already reached
+        return universe.date.GetDate() >= target_date;
+    }
+    // Requests without a target date run at least one tick
+    return ticks > 0 && std::chrono::steady_clock::now() - start >= tick_budget;
+}
+}  // namespace cqsp::common::systems::simulation
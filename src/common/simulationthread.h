@@ -0,0 +1,155 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "common/simulation.h"
+#include "common/universe.h"
+#include "common/universesnapshot.h"
+
+namespace cqsp {
+namespace common {
+namespace systems {
+namespace simulation {
+/// <summary>
+/// Runs the ticks of a simulation on a separate thread, so that a slow tick doesn't hold up the caller.
+/// </summary>
+/// The universe is locked while a tick is running. Other threads have to hold the lock from
+/// `TryLockUniverse` or `LockUniverse` to read or write components that the simulation writes to.
+/// At the end of every tick, a `UniverseSnapshot` is published, which can be read without the lock.
+class SimulationThread {
+ public:
+    SimulationThread(Simulation& simulation, Universe& universe);
+    ~SimulationThread();
+
+    /// <summary>
+    /// Starts a tick on the simulation thread.
+    /// </summary>
+    /// <returns>false if the previous tick has not completed yet, and no tick was started</returns>
+    bool RequestTick();
+
+    /// <summary>
+    /// Runs as many ticks as fit in the time budget on the simulation thread. At least one tick is run.
+    /// </summary>
+    /// <returns>false if the previous ticks have not completed yet, and no tick was started</returns>
+    bool RequestTicks(std::chrono::microseconds budget);
+
+    /// <summary>
+    /// Runs ticks on the simulation thread until the date is reached, or until `Cancel` is called.
+    /// A snapshot is published, and the universe is unlocked, every `snapshot_interval` while running.
+    /// </summary>
+    /// <returns>false if the previous ticks have not completed yet, and no tick was started</returns>
+    bool RequestTicksUntil(int date);
+
+    /// <summary>
+    /// Stops running ticks after the tick that is running completes.
+    /// </summary>
+    void Cancel();
+
+    /// <summary>
+    /// If the ticks are running until a date, through `RequestTicksUntil`.
+    /// </summary>
+    bool IsRunningUntil() const { return ticking && target_date >= 0; }
+
+    /// <summary>
+    /// How often the snapshot is published when running a lot of ticks.
+    /// </summary>
+    std::chrono::microseconds snapshot_interval = std::chrono::milliseconds(16);
+
+    /// <summary>
+    /// If a tick is requested or is running.
+    /// </summary>
+    bool IsTicking() const { return ticking; }
+
+    /// <summary>
+    /// Waits until the tick that is running completes.
+    /// </summary>
+    void WaitForTick();
+
+    /// <summary>
+    /// Locks the universe if there is no tick running. Check if the lock is owned before using it.
+    /// If the lock isn't taken, the simulation thread waits for the next call between two batches of ticks.
+    /// </summary>
+    std::unique_lock<std::mutex> TryLockUniverse();
+
+    /// <summary>
+    /// Locks the universe, waiting for the tick that is running to complete.
+    /// </summary>
+    std::unique_lock<std::mutex> LockUniverse();
+
+    /// <summary>
+    /// If another thread failed to lock the universe, so the simulation thread waits for it to take the lock
+    /// after the batch of ticks that is running.
+    /// </summary>
+    bool IsLockWanted();
+
+    /// <summary>
+    /// The snapshot taken at the end of the last tick.
+    /// </summary>
+    std::shared_ptr<const UniverseSnapshot> GetSnapshot() const;
+
+    /// <summary>
+    /// Takes a new snapshot after the universe was changed outside of a tick, so that the change is
+    /// seen before the next tick. The caller has to hold the universe lock.
+    /// </summary>
+    void PublishSnapshot();
+
+ private:
+    bool Request(std::chrono::microseconds budget, int date);
+    void Run();
+    bool IsRequestDone(std::chrono::steady_clock::time_point start, int ticks);
+    void OnUniverseLocked();
+
+    Simulation& simulation;
+    Universe& universe;
+
+    std::mutex universe_mutex;
+
+    mutable std::mutex snapshot_mutex;
+    std::shared_ptr<const UniverseSnapshot> snapshot;
+
+    std::mutex tick_mutex;
+    std::condition_variable tick_condition;
+    std::condition_variable done_condition;
+    bool tick_requested = false;
+    bool stopping = false;
+    std::atomic<bool> ticking = false;
+    std::atomic<bool> cancelled = false;
+
+    // Set when another thread failed to lock the universe, so that the simulation thread waits for it
+    // between batches. The mutex isn't fair, so it would be locked again by the simulation thread straight away
+    std::mutex handoff_mutex;
+    std::condition_variable handoff_condition;
+    bool lock_wanted = false;
+
+    // The request that is running. A budget of zero runs a single tick, and a target date of -1
+    // means that there is no target date
+    std::chrono::microseconds tick_budget {0};
+    std::atomic<int> target_date = -1;
+
+    std::thread thread;
+};
+}  // namespace simulation
+}  // namespace systems
+}  // namespace common
+}  // namespace cqsp
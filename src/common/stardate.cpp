@@ -30,23 +30,23 @@ auto GetDateObject(int start_date, int day) {
     return date;
 }
 }  // namespace
-std::string StarDate::ToString() {
+std::string StarDate::ToString() const {
     // Parse the date
     auto date = GetDateObject(start_date, (int)ToDay());
     return fmt::format("{}-{}-{}", (int) date.year(), (unsigned int) date.month(), (unsigned int) date.day());
 }
 
-int StarDate::GetYear() {
+int StarDate::GetYear() const {
     auto date = GetDateObject(start_date, (int)ToDay());
     return (int) date.year();
 }
 
-int StarDate::GetMonth() {
+int StarDate::GetMonth() const {
     auto date = GetDateObject(start_date, (int)ToDay());
     return (unsigned int) date.month();
 }
 
-int StarDate::GetDay() {
+int StarDate::GetDay() const {
     auto date = GetDateObject(start_date, (int)ToDay());
     return (unsigned int) date.day();
 }
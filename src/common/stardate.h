@@ -46,16 +46,16 @@ class StarDate {
  public:
     void IncrementDate() { date++; }
 
-    int GetDate() { return date; }
+    int GetDate() const { return date; }
 
-    double ToSecond() { return date * 3600.f; }
-    double ToDay() { return date/24.f; }
+    double ToSecond() const { return date * 3600.f; }
+    double ToDay() const { return date/24.f; }
 
-    std::string ToString();
+    std::string ToString() const;
 
-    int GetYear();
-    int GetMonth();
-    int GetDay();
+    int GetYear() const;
+    int GetMonth() const;
+    int GetDay() const;
 
  private:
     // The maximum length will be about a hundred and thirty thousand years.
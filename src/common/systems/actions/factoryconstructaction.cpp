@@ -66,16 +66,15 @@ entt::entity cqsp::common::systems::actions::CreateFactory(Universe& universe, e
 }
 
 cqsp::common::components::ResourceLedger
-cqsp::common::systems::actions::GetFactoryCost(cqsp::common::Universe& universe, entt::entity city,
+cqsp::common::systems::actions::GetFactoryCost(const entt::registry& universe, entt::entity city,
     entt::entity recipe, int capacity) {
-    cqsp::common::components::ResourceLedger ledger;
     // Get the recipe and things
-    if (universe.any_of<components::RecipeCost>(recipe)) {
-        auto& cost = universe.get<components::RecipeCost>(recipe);
-        ledger.MultiplyAdd(cost.scaling, capacity);
-        ledger += cost.fixed;
+    if (!universe.any_of<components::RecipeCost>(recipe)) {
+        return cqsp::common::components::ResourceLedger();
     }
-    return ledger;
+    auto& cost = universe.get<components::RecipeCost>(recipe);
+    // Evaluated in one pass over both ledgers
+    return cost.scaling * capacity + cost.fixed;
 }
 
 entt::entity cqsp::common::systems::actions::CreateMine(cqsp::common::Universe& universe,
@@ -102,7 +101,7 @@ entt::entity cqsp::common::systems::actions::CreateMine(cqsp::common::Universe&
 }
 
 cqsp::common::components::ResourceLedger
-cqsp::common::systems::actions::GetMineCost(cqsp::common::Universe& universe, entt::entity city,
+cqsp::common::systems::actions::GetMineCost(const entt::registry& universe, entt::entity city,
     entt::entity good, int amount) {
     return cqsp::common::components::ResourceLedger();
 }
@@ -49,13 +49,16 @@ entt::entity OrderConstructionFactory(cqsp::common::Universe& universe, entt::en
 entt::entity CreateFactory(cqsp::common::Universe& universe, entt::entity city,
                             entt::entity recipe, int productivity);
 
-cqsp::common::components::ResourceLedger GetFactoryCost(cqsp::common::Universe& universe,
+/// <summary>
+/// The resources needed to build the factory. Only reads the recipe, so the universe snapshot can be passed.
+/// </summary>
+cqsp::common::components::ResourceLedger GetFactoryCost(const entt::registry& universe,
                             entt::entity city, entt::entity recipe, int productivity);
 
 entt::entity CreateMine(cqsp::common::Universe& universe,
                         entt::entity city, entt::entity good, int amount, float productivity);
 
-cqsp::common::components::ResourceLedger GetMineCost(cqsp::common::Universe& universe,
+cqsp::common::components::ResourceLedger GetMineCost(const entt::registry& universe,
                         entt::entity city, entt::entity good, int amount);
 
 entt::entity CreateCommercialArea(cqsp::common::Universe& universe, entt::entity city);
@@ -0,0 +1,246 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "common/systems/checksum.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#include "common/components/coordinates.h"
+#include "common/components/economy.h"
+#include "common/components/population.h"
+#include "common/components/resource.h"
+
+namespace cqsp::common::systems::checksum {
+namespace {
+/// <summary>
+/// 64 bit FNV-1a hash, fed byte by byte so that the hash is the same on every platform.
+/// </summary>
+class Hasher {
+ public:
+    void AddInt(uint64_t value) {
+        for (int i = 0; i < 8; i++) {
+            hash ^= (value >> (i * 8)) & 0xff;
+            hash *= prime;
+        }
+    }
+
+    void AddDouble(double value) {
+        // Negative zero and the different NaNs have to hash the same
+        if (value == 0) {
+            value = 0;
+        } else if (std::isnan(value)) {
+            value = std::numeric_limits<double>::quiet_NaN();
+        }
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        AddInt(bits);
+    }
+
+    void AddVector(const glm::dvec3& vec) {
+        AddDouble(vec.x);
+        AddDouble(vec.y);
+        AddDouble(vec.z);
+    }
+
+    void AddEntity(entt::entity entity) { AddInt(static_cast<uint64_t>(entt::to_integral(entity))); }
+
+    template <typename Ledger>
+    void AddLedger(const Ledger& ledger) {
+        // The ledger is sorted by good or by the good index, so the order is always the same
+        for (const auto& [good, amount] : ledger) {
+            AddEntity(good);
+            AddDouble(amount);
+        }
+    }
+
+    uint64_t Get() const { return hash; }
+
+ private:
+    static const uint64_t prime = 0x100000001b3;
+    uint64_t hash = 0xcbf29ce484222325;
+};
+
+template <typename Component>
+std::vector<entt::entity> GetSortedEntities(Universe& universe) {
+    auto view = universe.view<Component>();
+    std::vector<entt::entity> entities(view.begin(), view.end());
+    std::sort(entities.begin(), entities.end());
+    return entities;
+}
+}  // namespace
+
+std::string_view ToString(ChecksumComponent component) {
+    switch (component) {
+        case ChecksumComponent::Wallet:
+            return "Wallet";
+        case ChecksumComponent::Market:
+            return "Market";
+        case ChecksumComponent::Stockpile:
+            return "Stockpile";
+        case ChecksumComponent::Orbit:
+            return "Orbit";
+        case ChecksumComponent::Kinematics:
+            return "Kinematics";
+        case ChecksumComponent::Population:
+            return "Population";
+        default:
+            return "Unknown";
+    }
+}
+
+TickChecksum ComputeChecksum(Universe& universe) {
+    namespace cqspc = cqsp::common::components;
+    namespace cqspt = cqsp::common::components::types;
+    TickChecksum checksum;
+    checksum.date = universe.date.GetDate();
+
+    Hasher wallet;
+    for (entt::entity entity : GetSortedEntities<cqspc::Wallet>(universe)) {
+        wallet.AddEntity(entity);
+        wallet.AddDouble(universe.get<cqspc::Wallet>(entity).GetBalance());
+    }
+    checksum[ChecksumComponent::Wallet] = wallet.Get();
+
+    Hasher market;
+    for (entt::entity entity : GetSortedEntities<cqspc::Market>(universe)) {
+        market.AddEntity(entity);
+        const auto& market_comp = universe.get<cqspc::Market>(entity);
+        for (entt::entity good : market_comp.GetGoods()) {
+            market.AddEntity(good);
+            market.AddDouble(market_comp.GetPrice(good));
+        }
+    }
+    checksum[ChecksumComponent::Market] = market.Get();
+
+    Hasher stockpile;
+    for (entt::entity entity : GetSortedEntities<cqspc::ResourceStockpile>(universe)) {
+        stockpile.AddEntity(entity);
+        stockpile.AddLedger(universe.get<cqspc::ResourceStockpile>(entity));
+    }
+    checksum[ChecksumComponent::Stockpile] = stockpile.Get();
+
+    Hasher orbit;
+    for (entt::entity entity : GetSortedEntities<cqspt::Orbit>(universe)) {
+        auto& orb = universe.get<cqspt::Orbit>(entity);
+        orbit.AddEntity(entity);
+        orbit.AddDouble(orb.semi_major_axis);
+        orbit.AddDouble(orb.eccentricity);
+        orbit.AddDouble(orb.inclination);
+        orbit.AddDouble(orb.LAN);
+        orbit.AddDouble(orb.w);
+        orbit.AddDouble(orb.M0);
+        orbit.AddDouble(orb.v);
+        orbit.AddDouble(orb.E);
+        orbit.AddEntity(orb.reference_body);
+    }
+    checksum[ChecksumComponent::Orbit] = orbit.Get();
+
+    Hasher kinematics;
+    for (entt::entity entity : GetSortedEntities<cqspt::Kinematics>(universe)) {
+        auto& kin = universe.get<cqspt::Kinematics>(entity);
+        kinematics.AddEntity(entity);
+        kinematics.AddVector(kin.position);
+        kinematics.AddVector(kin.velocity);
+        kinematics.AddVector(kin.center);
+    }
+    checksum[ChecksumComponent::Kinematics] = kinematics.Get();
+
+    Hasher population;
+    for (entt::entity entity : GetSortedEntities<cqspc::PopulationSegment>(universe)) {
+        population.AddEntity(entity);
+        population.AddInt(universe.get<cqspc::PopulationSegment>(entity).population);
+    }
+    checksum[ChecksumComponent::Population] = population.Get();
+    return checksum;
+}
+
+void ChecksumStream::Write(std::ostream& stream) const {
+    stream << "cqsp-checksums 2\n";
+    stream << "seed " << seed << "\n";
+    stream << "amortize " << (amortize ? 1 : 0) << "\n";
+    stream << "ticks " << ticks.size() << "\n";
+    for (const TickChecksum& tick : ticks) {
+        std::string line = fmt::format("{}", tick.date);
+        for (uint64_t hash : tick.hashes) {
+            line += fmt::format(" {:016x}", hash);
+        }
+        stream << line << "\n";
+    }
+}
+
+bool ChecksumStream::Read(std::istream& stream) {
+    std::string token;
+    int version = 0;
+    // Version 2 has the seed, if the run was amortized, the number of ticks, and then the date and the hash of every
+    // component on every tick. Older versions don't say if the run was amortized, so they can't be verified
+    if (!(stream >> token >> version) || token != "cqsp-checksums" || version != 2) {
+        return false;
+    }
+    size_t count = 0;
+    if (!(stream >> token >> seed) || token != "seed") {
+        return false;
+    }
+    int amortized = 0;
+    if (!(stream >> token >> amortized) || token != "amortize") {
+        return false;
+    }
+    amortize = amortized != 0;
+    if (!(stream >> token >> count) || token != "ticks") {
+        return false;
+    }
+    ticks.clear();
+    ticks.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        TickChecksum tick;
+        if (!(stream >> std::dec >> tick.date)) {
+            return false;
+        }
+        for (uint64_t& hash : tick.hashes) {
+            if (!(stream >> std::hex >> hash)) {
+                return false;
+            }
+        }
+        ticks.push_back(tick);
+    }
+    stream >> std::dec;
+    return true;
+}
+
+bool ChecksumVerifier::Verify(Universe& universe) {
+    if (divergence.has_value()) {
+        return false;
+    }
+    if (IsComplete()) {
+        return true;
+    }
+    const TickChecksum& recorded = expected.ticks[current_tick];
+    TickChecksum actual = ComputeChecksum(universe);
+    for (int i = 0; i < checksum_component_count; i++) {
+        if (actual.hashes[i] != recorded.hashes[i]) {
+            divergence = Divergence {static_cast<int>(current_tick), actual.date, static_cast<ChecksumComponent>(i)};
+            return false;
+        }
+    }
+    current_tick++;
+    return true;
+}
+}  // namespace cqsp::common::systems::checksum
@@ -0,0 +1,124 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include "common/universe.h"
+
+namespace cqsp {
+namespace common {
+namespace systems {
+namespace checksum {
+/// <summary>
+/// The parts of the simulation state that are hashed separately, so that a divergence can be
+/// traced to the component that caused it.
+/// </summary>
+enum class ChecksumComponent {
+    Wallet,
+    Market,
+    Stockpile,
+    Orbit,
+    Kinematics,
+    Population,
+    Count
+};
+
+constexpr int checksum_component_count = static_cast<int>(ChecksumComponent::Count);
+
+std::string_view ToString(ChecksumComponent component);
+
+/// <summary>
+/// Hash of the simulation state at the end of a tick.
+/// </summary>
+struct TickChecksum {
+    int date = 0;
+    std::array<uint64_t, checksum_component_count> hashes {};
+
+    uint64_t& operator[](ChecksumComponent component) { return hashes[static_cast<int>(component)]; }
+    uint64_t operator[](ChecksumComponent component) const { return hashes[static_cast<int>(component)]; }
+};
+
+/// <summary>
+/// Hashes the wallet balances, market prices, stockpiles, orbits, kinematics and population of the universe.
+/// </summary>
+/// Entities are hashed in order of their ids, so the hash doesn't depend on the order components
+/// were added in. The same state always has the same hash, regardless of platform.
+TickChecksum ComputeChecksum(Universe& universe);
+
+/// <summary>
+/// Hashes of every tick of a run with a seed.
+/// </summary>
+/// The settings that change the result of a run are recorded too, so that a run can only be verified
+/// against a run with the same settings.
+struct ChecksumStream {
+    int seed = Universe::default_seed;
+    /// If the systems that run every n ticks were spread over every tick, see `Simulation::SetAmortized`
+    bool amortize = false;
+    std::vector<TickChecksum> ticks;
+
+    void Record(Universe& universe) { ticks.push_back(ComputeChecksum(universe)); }
+
+    void Write(std::ostream& stream) const;
+    /// <returns>false if the stream is not a checksum stream</returns>
+    bool Read(std::istream& stream);
+};
+
+/// <summary>
+/// The first tick where the hashes of two runs are different.
+/// </summary>
+struct Divergence {
+    int tick = 0;
+    int date = 0;
+    ChecksumComponent component = ChecksumComponent::Count;
+};
+
+/// <summary>
+/// Compares the hashes of a run against a recorded run, tick by tick.
+/// </summary>
+class ChecksumVerifier {
+ public:
+    explicit ChecksumVerifier(const ChecksumStream& expected) : expected(expected) {}
+
+    /// <summary>
+    /// Compares the current state of the universe to the next recorded tick.
+    /// </summary>
+    /// <returns>false if the state has diverged, either now or on an earlier tick</returns>
+    bool Verify(Universe& universe);
+
+    /// <summary>
+    /// If all the recorded ticks have been compared.
+    /// </summary>
+    bool IsComplete() const { return current_tick >= expected.ticks.size(); }
+
+    const std::optional<Divergence>& GetDivergence() const { return divergence; }
+
+ private:
+    const ChecksumStream& expected;
+    size_t current_tick = 0;
+    std::optional<Divergence> divergence;
+};
+}  // namespace checksum
+}  // namespace systems
+}  // namespace common
+}  // namespace cqsp
@@ -0,0 +1,105 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <set>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+namespace cqsp {
+namespace common {
+namespace systems {
+/// <summary>
+/// The set of components a simulation system reads and writes when it runs.
+/// </summary>
+/// The simulation scheduler uses this to figure out which systems can run at the same time.
+/// Two systems conflict if one of them writes a component that the other reads or writes,
+/// and conflicting systems are always run in the order they were added to the simulation.
+///
+/// A system that does not know what it touches (such as the script runner) should be marked
+/// exclusive, so that it never runs alongside any other system.
+class ComponentAccess {
+ public:
+    template<typename... Components>
+    ComponentAccess& Read() {
+        (Add<Components>(reads), ...);
+        return *this;
+    }
+
+    template<typename... Components>
+    ComponentAccess& Write() {
+        (Add<Components>(writes), ...);
+        return *this;
+    }
+
+    ComponentAccess& Exclusive() {
+        exclusive = true;
+        return *this;
+    }
+
+    bool IsExclusive() const { return exclusive; }
+
+    /// <summary>
+    /// If running the two systems at the same time would race on a component.
+    /// </summary>
+    bool ConflictsWith(const ComponentAccess& other) const {
+        if (exclusive || other.exclusive) {
+            return true;
+        }
+        for (entt::id_type id : writes) {
+            if (other.writes.count(id) > 0 || other.reads.count(id) > 0) {
+                return true;
+            }
+        }
+        for (entt::id_type id : reads) {
+            if (other.writes.count(id) > 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /// <summary>
+    /// Creates the storage of every declared component.
+    /// </summary>
+    /// entt creates component pools lazily, which modifies the registry itself, so that has
+    /// to be done before any systems are run in parallel.
+    void AssureStorage(entt::registry& registry) const {
+        for (auto& assure : storage_functions) {
+            assure(registry);
+        }
+    }
+
+    const std::set<entt::id_type>& GetReads() const { return reads; }
+    const std::set<entt::id_type>& GetWrites() const { return writes; }
+
+ private:
+    template<typename Component>
+    void Add(std::set<entt::id_type>& set) {
+        set.insert(entt::type_hash<Component>::value());
+        storage_functions.push_back([](entt::registry& registry) { registry.storage<Component>(); });
+    }
+
+    bool exclusive = false;
+    std::set<entt::id_type> reads;
+    std::set<entt::id_type> writes;
+    std::vector<void (*)(entt::registry&)> storage_functions;
+};
+}  // namespace systems
+}  // namespace common
+}  // namespace cqsp
@@ -18,48 +18,24 @@
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "common/util/threadpool.h"
+
 bool cqsp::common::systems::BuyGood(components::AuctionHouse& auction_house,
                                     entt::entity agent, entt::entity good,
                                     double price, double quantity) {
-    // The orders we want to try and fufill
-    auto& sell_order_list = auction_house.sell_orders[good];
-    auto& buy_order_list = auction_house.buy_orders[good];
-
-    // Check if goods are being sold
-    if (sell_order_list.empty()) {
-        // Then make new buy order
-        components::Order order(price, quantity, agent);
-        buy_order_list.put(order);
-        return false;
-    }
-    // Then pop the first in the list, and check if the price works
-    while (!sell_order_list.empty()) {
-        components::Order& first = sell_order_list.front();
-        // Then check if the price is right
-        if (first.price > price) {
-            break;
-        }
-        // Buy good, and fufill demand
-        if (first.quantity > quantity) {
-            first.quantity -= quantity;
-            quantity = 0;
-            // Also subtract wallet
-            // Thing done!
-            return true;
-        } else {
-            // remove order, remove quantity
-            quantity -= first.quantity;
-            // Remove buy order
-            sell_order_list.erase(sell_order_list.begin());
-        }
-    }
-
-    if (quantity <= 0) {
+    // Buy from the cheapest sell orders that are at most the price
+    double remaining = auction_house.sell_orders[good].Fill(quantity, [price](double ask) { return ask <= price; });
+    if (remaining <= 0) {
         return true;
     }
     // Then place a buy order because the order could not be fufulled.
-    components::Order order(price, quantity, agent);
-    buy_order_list.put(order);
+    auction_house.buy_orders[good].put(components::Order(price, remaining, agent));
     return false;
 }
 
@@ -67,49 +43,131 @@ bool cqsp::common::systems::SellGood(components::AuctionHouse& auction_house,
                                      entt::entity agent,
                                      entt::entity good, double price,
                                      double quantity) {
-    // The place we will put our order if we cannot fufill it
-    auto& sell_order_list = auction_house.sell_orders[good];
+    // Sell to the most expensive buy orders that are at least the price
+    double remaining = auction_house.buy_orders[good].Fill(quantity, [price](double bid) { return bid >= price; });
+    if (remaining <= 0) {
+        return true;
+    }
+    // Then place a sell order because the order could not be fufulled.
+    auction_house.sell_orders[good].put(components::Order(price, remaining, agent));
+    return false;
+}
+
+namespace {
+namespace cqspc = cqsp::common::components;
 
-    // The orders we want to try and fufill
-    auto& buy_order_list = auction_house.buy_orders[good];
+// Fills the orders, which are sorted best price first, up to the volume. The first `eligible` orders are the ones
+// that are at the clearing price or better.
+void Allocate(const std::vector<cqspc::Order>& orders, size_t eligible, double volume,
+              std::vector<cqspc::OrderFill>& fills) {
+    size_t level_start = 0;
+    while (level_start < eligible && volume > 0) {
+        size_t level_end = level_start;
+        double level_quantity = 0;
+        while (level_end < eligible && orders[level_end].price == orders[level_start].price) {
+            level_quantity += orders[level_end].quantity;
+            level_end++;
+        }
+        // Every order of the last level gets the same share of what is left
+        double fraction = level_quantity <= volume ? 1 : volume / level_quantity;
+        for (size_t i = level_start; i < level_end; i++) {
+            fills.push_back({orders[i].agent, orders[i].quantity * fraction});
+        }
+        volume -= level_quantity * fraction;
+        level_start = level_end;
+    }
+}
+}  // namespace
 
-    // Check if goods are being sold
-    if (buy_order_list.empty()) {
-        // Then make new order
-        components::Order order(price, quantity, agent);
-        sell_order_list.put(order);
-        return false;
+cqspc::ClearingResult cqsp::common::systems::ClearCallAuction(components::CallOrders& orders) {
+    components::ClearingResult result;
+    std::vector<components::Order>& bids = orders.bids;
+    std::vector<components::Order>& asks = orders.asks;
+    // The agent and quantity break ties, so that orders are in the same order no matter how they were submitted
+    std::sort(bids.begin(), bids.end(), [](const components::Order& a, const components::Order& b) {
+        return std::tie(b.price, a.agent, a.quantity) < std::tie(a.price, b.agent, b.quantity);
+    });
+    std::sort(asks.begin(), asks.end(), [](const components::Order& a, const components::Order& b) {
+        return std::tie(a.price, a.agent, a.quantity) < std::tie(b.price, b.agent, b.quantity);
+    });
+    if (bids.empty() || asks.empty()) {
+        return result;
     }
-    // Then pop the first in the list, and check if the price works
-    while (!buy_order_list.empty()) {
-        components::Order& first = buy_order_list.front();
-        // Then check if the price is right
-        if (first.price < price) {
-            break;
+
+    // The supply and demand curves, at every price that there is an order at
+    std::vector<double> prices;
+    prices.reserve(bids.size() + asks.size());
+    for (const auto* side : {&bids, &asks}) {
+        for (const components::Order& order : *side) {
+            prices.push_back(order.price);
         }
-        // Buy good, and fufill demand
-        if (first.quantity > quantity) {
-            first.quantity -= quantity;
-            quantity = 0;
-            // Also subtract wallet
-            // Thing done!
-            return true;
-        } else {
-            // remove order, remove quantity
-            quantity -= first.quantity;
-            // Remove buy order
-            buy_order_list.erase(buy_order_list.begin());
-            if (quantity == 0) {
-                break;
-            }
+    }
+    std::sort(prices.begin(), prices.end());
+    prices.erase(std::unique(prices.begin(), prices.end()), prices.end());
+
+    std::vector<double> supply(prices.size());
+    double total = 0;
+    size_t ask = 0;
+    for (size_t i = 0; i < prices.size(); i++) {
+        for (; ask < asks.size() && asks[ask].price <= prices[i]; ask++) {
+            total += asks[ask].quantity;
+        }
+        supply[i] = total;
+    }
+    std::vector<double> demand(prices.size());
+    total = 0;
+    size_t bid = 0;
+    for (size_t i = prices.size(); i-- > 0;) {
+        for (; bid < bids.size() && bids[bid].price >= prices[i]; bid++) {
+            total += bids[bid].quantity;
         }
+        demand[i] = total;
     }
 
-    if (quantity <= 0) {
-        return true;
+    // The price that trades the most, and then leaves the least unfilled
+    size_t best = 0;
+    for (size_t i = 1; i < prices.size(); i++) {
+        double volume = std::min(demand[i], supply[i]);
+        double best_volume = std::min(demand[best], supply[best]);
+        if (volume > best_volume ||
+            (volume == best_volume && std::abs(demand[i] - supply[i]) < std::abs(demand[best] - supply[best]))) {
+            best = i;
+        }
     }
-    // Then place a sell order because the order could not be fufulled.
-    components::Order order(price, quantity, agent);
-    sell_order_list.put(order);
-    return false;
+    result.volume = std::min(demand[best], supply[best]);
+    if (result.volume <= 0) {
+        return result;
+    }
+    // The curves are flat until the next price that has the same supply and demand, so any price between them
+    // fills the same orders, and the middle is fair to both sides
+    size_t last = best;
+    while (last + 1 < prices.size() && demand[last + 1] == demand[best] && supply[last + 1] == supply[best]) {
+        last++;
+    }
+    result.price = (prices[best] + prices[last]) / 2;
+
+    size_t eligible_bids = 0;
+    while (eligible_bids < bids.size() && bids[eligible_bids].price >= result.price) {
+        eligible_bids++;
+    }
+    size_t eligible_asks = 0;
+    while (eligible_asks < asks.size() && asks[eligible_asks].price <= result.price) {
+        eligible_asks++;
+    }
+    Allocate(bids, eligible_bids, result.volume, result.bought);
+    Allocate(asks, eligible_asks, result.volume, result.sold);
+    return result;
+}
+
+void cqsp::common::systems::ClearCallAuctions(components::AuctionHouse& auction_house, util::ThreadPool* pool) {
+    auction_house.clearing_results.clear();
+    // Every good has its own orders and result, so they can be cleared at the same time
+    std::vector<std::pair<components::CallOrders*, components::ClearingResult*>> goods;
+    for (auto& [good, orders] : auction_house.call_orders) {
+        goods.emplace_back(&orders, &auction_house.clearing_results[good]);
+    }
+    util::ParallelFor(pool, static_cast<int>(goods.size()), [&goods](int i) {
+        *goods[i].second = ClearCallAuction(*goods[i].first);
+    });
+    auction_house.call_orders.clear();
 }
@@ -22,6 +22,10 @@
 
 namespace cqsp {
 namespace common {
+namespace util {
+class ThreadPool;
+}  // namespace util
+
 namespace systems {
 /// <summary>
 /// Buys a good from the market
@@ -46,6 +50,22 @@ bool BuyGood(components::AuctionHouse& auction_house, entt::entity good,
 /// placed.</returns>
 bool SellGood(components::AuctionHouse& auction_house, entt::entity good,
               entt::entity agent, double price, double quantity);
+
+/// <summary>
+/// Clears the orders for a good at the single price that trades the most. Bids at or above the price and asks at or
+/// below it are filled, best price first. The orders at the last price that is filled on the side that has more are
+/// all filled by the same fraction.
+/// </summary>
+/// The orders are sorted by price, agent and quantity first, so the result doesn't depend on the order that they
+/// were submitted in.
+components::ClearingResult ClearCallAuction(components::CallOrders& orders);
+
+/// <summary>
+/// Clears the call auction of every good in the auction house into `clearing_results`, and removes the orders.
+/// Unfilled orders don't carry over.
+/// </summary>
+/// <param name="pool">If not null, the goods are cleared in parallel on the pool.</param>
+void ClearCallAuctions(components::AuctionHouse& auction_house, util::ThreadPool* pool = nullptr);
 }  // namespace systems
 }  // namespace common
 }  // namespace cqsp
@@ -0,0 +1,63 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <entt/entt.hpp>
+
+#include "common/components/area.h"
+#include "common/components/economy.h"
+#include "common/components/population.h"
+#include "common/components/resource.h"
+
+namespace cqsp {
+namespace common {
+namespace systems {
+namespace economy {
+/// <summary>
+/// The population segments that trade on a market.
+/// </summary>
+/// The groups in this file own their first components, so entt keeps the owned components of the entities in
+/// the group packed at the front of their storage, in the same order. Iterating over a group walks those arrays
+/// in lockstep, instead of looking up every component in a sparse set.
+///
+/// Owned storages are reordered whenever an entity joins or leaves a group, so a system that adds or removes
+/// any of the components of a group must declare a write on the owned components, and no entity may join or
+/// leave a group while it is being iterated over.
+inline auto ConsumerGroup(entt::registry& registry) {
+    return registry.group<components::PopulationSegment>(entt::get<components::MarketAgent>);
+}
+
+/// <summary>
+/// The market agents that generate raw resources, such as mines and farms.
+/// </summary>
+inline auto MineGroup(entt::registry& registry) {
+    return registry.group<components::ResourceGenerator, components::RawResourceGen>(
+        entt::get<components::MarketAgent>);
+}
+
+/// <summary>
+/// Creates the economy groups, which should be done before the universe is populated, because creating a group
+/// sorts the storages that it owns.
+/// </summary>
+inline void RegisterEconomyGroups(entt::registry& registry) {
+    ConsumerGroup(registry);
+    MineGroup(registry);
+}
+}  // namespace economy
+}  // namespace systems
+}  // namespace common
+}  // namespace cqsp
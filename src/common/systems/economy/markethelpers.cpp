@@ -30,8 +30,8 @@ void cqsp::common::systems::economy::AddParticipant(
 }
 
 double cqsp::common::systems::economy::GetCost(
-    cqsp::common::Universe& universe, entt::entity market,
-    components::ResourceLedger ledger) {
+    const entt::registry& universe, entt::entity market,
+    const components::ResourceLedger& ledger) {
     if (!universe.any_of<components::Market>(market)) {
         return 0.0;
     }
@@ -50,9 +50,21 @@ void cqsp::common::systems::economy::CreateMarket(Universe& universe, entt::enti
     universe.get_or_emplace<components::MarketHistory>(market);
 }
 
-bool cqsp::common::systems::economy::PurchaseGood(
-    Universe& universe, entt::entity agent,
-    components::ResourceLedger purchase) {
+namespace {
+using cqsp::common::Universe;
+namespace components = cqsp::common::components;
+
+// Records a payment for every good in the ledger, at the price of the market, which is paid at the end of the tick
+template <typename Ledger>
+void RecordTrades(Universe& universe, const components::Market& market, entt::entity payer, entt::entity payee,
+                  const Ledger& ledger) {
+    for (const auto& [good, amount] : ledger) {
+        universe.journal.Record({payer, payee, market.GetPrice(good) * amount, good, amount});
+    }
+}
+
+template <typename Ledger>
+bool Purchase(Universe& universe, entt::entity agent, const Ledger& purchase) {
     // Calculating on how to buy from the market shouldn't be too hard, right?
     // Get the market connected to, and build the demand
     entt::entity market = universe.get<components::MarketAgent>(agent).market;
@@ -60,44 +72,67 @@ bool cqsp::common::systems::economy::PurchaseGood(
     // Prices
     double cost = market_comp.GetPrice(purchase);
 
-    // Then subtract the cash from the person, or something
     // Check if they have enough money and purchase, I guess
+    // Only money that was settled before this tick, and wasn't spent on earlier purchases this tick, can be spent
     auto& wallet = universe.get<components::Wallet>(agent);
+    double balance = wallet.GetBalance() - universe.journal.GetPendingDebit(agent);
 
     // TODO(EhWhoAmI):
     // Check if there are enough resources on the market, or else there will have a shortage
     // Then get the maximum resources that they allow
     // Just allow agents to take as many resources as they want because I'm too lazy to implement
     // limitations.
-    if (wallet.GetBalance() < cost) {
+    if (balance < cost) {
         return false;
     }
 
     // Then agent has enough money to buy
     market_comp.AddDemand(purchase);
+    market_comp.gdp += cost;
     if (universe.all_of<components::ResourceStockpile>(agent)) {
         universe.get<components::ResourceStockpile>(agent) += purchase;
     }
-    wallet -= cost;
+    RecordTrades(universe, market_comp, agent, market, purchase);
     return true;
 }
 
-bool cqsp::common::systems::economy::SellGood(Universe& universe, entt::entity agent,
-                                       components::ResourceLedger selling) {
+template <typename Ledger>
+bool Sell(Universe& universe, entt::entity agent, const Ledger& selling) {
     // Calculating on how to buy from the market shouldn't be too hard, right?
     // Get the market connected to, and build the demand
     entt::entity market = universe.get<components::MarketAgent>(agent).market;
     auto& market_comp = universe.get<components::Market>(market);
     auto& agent_stockpile = universe.get<components::ResourceStockpile>(agent);
     market_comp.AddSupply(selling);
+    for (const auto& [good, amount] : selling) {
+        market_comp.volume += amount;
+    }
 
     // Remove from stockpile
     agent_stockpile -= selling;
 
-    // Then subtract the cash from the person, or something
-    // Check if they have enough money and purchase, I guess
-    double cost = market_comp.GetPrice(selling);
-    components::Wallet& wallet = universe.get<components::Wallet>(agent);
-    wallet += cost;
+    // The agent is paid at the end of the tick
+    RecordTrades(universe, market_comp, market, agent, selling);
     return true;
 }
+}  // namespace
+
+bool cqsp::common::systems::economy::PurchaseGood(Universe& universe, entt::entity agent,
+                                                  const components::ResourceLedger& purchase) {
+    return Purchase(universe, agent, purchase);
+}
+
+bool cqsp::common::systems::economy::PurchaseGood(Universe& universe, entt::entity agent,
+                                                  const components::SmallLedger& purchase) {
+    return Purchase(universe, agent, purchase);
+}
+
+bool cqsp::common::systems::economy::SellGood(Universe& universe, entt::entity agent,
+                                              const components::ResourceLedger& selling) {
+    return Sell(universe, agent, selling);
+}
+
+bool cqsp::common::systems::economy::SellGood(Universe& universe, entt::entity agent,
+                                              const components::SmallLedger& selling) {
+    return Sell(universe, agent, selling);
+}
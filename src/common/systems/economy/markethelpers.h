@@ -35,20 +35,34 @@ void CreateMarket(Universe& universe, entt::entity market);
 /// If there aren't enough resources on the market, then we buy all the
 /// remaining resources on the market.
 /// You'll have to calculate how much you want later on
+///
+/// The payment is recorded in the journal of the universe, and only paid out of the wallet when the journal is
+/// settled at the end of the tick, so the agent can only spend money that it had at the start of the tick, minus
+/// what it already spent this tick.
 /// </summary>
 /// <param name="universe"></param>
 /// <param name="agent"></param>
 /// <param name="purchase"></param>
 /// <returns></returns>
 bool PurchaseGood(Universe& universe, entt::entity agent,
-                  components::ResourceLedger purchase);
+                  const components::ResourceLedger& purchase);
+bool PurchaseGood(Universe& universe, entt::entity agent,
+                  const components::SmallLedger& purchase);
+/// <summary>
+/// Sells the goods to the market. The agent is paid when the journal is settled at the end of the tick.
+/// </summary>
 bool SellGood(Universe& universe, entt::entity agent,
-              components::ResourceLedger selling);
+              const components::ResourceLedger& selling);
+bool SellGood(Universe& universe, entt::entity agent,
+              const components::SmallLedger& selling);
 
 void AddParticipant(cqsp::common::Universe& universe, entt::entity market, entt::entity entity);
 
-double GetCost(cqsp::common::Universe& universe, entt::entity market,
-               components::ResourceLedger ledger);
+/// <summary>
+/// The price of the ledger on the market. Only reads the market, so the universe snapshot can be passed.
+/// </summary>
+double GetCost(const entt::registry& universe, entt::entity market,
+               const components::ResourceLedger& ledger);
 }  // namespace economy
 }  // namespace systems
 }  // namespace common
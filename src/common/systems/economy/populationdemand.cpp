@@ -0,0 +1,41 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "common/systems/economy/populationdemand.h"
+
+#include <algorithm>
+
+namespace {
+// The columns don't overlap, which the compiler can't know on its own
+void ComputeDemand(int segments, const double* __restrict consumption, const double* __restrict threshold,
+                   const double* __restrict balance, const double* __restrict food_price,
+                   const double* __restrict good_price, double* __restrict food, double* __restrict good) {
+    for (int i = 0; i < segments; i++) {
+        // Buy the food they need, or if they can't afford it, all the food they can
+        const double food_cost = consumption[i] * food_price[i];
+        food[i] = std::min(consumption[i], balance[i] / food_price[i]);
+        // Then waste the rest on consumer goods, unless the price is too high and it isn't worth it
+        const double consumer_good = (balance[i] - food_cost) / good_price[i];
+        const bool buys = !(food_cost > balance[i]) & (consumer_good > threshold[i]);
+        good[i] = buys ? consumer_good : 0;
+    }
+}
+}  // namespace
+
+void cqsp::common::systems::economy::ComputePopulationDemand(const PopulationDemandColumns& columns) {
+    ComputeDemand(columns.segments, columns.consumption, columns.threshold, columns.balance, columns.food_price,
+                  columns.good_price, columns.food, columns.good);
+}
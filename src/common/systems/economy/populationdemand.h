@@ -0,0 +1,51 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+namespace cqsp {
+namespace common {
+namespace systems {
+namespace economy {
+/// <summary>
+/// The columns of the population segments that their demand is computed from, with an element for every segment.
+/// </summary>
+struct PopulationDemandColumns {
+    int segments = 0;
+    // The food that the segment needs
+    const double* consumption = nullptr;
+    // The least amount of consumer goods that is worth buying
+    const double* threshold = nullptr;
+    const double* balance = nullptr;
+    // The prices on the market of the segment
+    const double* food_price = nullptr;
+    const double* good_price = nullptr;
+
+    double* food = nullptr;
+    // 0 if the segment doesn't buy consumer goods
+    double* good = nullptr;
+};
+
+/// <summary>
+/// Computes how much food and consumer goods every segment buys. Segments buy the food they need, or as much as they
+/// can afford, and spend the rest of their money on consumer goods if they can buy more than the threshold.
+/// </summary>
+/// The loop has no branches, and none of the columns overlap, so the compiler vectorizes it.
+void ComputePopulationDemand(const PopulationDemandColumns& columns);
+}  // namespace economy
+}  // namespace systems
+}  // namespace common
+}  // namespace cqsp
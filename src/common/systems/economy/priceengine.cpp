@@ -0,0 +1,81 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "common/systems/economy/priceengine.h"
+
+#include <algorithm>
+
+using cqsp::common::systems::economy::FixedStepPriceEngine;
+using cqsp::common::systems::economy::PriceColumns;
+using cqsp::common::systems::economy::PriceEngine;
+using cqsp::common::systems::economy::SecantPriceEngine;
+using cqsp::common::systems::economy::TatonnementPriceEngine;
+
+// The loops are written without branches so that the compiler vectorizes them
+
+namespace {
+// How much more demand there is than supply, from -1 with only supply to 1 with only demand
+inline double RelativeExcess(double supply, double demand) {
+    const double total = supply + demand;
+    return total > 0 ? (demand - supply) / total : 0;
+}
+
+inline double TatonnementStep(double price, double supply, double demand, double damping) {
+    return std::max(price * (1 + damping * RelativeExcess(supply, demand)), PriceEngine::min_price);
+}
+}  // namespace
+
+void FixedStepPriceEngine::UpdatePrices(const PriceColumns& columns) const {
+    for (int i = 0; i < columns.goods; i++) {
+        const double price = columns.price[i];
+        const double supply = columns.supply[i];
+        const double demand = columns.demand[i];
+        // Our economy will be demand driven, so if there is too much demand the price goes up
+        const double increased = price + (0.001 + price * 0.1f);
+        const double decreased = std::max(price + (-0.001 + price * -0.1f), min_price);
+        // With no demand there is infinite supply, so the price goes down
+        const bool more_demand = demand > 0 && supply < demand;
+        const bool more_supply = demand <= 0 || supply > demand;
+        columns.next_price[i] = more_demand ? increased : (more_supply ? decreased : price);
+    }
+}
+
+void TatonnementPriceEngine::UpdatePrices(const PriceColumns& columns) const {
+    for (int i = 0; i < columns.goods; i++) {
+        columns.next_price[i] = TatonnementStep(columns.price[i], columns.supply[i], columns.demand[i], damping);
+    }
+}
+
+void SecantPriceEngine::UpdatePrices(const PriceColumns& columns) const {
+    for (int i = 0; i < columns.goods; i++) {
+        const double price = columns.price[i];
+        const double last_price = columns.last_price[i];
+        const double excess = columns.demand[i] - columns.supply[i];
+        const double last_excess = columns.last_demand[i] - columns.last_supply[i];
+        const bool last_traded = columns.last_supply[i] != 0 || columns.last_demand[i] != 0;
+
+        // Excess demand should go down as the price goes up, or there's no price that it would be zero at
+        const double price_change = price - last_price;
+        const double excess_change = excess - last_excess;
+        const bool usable = last_traded && price_change != 0 && excess_change * price_change < 0;
+        const double slope = usable ? excess_change / price_change : -1;
+        double secant = price - excess / slope;
+        secant = std::clamp(secant, price * (1 - max_step), price * (1 + max_step));
+
+        const double tatonnement = TatonnementStep(price, columns.supply[i], columns.demand[i], damping);
+        columns.next_price[i] = usable ? std::max(secant, min_price) : tatonnement;
+    }
+}
@@ -0,0 +1,98 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+namespace cqsp {
+namespace common {
+namespace systems {
+namespace economy {
+/// <summary>
+/// The columns of a market that a price engine reads and writes, with an element for every good.
+/// </summary>
+struct PriceColumns {
+    int goods = 0;
+    // What was traded this tick, at `price`
+    const double* supply = nullptr;
+    const double* demand = nullptr;
+    const double* price = nullptr;
+    // What was traded the tick before, at `last_price`
+    const double* last_supply = nullptr;
+    const double* last_demand = nullptr;
+    const double* last_price = nullptr;
+    // The prices for the next tick. May be the same array as `last_price`, so it has to be read first.
+    double* next_price = nullptr;
+};
+
+/// <summary>
+/// Computes the prices of the goods on a market for the next tick, from their supply and demand.
+/// </summary>
+/// SysMarket runs the engine on every market at once, so engines can't keep any state of their own. Goods that
+/// weren't traded keep their price, no matter what the engine computes for them.
+class PriceEngine {
+ public:
+    virtual ~PriceEngine() = default;
+    virtual void UpdatePrices(const PriceColumns& columns) const = 0;
+
+    // Prices never go below this
+    static constexpr double min_price = 0.001;
+};
+
+/// <summary>
+/// Moves the price up or down by 10% if there is more demand than supply or more supply than demand.
+/// </summary>
+/// This is the default, but it oscillates around the price where supply and demand are equal instead of settling on
+/// it.
+class FixedStepPriceEngine : public PriceEngine {
+ public:
+    void UpdatePrices(const PriceColumns& columns) const override;
+};
+
+/// <summary>
+/// Moves the price in proportion to how much more demand there is than supply, as a fraction of both, so the
+/// steps get smaller as the market gets closer to equilibrium.
+/// </summary>
+class TatonnementPriceEngine : public PriceEngine {
+ public:
+    /// <param name="damping">The fraction that the price moves by when there is only supply or only demand</param>
+    explicit TatonnementPriceEngine(double damping = 0.2) : damping(damping) {}
+    void UpdatePrices(const PriceColumns& columns) const override;
+
+ private:
+    double damping;
+};
+
+/// <summary>
+/// Estimates how the excess demand of a good changes with its price from this tick and the tick before, and steps
+/// to the price where the excess demand would be zero.
+/// </summary>
+/// If the estimate can't be made, because the price didn't change or the excess demand went up with the price, it
+/// takes a tatonnement step instead.
+class SecantPriceEngine : public PriceEngine {
+ public:
+    /// <param name="max_step">The largest fraction of the price that the price can move by in a tick</param>
+    /// <param name="damping">The damping of the tatonnement steps</param>
+    explicit SecantPriceEngine(double max_step = 0.5, double damping = 0.2) : max_step(max_step), damping(damping) {}
+    void UpdatePrices(const PriceColumns& columns) const override;
+
+ private:
+    double max_step;
+    double damping;
+};
+}  // namespace economy
+}  // namespace systems
+}  // namespace common
+}  // namespace cqsp
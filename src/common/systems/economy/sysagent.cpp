@@ -16,56 +16,126 @@
 */
 #include "common/systems/economy/sysagent.h"
 
+#include <algorithm>
+#include <span>
+
 #include "common/components/economy.h"
 #include "common/systems/economy/markethelpers.h"
+#include "common/systems/economy/tradematrix.h"
+#include "common/util/tickarena.h"
 
-void cqsp::common::systems::SysAgent::DoSystem() {
-    auto view = GetUniverse().view<cqsp::common::components::MarketAgent>();
-    for (entt::entity entity : view) {
-        // Sell resources that agents produced
-        double production_multiplier = 1;
-        if (GetUniverse().any_of<components::FactoryProductivity>(entity)) {
-            auto& prod = GetUniverse().get<components::FactoryProductivity>(entity);
-            production_multiplier = prod.current_production;
-        }
-        components::ResourceLedger selling;
-        if (GetUniverse().all_of<components::ResourceGenerator>(entity)) {
-            auto& gen = GetUniverse().get<components::ResourceGenerator>(entity);
-            selling.MultiplyAdd(gen, production_multiplier);
-        }
+namespace cqspc = cqsp::common::components;
 
-        // Recipe things
-        auto resource_converter = GetUniverse().try_get<components::ResourceConverter>(entity);
-        components::Recipe* recipe = nullptr;
-        if (resource_converter != nullptr && GetUniverse().all_of<components::FactoryProducing>(entity)) {
-            recipe = GetUniverse().try_get<components::Recipe>(resource_converter->recipe);
-            // Sell the recipe production
-            selling.MultiplyAdd(recipe->output, production_multiplier);
-            GetUniverse().remove<components::FactoryProducing>(entity);
-        }
-        if (!selling.empty()) {
-            economy::SellGood(GetUniverse(), entity, selling);
-        }
+namespace {
+// Enough agents that the time to trade a chunk is much longer than the time to hand it to a thread
+constexpr size_t agents_per_chunk = 512;
 
-        // Buy the resources that they produced
-        components::ResourceLedger buying;
-        if (GetUniverse().all_of<components::ResourceConsumption>(entity)) {
-            auto& gen = GetUniverse().get<components::ResourceConsumption>(entity);
-            buying.MultiplyAdd(gen, production_multiplier);
-        }
+void TradeAgent(cqsp::common::Universe& universe, entt::entity entity, const cqspc::ResourceGenerator* generator,
+                const cqspc::ResourceConverter* resource_converter, const cqspc::ResourceConsumption* consumption) {
+    namespace economy = cqsp::common::systems::economy;
+    // Sell resources that agents produced
+    double production_multiplier = 1;
+    if (auto prod = universe.try_get<cqspc::FactoryProductivity>(entity); prod != nullptr) {
+        production_multiplier = prod->current_production;
+    }
+    // Agents only trade a few goods, so these ledgers stay inline, and the few that don't allocate from the arena
+    cqspc::SmallLedger selling(&cqsp::common::util::TickArena::Get());
+    if (generator != nullptr) {
+        selling.MultiplyAdd(*generator, production_multiplier);
+    }
 
-        if (resource_converter != nullptr && recipe != nullptr) {
-            // Sell the recipe production
-            buying.MultiplyAdd(recipe->input, production_multiplier);
-        }
-        // Check if they buy or sell the goods, if they cannot achieve that,
-        // then deal with it
-        if (buying.empty()) {
-            continue;
-        }
-        bool success = economy::PurchaseGood(GetUniverse(), entity, buying);
-        if (success) {
-            GetUniverse().emplace_or_replace<components::FactoryProducing>(entity);
+    // Recipe things
+    cqspc::Recipe* recipe = nullptr;
+    if (resource_converter != nullptr && universe.all_of<cqspc::FactoryProducing>(entity)) {
+        recipe = universe.try_get<cqspc::Recipe>(resource_converter->recipe);
+        // Sell the recipe production
+        selling.MultiplyAdd(recipe->output, production_multiplier);
+        universe.remove<cqspc::FactoryProducing>(entity);
+    }
+    if (!selling.empty()) {
+        economy::SellGood(universe, entity, selling);
+    }
+
+    // Buy the resources that they produced
+    cqspc::SmallLedger buying(&cqsp::common::util::TickArena::Get());
+    if (consumption != nullptr) {
+        buying.MultiplyAdd(*consumption, production_multiplier);
+    }
+
+    if (resource_converter != nullptr && recipe != nullptr) {
+        // Sell the recipe production
+        buying.MultiplyAdd(recipe->input, production_multiplier);
+    }
+    // Check if they buy or sell the goods, if they cannot achieve that,
+    // then deal with it
+    if (buying.empty()) {
+        return;
+    }
+    bool success = economy::PurchaseGood(universe, entity, buying);
+    if (success) {
+        universe.emplace_or_replace<cqspc::FactoryProducing>(entity);
+    }
+}
+}  // namespace
+
+void cqsp::common::systems::SysAgent::DoSystem() {
+    Universe& universe = GetUniverse();
+    for (entt::entity market : universe.view<cqspc::Market>()) {
+        universe.get_or_emplace<cqspc::TradeMatrix>(market);
+    }
+    economy::BuildTradeMatrices(universe);
+
+    // Every agent is traded exactly once: the agents on every market through the trade matrix of the market, and
+    // then one by one the agents that trade goods the matrices can't hold.
+    // The rows of the matrices are split into chunks that plan their orders on their own, so that they can be
+    // planned in parallel, and are then committed.
+    auto unindexed = util::MakeTickVector<entt::entity>();
+    // The first chunk of every market, and one past the last chunk
+    auto market_chunks = util::MakeTickVector<size_t>();
+    size_t chunk_count = 0;
+    for (auto [entity, market, matrix] : universe.view<cqspc::Market, cqspc::TradeMatrix>().each()) {
+        unindexed.insert(unindexed.end(), matrix.unindexed.begin(), matrix.unindexed.end());
+        economy::PrepareTradeMarket(universe, market, matrix);
+        market_chunks.push_back(chunk_count);
+        for (size_t begin = 0; begin < matrix.agents.size(); begin += agents_per_chunk) {
+            if (chunk_count == chunks.size()) {
+                chunks.emplace_back();
+            }
+            economy::TradeChunk& chunk = chunks[chunk_count++];
+            chunk.market_entity = entity;
+            chunk.market = &market;
+            chunk.matrix = &matrix;
+            chunk.begin = begin;
+            chunk.end = std::min(begin + agents_per_chunk, matrix.agents.size());
         }
     }
+    market_chunks.push_back(chunk_count);
+
+    // Threads take the next chunk when they are done with one, so threads that get cheap chunks take more of them
+    const int chunk_tasks = static_cast<int>(chunk_count);
+    util::ParallelFor(GetThreadPool(), chunk_tasks,
+                      [&](int chunk) { economy::PlanTradeChunk(universe, chunks[chunk]); });
+    util::ParallelFor(GetThreadPool(), chunk_tasks,
+                      [&](int chunk) { economy::CommitTradeChunk(universe, chunks[chunk]); });
+    // The chunks of a market are added to it in order, so the sums are the same no matter how many threads there are
+    util::ParallelFor(GetThreadPool(), static_cast<int>(market_chunks.size()) - 1, [&](int market) {
+        std::span<const economy::TradeChunk> market_span(chunks.data() + market_chunks[market],
+                                                          chunks.data() + market_chunks[market + 1]);
+        economy::CommitTradeMarket(universe, market_span);
+    });
+    for (size_t chunk = 0; chunk < chunk_count; chunk++) {
+        economy::CommitProducing(universe, chunks[chunk], unindexed);
+    }
+    for (entt::entity entity : unindexed) {
+        TradeAgent(universe, entity, universe.try_get<cqspc::ResourceGenerator>(entity),
+                   universe.try_get<cqspc::ResourceConverter>(entity),
+                   universe.try_get<cqspc::ResourceConsumption>(entity));
+    }
+}
+
+void cqsp::common::systems::SysAgent::DeclareAccess(ComponentAccess& access) {
+    // The payments are recorded into the journal and only change the wallets when it is settled after the tick
+    access.Read<cqspc::MarketAgent, cqspc::FactoryProductivity, cqspc::ResourceGenerator, cqspc::ResourceConverter,
+                cqspc::Recipe, cqspc::ResourceConsumption, cqspc::Wallet>();
+    access.Write<cqspc::FactoryProducing, cqspc::Market, cqspc::TradeMatrix, cqspc::ResourceStockpile>();
 }
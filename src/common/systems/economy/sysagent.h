@@ -16,13 +16,21 @@
 */
 #pragma once
 
+#include <vector>
+
 #include "common/systems/isimulationsystem.h"
+#include "common/systems/economy/tradematrix.h"
 
 namespace cqsp::common::systems {
 class SysAgent : public ISimulationSystem {
  public:
     explicit SysAgent(Game& game) : ISimulationSystem(game) {}
     void DoSystem() override;
+    void DeclareAccess(ComponentAccess& access) override;
     int Interval() override { return 1; }
+
+ private:
+    // Kept between ticks so that the buffers of the chunks are only allocated once
+    std::vector<economy::TradeChunk> chunks;
 };
 }  // namespace cqsp::common::systems
@@ -18,21 +18,19 @@
 
 #include "common/components/area.h"
 #include "common/components/economy.h"
+#include "common/systems/economy/economygroups.h"
 
 void cqsp::common::systems::SysMine::DoSystem() {
-    auto view = GetUniverse().view<components::RawResourceGen,
-                                components::ResourceGenerator, components::MarketAgent>();
-    for (const entt::entity& entity : view) {
+    auto mines = economy::MineGroup(GetUniverse());
+    for (auto [entity, gen, agent] : mines.each()) {
         // Get market attached, get sd ratio for the goods it produces, then adjust production.
         //
-        auto& gen = GetUniverse().get<components::ResourceGenerator>(entity);
         entt::entity generated = entt::null;
         double amount_generated = 0;
         auto gen_it = gen.begin();
         generated = gen_it->first;
         amount_generated = gen_it->second;
-        auto& market = GetUniverse().get<components::Market>(
-            GetUniverse().get<components::MarketAgent>(entity).market);
+        auto& market = GetUniverse().get<components::Market>(agent.market);
 
         // Reduce production because costs
         const double sd_ratio = market.GetSDRatio(generated);
@@ -51,3 +49,9 @@ void cqsp::common::systems::SysMine::DoSystem() {
         }
     }
 }
+
+void cqsp::common::systems::SysMine::DeclareAccess(ComponentAccess& access) {
+    access.Read<components::RawResourceGen, components::ResourceGenerator, components::MarketAgent,
+                components::Market>();
+    access.Write<components::FactoryProductivity>();
+}
@@ -26,6 +26,7 @@ class SysMine : public ISimulationSystem {
  public:
     explicit SysMine(Game& game) : ISimulationSystem(game) {}
     void DoSystem() override;
+    void DeclareAccess(ComponentAccess& access) override;
     int Interval() override { return 1; }
 };
 }  // namespace cqsp::common::systems
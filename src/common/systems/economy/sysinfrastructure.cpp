@@ -48,3 +48,9 @@ void cqsp::common::systems::InfrastructureSim::DoSystem() {
         }
     }
 }
+
+void cqsp::common::systems::InfrastructureSim::DeclareAccess(ComponentAccess& access) {
+    namespace cqspc = cqsp::common::components;
+    access.Read<cqspc::Industry, cqspc::infrastructure::PowerPlant, cqspc::infrastructure::PowerConsumption>();
+    access.Write<cqspc::infrastructure::CityPower, cqspc::infrastructure::BrownOut>();
+}
@@ -25,6 +25,7 @@ class InfrastructureSim : public ISimulationSystem {
  public:
     explicit InfrastructureSim(Game& game) : ISimulationSystem(game) {}
     void DoSystem();
+    void DeclareAccess(ComponentAccess& access) override;
 };
 }  // namespace systems
 }  // namespace common
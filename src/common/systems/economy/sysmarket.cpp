@@ -17,54 +17,96 @@
 #include "common/systems/economy/sysmarket.h"
 
 #include <limits>
+#include <memory>
 
 #include "common/components/economy.h"
+#include "common/util/tickarena.h"
+
+namespace {
+namespace components = cqsp::common::components;
+using cqsp::common::systems::economy::PriceColumns;
+using cqsp::common::systems::economy::PriceEngine;
+
+inline double SDRatio(double supply, double demand) {
+    // If there is no demand, then there is infinite supply
+    return demand <= 0 ? std::numeric_limits<double>::infinity() : supply / demand;
+}
+
+/// <summary>
+/// Computes the prices of the goods from the supply and demand in the current columns into the next columns. The
+/// supply and demand of the next columns are left as they are, and cleared when the next epoch writes to them. The
+/// current columns keep the prices that the goods were traded at.
+/// </summary>
+void UpdateColumns(const PriceEngine& engine, components::MarketColumns& current, components::MarketColumns& next) {
+    const int goods = current.size();
+    const double* supply = current.supply.data();
+    const double* demand = current.demand.data();
+    const double* price = current.price.data();
+    double* sd_ratio = current.sd_ratio.data();
+    double* next_supply = next.supply.data();
+    double* next_demand = next.demand.data();
+    double* next_price = next.price.data();
+    double* next_sd_ratio = next.sd_ratio.data();
+    engine.UpdatePrices({goods, supply, demand, price, next_supply, next_demand, next_price, next_price});
+    for (int i = 0; i < goods; i++) {
+        // Goods that weren't traded keep their price
+        const bool traded = supply[i] != 0 || demand[i] != 0;
+        const double ratio = traded ? SDRatio(supply[i], demand[i]) : sd_ratio[i];
+        sd_ratio[i] = ratio;
+        next_price[i] = traded ? next_price[i] : price[i];
+        next_sd_ratio[i] = ratio;
+    }
+
+    // Goods that aren't in the good index
+    for (auto& [good, element] : current.overflow) {
+        components::MarketElementInformation& last = next.overflow[good];
+        if (element.supply != 0 || element.demand != 0) {
+            element.sd_ratio = SDRatio(element.supply, element.demand);
+            engine.UpdatePrices({1, &element.supply, &element.demand, &element.price, &last.supply, &last.demand,
+                                 &last.price, &last.price});
+        } else {
+            last.price = element.price;
+        }
+        last.sd_ratio = element.sd_ratio;
+    }
+}
+}  // namespace
+
+cqsp::common::systems::SysMarket::SysMarket(Game& game)
+    : ISimulationSystem(game), engine(std::make_unique<economy::FixedStepPriceEngine>()) {}
 
 void cqsp::common::systems::SysMarket::DoSystem() {
-    // Get all the new and improved (tm) markets
     auto view = GetUniverse().view<components::Market>();
-    // Calculate all the things
+    auto markets = util::MakeTickVector<components::Market*>();
     for (entt::entity entity : view) {
-        // Get the resources and process the price, then do things, I guess
-        // Get demand
-        auto& market = GetUniverse().get<components::Market>(entity);
-        // Calculate all the goods in the map
-        // Our economy will be demand driven, which means we only calculate the resources in the demand part of themap
-        // Get the resources that are traded, I guess
-        for (auto& info : market) {
-            auto& market_element = info.second;
-            if (market_element.supply == 0 && market_element.demand == 0) {
-                continue;
-            }
-            double sd_ratio = market_element.supply / market_element.demand;
-
-            if (market_element.demand <= 0) {
-                // Then there is infinite supply, and the price will go down.
-                sd_ratio = std::numeric_limits<double>::infinity();
-            }
-
-            double& price = market_element.price;
-            if (sd_ratio < 1) {
-                // Too much demand, so we will increase the price
-                price += (0.001 + price * 0.1f);
-            } else if (sd_ratio > 1) {
-                // Too much supply, so we will decrease the price
-                price += (-0.001 + price * -0.1f);
-                // Limit price to a minimum of 0.001
-                if (price < 0.001) {
-                    price = 0.001;
-                }
-            } else {
-                // Keep price approximately the same
-            }
-            // Set last market information for documentation purposes
-            auto& el = market.last_market_information[info.first];
-            el = market_element;
-            market_element.supply = 0;
-            market_element.demand = 0;
-            market_element.sd_ratio = sd_ratio;
+        if (InSlice(entity)) {
+            markets.push_back(&GetUniverse().get<components::Market>(entity));
         }
-        // Compile supply
-        //std::swap(market.last_market_information, market.market_information);
     }
+    // Every market only changes its own columns, so all of them are cleared at once
+    util::ParallelFor(GetThreadPool(), static_cast<int>(markets.size()), [this, &markets](int i) {
+        components::Market& market = *markets[i];
+        if (!market.HasTrades()) {
+            // Nothing was added to the market, so none of the prices change
+            market.Advance();
+            return;
+        }
+        components::MarketColumns& last = market.Last();
+        if (!market.HasLast()) {
+            // Nothing was traded in the epoch before either, so the engines see it as no supply or demand at the
+            // prices of this epoch
+            last.ClearTrades(market.GetEpoch() - 1);
+            last.price = market.Current().price;
+            for (auto& [good, element] : last.overflow) {
+                element.price = market.Get(good).price;
+            }
+        }
+        UpdateColumns(*engine, market.Current(), last);
+        // The columns of this tick become the last market information, and the next tick adds to the other columns
+        market.Swap();
+    });
+}
+
+void cqsp::common::systems::SysMarket::DeclareAccess(ComponentAccess& access) {
+    access.Write<components::Market>();
 }
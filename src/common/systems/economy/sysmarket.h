@@ -16,12 +16,27 @@
 */
 #pragma once
 
+#include <memory>
+#include <utility>
+
 #include "common/systems/isimulationsystem.h"
+#include "common/systems/economy/priceengine.h"
 
 namespace cqsp::common::systems {
 class SysMarket : public ISimulationSystem {
  public:
-    explicit SysMarket(Game& game) : ISimulationSystem(game) {}
+    explicit SysMarket(Game& game);
     void DoSystem();
+    void DeclareAccess(ComponentAccess& access) override;
+    bool CanSlice() override { return true; }
+
+    /// <summary>
+    /// Sets how the prices are updated. The default is `FixedStepPriceEngine`.
+    /// </summary>
+    void SetPriceEngine(std::unique_ptr<economy::PriceEngine> price_engine) { engine = std::move(price_engine); }
+    const economy::PriceEngine& GetPriceEngine() const { return *engine; }
+
+ private:
+    std::unique_ptr<economy::PriceEngine> engine;
 };
 }  // namespace cqsp::common::systems
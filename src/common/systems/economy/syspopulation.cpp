@@ -21,6 +21,9 @@
 #include "common/components/population.h"
 #include "common/components/resource.h"
 #include "common/components/economy.h"
+#include "common/systems/economy/economygroups.h"
+#include "common/systems/economy/populationdemand.h"
+#include "common/util/tickarena.h"
 
 void cqsp::common::systems::SysPopulationGrowth::DoSystem() {
     namespace cqspc = cqsp::common::components;
@@ -28,6 +31,9 @@ void cqsp::common::systems::SysPopulationGrowth::DoSystem() {
 
     auto view = universe.view<cqspc::PopulationSegment>();
     for (auto [entity, segment] : view.each()) {
+        if (!InSlice(entity)) {
+            continue;
+        }
         // If it's hungry, decay population
         if (universe.all_of<cqspc::Hunger>(entity)) {
             // Population decrease will be about 1 percent each year.
@@ -57,66 +63,122 @@ void cqsp::common::systems::SysPopulationGrowth::DoSystem() {
     }
 }
 
+void cqsp::common::systems::SysPopulationGrowth::DeclareAccess(ComponentAccess& access) {
+    namespace cqspc = cqsp::common::components;
+    access.Read<cqspc::FailedResourceTransfer>();
+    access.Write<cqspc::PopulationSegment, cqspc::Hunger, cqspc::Employee>();
+}
+
+cqsp::common::systems::SysPopulationConsumption::SysPopulationConsumption(Game& game)
+    : ISimulationSystem(game),
+      consumer_good_handle(GetUniverse().goods.Intern("consumer_good")),
+      food_handle(GetUniverse().goods.Intern("food")) {}
+
 void cqsp::common::systems::SysPopulationConsumption::DoSystem() {
     namespace cqspc = cqsp::common::components;
     Universe& universe = GetUniverse();
 
-    const entt::entity good = universe.goods["consumer_good"];
-    const entt::entity food = universe.goods["food"];
-    auto view = universe.view<cqspc::PopulationSegment>();
-    for (auto [entity, segment] : view.each()) {
+    const entt::entity good = universe.goods[consumer_good_handle];
+    const entt::entity food = universe.goods[food_handle];
+    // The income is added to the changes of the wallets in this interval
+    const uint32_t epoch = cqspc::Wallet::GetEpoch(universe.date);
+
+    // The prices are looked up once for every market, by the id of the market entity
+    // Searching market is gonna be expensive, so we may need to reorganize the market
+    // to maintain the cost
+    auto market_view = universe.view<cqspc::Market>();
+    auto food_prices = util::MakeTickVector<double>();
+    auto good_prices = util::MakeTickVector<double>();
+    for (auto [entity, market] : market_view.each()) {
+        const auto id = static_cast<size_t>(entt::to_entity(entity));
+        if (id >= food_prices.size()) {
+            food_prices.resize(id + 1, 0);
+            good_prices.resize(id + 1, 0);
+        }
+        food_prices[id] = market.GetPrice(food);
+        good_prices[id] = market.GetPrice(good);
+    }
+
+    // The segments are gathered into columns, so that their demand can be computed all at once
+    auto entities = util::MakeTickVector<entt::entity>();
+    auto consumption = util::MakeTickVector<double>();
+    auto threshold = util::MakeTickVector<double>();
+    auto balance = util::MakeTickVector<double>();
+    auto income = util::MakeTickVector<double>();
+    auto food_price = util::MakeTickVector<double>();
+    auto good_price = util::MakeTickVector<double>();
+    auto consumers = economy::ConsumerGroup(universe);
+    entities.reserve(consumers.size());
+    for (auto* column : {&consumption, &threshold, &balance, &income, &food_price, &good_price}) {
+        column->reserve(consumers.size());
+    }
+    for (auto [entity, segment, market_agent] : consumers.each()) {
+        if (!InSlice(entity)) {
+            continue;
+        }
+        entities.push_back(entity);
         // The population will get at least an amount of resources, and
         // Reduce it to some unreasonably low level so that the economy can handle it
-        uint64_t consumption = segment.population/100000;
-        // Get the cost of food in the market, and then get the amount of food based
-        // Essentially population units have a certain amount of food that they need,
-        // and that's based on the population count.
-
-        // They will buy all the food from the market, and the remaining will be
-        // spent on consumer goods.
-
-        // Other spendings we may want to think about:
-        //  - Housing
-        //  - Transport
-        //  - Healthcare
-        //  - Insurance
-        //  - Entertainment
-        //  - Education
-        //  - Utilities
-        auto& wallet = universe.get_or_emplace<cqspc::Wallet>(entity);
+        consumption.push_back(static_cast<double>(segment.population / 100000));
+        // If the price is too high, then don't buy, it's not worth it, we'll wait for the price to crash
+        threshold.push_back(static_cast<double>(segment.population / 20000));
+        // Inject some cash into the population segment, so that they don't run out of money to buy the stuff
+        income.push_back(static_cast<double>(segment.population / 1000));
         // In the future, we may want to think about population wanting to save cash,
         // so to simulate consumer spending
+        const auto* wallet = universe.try_get<cqspc::Wallet>(entity);
+        balance.push_back(wallet == nullptr ? 0 : wallet->GetBalance());
+        const auto market = static_cast<size_t>(entt::to_entity(market_agent.market));
+        food_price.push_back(food_prices[market]);
+        good_price.push_back(good_prices[market]);
+    }
 
-        // Get the cost of the goods
-        // Searching market is gonna be expensive, so we may need to reorganize the market
-        // to maintain the cost
-        if (universe.any_of<cqspc::MarketAgent>(entity)) {
-            // Trade the goods
-            auto& market_agent = universe.get<cqspc::MarketAgent>(entity);
-            auto& market = universe.get<cqspc::Market>(market_agent.market);
-            // Check if they have enough money to buy all they can, then
-            double food_price = market.GetPrice(food);
-            if (consumption * food_price > wallet.GetBalance()) {
-                // Then not enough cash and pivot everything to buying food
-                universe.get_or_emplace<cqspc::ResourceConsumption>(entity)[food] = wallet.GetBalance() / food_price;
-            } else {
-                universe.get_or_emplace<cqspc::ResourceConsumption>(entity)[food] = consumption;
-                // Then waste it all on consumer goods
-                double amount_consumer = wallet.GetBalance() - food_price * consumption;
-                // If the price is too high, then don't buy, it's not worth it, we'll wait for the price to crash
-                double good_price = market.GetPrice(good);
-                if (amount_consumer / good_price > segment.population / 20000) {
-                    universe.get_or_emplace<cqspc::ResourceConsumption>(entity)[good] =
-                                                        amount_consumer / good_price;
-                }
-                // Based on how much they spend on consumer goods, we can rate their social strata
-                // becasue those that consume more will have a higher standard of living.
-            }
-        } else {
-            universe.get_or_emplace<cqspc::ResourceConsumption>(entity)[food] = consumption;
+    // Essentially population units have a certain amount of food that they need,
+    // and that's based on the population count.
+    // They will buy all the food from the market, and the remaining will be
+    // spent on consumer goods.
+
+    // Other spendings we may want to think about:
+    //  - Housing
+    //  - Transport
+    //  - Healthcare
+    //  - Insurance
+    //  - Entertainment
+    //  - Education
+    //  - Utilities
+    const int segments = static_cast<int>(entities.size());
+    auto food_demand = util::MakeTickVector<double>();
+    auto good_demand = util::MakeTickVector<double>();
+    food_demand.resize(segments);
+    good_demand.resize(segments);
+    economy::ComputePopulationDemand({segments, consumption.data(), threshold.data(), balance.data(),
+                                      food_price.data(), good_price.data(), food_demand.data(), good_demand.data()});
+
+    for (int i = 0; i < segments; i++) {
+        auto& resource_consumption = universe.get_or_emplace<cqspc::ResourceConsumption>(entities[i]);
+        resource_consumption[food] = food_demand[i];
+        if (good_demand[i] > 0) {
+            // Based on how much they spend on consumer goods, we can rate their social strata
+            // becasue those that consume more will have a higher standard of living.
+            resource_consumption[good] = good_demand[i];
         }
+        universe.get_or_emplace<cqspc::Wallet>(entities[i]).Add(income[i], epoch);
+    }
 
-        // Inject some cash into the population segment, so that they don't run out of money to buy the stuff
-        wallet += segment.population / 1000;
+    // Population segments that aren't on a market only get food
+    auto isolated = universe.view<cqspc::PopulationSegment>(entt::exclude<cqspc::MarketAgent>);
+    for (auto [entity, segment] : isolated.each()) {
+        if (!InSlice(entity)) {
+            continue;
+        }
+        uint64_t consumption = segment.population/100000;
+        universe.get_or_emplace<cqspc::ResourceConsumption>(entity)[food] = consumption;
+        universe.get_or_emplace<cqspc::Wallet>(entity).Add(segment.population / 1000, epoch);
     }
 }
+
+void cqsp::common::systems::SysPopulationConsumption::DeclareAccess(ComponentAccess& access) {
+    namespace cqspc = cqsp::common::components;
+    access.Read<cqspc::PopulationSegment, cqspc::MarketAgent, cqspc::Market>();
+    access.Write<cqspc::Wallet, cqspc::ResourceConsumption>();
+}
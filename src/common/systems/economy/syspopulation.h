@@ -17,18 +17,27 @@
 #pragma once
 
 #include "common/systems/isimulationsystem.h"
+#include "common/util/identifiertable.h"
 
 namespace cqsp::common::systems {
 class SysPopulationGrowth : public ISimulationSystem {
  public:
     explicit SysPopulationGrowth(Game& game) : ISimulationSystem(game) {}
     void DoSystem();
+    void DeclareAccess(ComponentAccess& access) override;
     int Interval() { return 625; }
+    bool CanSlice() override { return true; }
 };
 
 class SysPopulationConsumption : public ISimulationSystem {
  public:
-    explicit SysPopulationConsumption(Game& game) : ISimulationSystem(game) {}
+    explicit SysPopulationConsumption(Game& game);
     void DoSystem();
+    void DeclareAccess(ComponentAccess& access) override;
+    bool CanSlice() override { return true; }
+
+ private:
+    util::IdentifierTable::Handle consumer_good_handle;
+    util::IdentifierTable::Handle food_handle;
 };
 }  // namespace cqsp::common::systems
@@ -0,0 +1,357 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "common/systems/economy/tradematrix.h"
+
+#include <algorithm>
+#include <span>
+#include <utility>
+
+namespace cqspc = cqsp::common::components;
+
+namespace {
+template <typename Ledger>
+bool IsIndexed(const cqspc::GoodIndex& index, const Ledger& ledger) {
+    for (const auto& [good, amount] : ledger) {
+        if (index.Find(good) == cqspc::GoodIndex::none) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Ledger>
+void Scatter(const cqspc::GoodIndex& index, const Ledger& ledger, double* row, double multiplier = 1) {
+    for (const auto& [good, amount] : ledger) {
+        row[index.Find(good)] += amount * multiplier;
+    }
+}
+
+// The loops below are kept simple so that the compiler vectorizes them
+void Scale(const double* row, double multiplier, double* out, int size) {
+    for (int i = 0; i < size; i++) {
+        out[i] = row[i] * multiplier;
+    }
+}
+
+void ScaleAdd(const double* row, double multiplier, double* out, int size) {
+    for (int i = 0; i < size; i++) {
+        out[i] += row[i] * multiplier;
+    }
+}
+
+void Add(const double* row, double* out, int size) {
+    for (int i = 0; i < size; i++) {
+        out[i] += row[i];
+    }
+}
+
+double Dot(const double* a, const double* b, int size) {
+    // Independent sums so that the additions don't wait on each other
+    double sum[4] = {0, 0, 0, 0};
+    int i = 0;
+    for (; i + 4 <= size; i += 4) {
+        sum[0] += a[i] * b[i];
+        sum[1] += a[i + 1] * b[i + 1];
+        sum[2] += a[i + 2] * b[i + 2];
+        sum[3] += a[i + 3] * b[i + 3];
+    }
+    for (; i < size; i++) {
+        sum[0] += a[i] * b[i];
+    }
+    return (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+// Records a payment for every good in the row, which is paid when the journal is settled
+void RecordRow(std::vector<cqspc::JournalEntry>& entries, entt::entity payer, entt::entity payee,
+               const cqspc::GoodIndex& index, const double* amounts, const double* prices, int size) {
+    for (int i = 0; i < size; i++) {
+        if (amounts[i] != 0) {
+            entries.push_back({payer, payee, amounts[i] * prices[i], index.GetGood(i), amounts[i]});
+        }
+    }
+}
+
+void MarkMarketDirty(entt::registry& registry, entt::entity entity) {
+    auto* agent = registry.try_get<cqspc::MarketAgent>(entity);
+    if (agent == nullptr || !registry.valid(agent->market)) {
+        return;
+    }
+    if (auto* matrix = registry.try_get<cqspc::TradeMatrix>(agent->market); matrix != nullptr) {
+        matrix->dirty = true;
+    }
+}
+
+void MarkAllDirty(entt::registry& registry, entt::entity) {
+    // The agent may have moved to another market, and the market that it left isn't known anymore
+    for (auto [market, matrix] : registry.view<cqspc::TradeMatrix>().each()) {
+        matrix.dirty = true;
+    }
+}
+
+void AddRow(cqsp::common::Universe& universe, cqspc::TradeMatrix& matrix, entt::entity entity) {
+    const cqspc::GoodIndex& index = universe.good_index;
+    const auto* generator = universe.try_get<cqspc::ResourceGenerator>(entity);
+    const cqspc::Recipe* recipe = nullptr;
+    if (auto* converter = universe.try_get<cqspc::ResourceConverter>(entity);
+        converter != nullptr && universe.valid(converter->recipe)) {
+        recipe = universe.try_get<cqspc::Recipe>(converter->recipe);
+    }
+    if ((generator != nullptr && !IsIndexed(index, *generator)) ||
+        (recipe != nullptr && (!IsIndexed(index, recipe->input) || !IsIndexed(index, recipe->output)))) {
+        matrix.unindexed.push_back(entity);
+        return;
+    }
+
+    size_t row = matrix.agents.size() * matrix.goods;
+    size_t end = row + matrix.goods;
+    matrix.agents.push_back(entity);
+    matrix.generation.resize(end, 0);
+    matrix.recipe_input.resize(end, 0);
+    matrix.recipe_output.resize(end, 0);
+    if (generator != nullptr) {
+        Scatter(index, *generator, matrix.generation.data() + row);
+    }
+    if (recipe != nullptr) {
+        Scatter(index, recipe->input, matrix.recipe_input.data() + row);
+        Scatter(index, recipe->output, matrix.recipe_output.data() + row);
+    }
+    matrix.generates.push_back(generator != nullptr && !generator->empty());
+    matrix.converts.push_back(recipe != nullptr);
+    matrix.sells_recipe.push_back(recipe != nullptr && !recipe->output.empty());
+    matrix.buys_recipe.push_back(recipe != nullptr && !recipe->input.empty());
+}
+
+void Clear(cqspc::TradeMatrix& matrix, int goods) {
+    matrix.goods = goods;
+    matrix.agents.clear();
+    matrix.generation.clear();
+    matrix.recipe_input.clear();
+    matrix.recipe_output.clear();
+    matrix.generates.clear();
+    matrix.converts.clear();
+    matrix.sells_recipe.clear();
+    matrix.buys_recipe.clear();
+    matrix.unindexed.clear();
+}
+}  // namespace
+
+void cqsp::common::systems::economy::RegisterTradeMatrices(entt::registry& registry) {
+    registry.on_construct<cqspc::MarketAgent>().connect<&MarkMarketDirty>();
+    registry.on_update<cqspc::MarketAgent>().connect<&MarkAllDirty>();
+    registry.on_destroy<cqspc::MarketAgent>().connect<&MarkMarketDirty>();
+    registry.on_construct<cqspc::ResourceGenerator>().connect<&MarkMarketDirty>();
+    registry.on_update<cqspc::ResourceGenerator>().connect<&MarkMarketDirty>();
+    registry.on_destroy<cqspc::ResourceGenerator>().connect<&MarkMarketDirty>();
+    registry.on_construct<cqspc::ResourceConverter>().connect<&MarkMarketDirty>();
+    registry.on_update<cqspc::ResourceConverter>().connect<&MarkMarketDirty>();
+    registry.on_destroy<cqspc::ResourceConverter>().connect<&MarkMarketDirty>();
+}
+
+void cqsp::common::systems::economy::BuildTradeMatrices(Universe& universe) {
+    const int goods = universe.good_index.size();
+    bool rebuild = false;
+    for (auto [market, matrix] : universe.view<cqspc::TradeMatrix>().each()) {
+        if (matrix.dirty || matrix.goods != goods) {
+            matrix.dirty = true;
+            Clear(matrix, goods);
+            rebuild = true;
+        }
+    }
+    if (!rebuild) {
+        return;
+    }
+
+    for (auto [entity, agent] : universe.view<cqspc::MarketAgent>().each()) {
+        if (!universe.valid(agent.market)) {
+            continue;
+        }
+        auto* matrix = universe.try_get<cqspc::TradeMatrix>(agent.market);
+        if (matrix != nullptr && matrix->dirty) {
+            AddRow(universe, *matrix, entity);
+        }
+    }
+
+    for (auto [market, matrix] : universe.view<cqspc::TradeMatrix>().each()) {
+        matrix.dirty = false;
+    }
+}
+
+void cqsp::common::systems::economy::PrepareTradeMarket(Universe& universe, cqspc::Market& market,
+                                                        cqspc::TradeMatrix& matrix) {
+    const cqspc::GoodIndex& index = universe.good_index;
+    const int goods = matrix.goods;
+
+    // The columns of the market are in the same order as the matrix, unless the market has its own index
+    matrix.prices.resize(goods);
+    if (market.GetIndex() == &index) {
+        // Read through the const columns, which doesn't mark the market as traded on
+        if (std::as_const(market).Current().size() < goods) {
+            market.Resize();
+        }
+        market.GetPrices(matrix.prices);
+    } else {
+        for (int i = 0; i < goods; i++) {
+            matrix.prices[i] = market.GetPrice(index.GetGood(i));
+        }
+    }
+}
+
+void cqsp::common::systems::economy::PlanTradeChunk(const Universe& universe, TradeChunk& chunk) {
+    const cqspc::GoodIndex& index = universe.good_index;
+    const cqspc::TradeMatrix& matrix = *chunk.matrix;
+    const int goods = matrix.goods;
+
+    chunk.supply.assign(goods, 0);
+    chunk.demand.assign(goods, 0);
+    chunk.selling.resize(goods);
+    chunk.buying.resize(goods);
+    chunk.producing.clear();
+    chunk.unindexed.clear();
+    chunk.spending = 0;
+    chunk.orders.clear();
+    double* selling = chunk.selling.data();
+    double* buying = chunk.buying.data();
+    const double* prices = matrix.prices.data();
+
+    for (size_t agent = chunk.begin; agent < chunk.end; agent++) {
+        entt::entity entity = matrix.agents[agent];
+        const auto* consumption = universe.try_get<cqspc::ResourceConsumption>(entity);
+        if (consumption != nullptr && !IsIndexed(index, *consumption)) {
+            chunk.unindexed.push_back(entity);
+            continue;
+        }
+
+        double production_multiplier = 1;
+        if (auto prod = universe.try_get<cqspc::FactoryProductivity>(entity); prod != nullptr) {
+            production_multiplier = prod->current_production;
+        }
+        bool producing = matrix.converts[agent] && universe.all_of<cqspc::FactoryProducing>(entity);
+        if (producing) {
+            chunk.producing.emplace_back(entity, false);
+        }
+        bool sells_recipe = producing && matrix.sells_recipe[agent];
+        bool sells = matrix.generates[agent] || sells_recipe;
+        bool buys_recipe = producing && matrix.buys_recipe[agent];
+        bool buys = buys_recipe || (consumption != nullptr && !consumption->empty());
+        if (!sells && !buys) {
+            continue;
+        }
+        const size_t row = agent * goods;
+        // Only money that was settled before this tick can be spent
+        const auto& wallet = universe.get<cqspc::Wallet>(entity);
+
+        // Sell what the agent produced
+        if (sells) {
+            Scale(matrix.generation.data() + row, production_multiplier, selling, goods);
+            if (sells_recipe) {
+                ScaleAdd(matrix.recipe_output.data() + row, production_multiplier, selling, goods);
+            }
+            Add(selling, chunk.supply.data(), goods);
+            RecordRow(chunk.orders, chunk.market_entity, entity, index, selling, prices, goods);
+        }
+
+        // Buy what the agent needs
+        if (!buys) {
+            continue;
+        }
+        if (buys_recipe) {
+            Scale(matrix.recipe_input.data() + row, production_multiplier, buying, goods);
+        } else {
+            std::fill(buying, buying + goods, 0);
+        }
+        if (consumption != nullptr) {
+            Scatter(index, *consumption, buying, production_multiplier);
+        }
+        double cost = Dot(buying, prices, goods);
+        if (wallet.GetBalance() - universe.journal.GetPendingDebit(entity) < cost) {
+            continue;
+        }
+        Add(buying, chunk.demand.data(), goods);
+        RecordRow(chunk.orders, entity, chunk.market_entity, index, buying, prices, goods);
+        chunk.spending += cost;
+        chunk.producing.emplace_back(entity, true);
+    }
+}
+
+void cqsp::common::systems::economy::CommitTradeChunk(Universe& universe, const TradeChunk& chunk) {
+    for (const cqspc::JournalEntry& order : chunk.orders) {
+        // The market pays for what the agent sells
+        const bool selling = order.payer == chunk.market_entity;
+        entt::entity agent = selling ? order.payee : order.payer;
+        if (auto* stockpile = universe.try_get<cqspc::ResourceStockpile>(agent); stockpile != nullptr) {
+            (*stockpile)[order.good] += selling ? -order.quantity : order.quantity;
+        }
+    }
+    // Recorded into the journal of this thread, so chunks that are committed at the same time don't share it
+    universe.journal.Record(chunk.orders);
+}
+
+void cqsp::common::systems::economy::CommitTradeMarket(Universe& universe, std::span<const TradeChunk> chunks) {
+    if (chunks.empty()) {
+        return;
+    }
+    const cqspc::GoodIndex& index = universe.good_index;
+    cqspc::Market& market = *chunks.front().market;
+    for (const TradeChunk& chunk : chunks) {
+        market.gdp += chunk.spending;
+        for (double amount : chunk.supply) {
+            market.volume += amount;
+        }
+        if (market.GetIndex() == &index) {
+            market.AddSupply(chunk.supply);
+            market.AddDemand(chunk.demand);
+            continue;
+        }
+        for (int i = 0; i < static_cast<int>(chunk.supply.size()); i++) {
+            if (chunk.supply[i] != 0) {
+                market[index.GetGood(i)].supply += chunk.supply[i];
+            }
+            if (chunk.demand[i] != 0) {
+                market[index.GetGood(i)].demand += chunk.demand[i];
+            }
+        }
+    }
+}
+
+void cqsp::common::systems::economy::CommitProducing(Universe& universe, const TradeChunk& chunk,
+                                                     util::TickVector<entt::entity>& unindexed) {
+    // An agent that stopped producing and then bought its inputs again is producing
+    for (auto [entity, producing] : chunk.producing) {
+        if (producing) {
+            universe.emplace_or_replace<cqspc::FactoryProducing>(entity);
+        } else {
+            universe.remove<cqspc::FactoryProducing>(entity);
+        }
+    }
+    unindexed.insert(unindexed.end(), chunk.unindexed.begin(), chunk.unindexed.end());
+}
+
+void cqsp::common::systems::economy::TradeMarket(Universe& universe, entt::entity market_entity, cqspc::Market& market,
+                                                 cqspc::TradeMatrix& matrix,
+                                                 util::TickVector<entt::entity>& unindexed) {
+    PrepareTradeMarket(universe, market, matrix);
+    TradeChunk chunk;
+    chunk.market_entity = market_entity;
+    chunk.market = &market;
+    chunk.matrix = &matrix;
+    chunk.begin = 0;
+    chunk.end = matrix.agents.size();
+    PlanTradeChunk(universe, chunk);
+    CommitTradeChunk(universe, chunk);
+    CommitTradeMarket(universe, std::span<const TradeChunk>(&chunk, 1));
+    CommitProducing(universe, chunk, unindexed);
+}
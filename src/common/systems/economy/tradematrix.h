@@ -0,0 +1,118 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "common/universe.h"
+#include "common/components/economy.h"
+#include "common/components/journal.h"
+#include "common/util/tickarena.h"
+
+namespace cqsp {
+namespace common {
+namespace systems {
+namespace economy {
+/// <summary>
+/// Marks the trade matrix of a market as out of date whenever an agent joins or leaves it, or gets or loses a
+/// generator or recipe. Should be called once when the universe is created.
+/// </summary>
+/// Changes that are made to a generator or recipe in place, instead of through `replace` or `patch`, aren't seen,
+/// so the matrix has to be marked dirty by hand after them.
+void RegisterTradeMatrices(entt::registry& registry);
+
+/// <summary>
+/// Rebuilds the trade matrices of the markets that are dirty, or were built with fewer goods than are in the good
+/// index, in one pass over the market agents.
+/// </summary>
+void BuildTradeMatrices(Universe& universe);
+
+/// <summary>
+/// A range of the agents in the trade matrix of a market, with the orders that they place on the market.
+/// </summary>
+/// Chunks are traded in two phases. The orders of every chunk are planned at once, only reading the components of the
+/// universe. They are then committed: the stockpiles and payments of the agents by chunk, and the supply and demand by
+/// market, which can also be done for every chunk and market at once, and last the tags of the agents, one chunk after
+/// another.
+struct TradeChunk {
+    entt::entity market_entity = entt::null;
+    components::Market* market = nullptr;
+    components::TradeMatrix* matrix = nullptr;
+    // The rows of the agents in the matrix
+    size_t begin = 0;
+    size_t end = 0;
+
+    // By the index of the good
+    std::vector<double> supply;
+    std::vector<double> demand;
+    std::vector<double> selling;
+    std::vector<double> buying;
+    // The money that the agents spent buying
+    double spending = 0;
+    // What the agents sell to and buy from the market, as the payments that are made for them
+    std::vector<components::JournalEntry> orders;
+    // Agents that start or stop producing, because tags can't be added or removed from several threads at once
+    std::vector<std::pair<entt::entity, bool>> producing;
+    std::vector<entt::entity> unindexed;
+};
+
+/// <summary>
+/// Copies the prices of the market into the trade matrix, before the agents of the matrix are traded.
+/// </summary>
+void PrepareTradeMarket(Universe& universe, components::Market& market, components::TradeMatrix& matrix);
+
+/// <summary>
+/// Plans the orders to sell the production and buy the consumption of the agents in the chunk, and adds them up into
+/// the supply and demand of the chunk. Only the chunk is written to.
+/// </summary>
+void PlanTradeChunk(const Universe& universe, TradeChunk& chunk);
+
+/// <summary>
+/// Moves the goods that the agents of the chunk ordered in and out of their stockpiles, and records their payments
+/// into the journal of the calling thread. Only the agents of the chunk are written to.
+/// </summary>
+void CommitTradeChunk(Universe& universe, const TradeChunk& chunk);
+
+/// <summary>
+/// Adds the supply, demand and spending of the chunks to their market, in order. Every chunk has to be of the same
+/// market, and only that market is written to.
+/// </summary>
+void CommitTradeMarket(Universe& universe, std::span<const TradeChunk> chunks);
+
+/// <summary>
+/// Sets which agents in the chunk are producing. Adds and removes tags, so it can't be run on several threads.
+/// </summary>
+/// <param name="unindexed">The agents of the chunk that trade goods that aren't in the good index are appended to
+/// this, so that they can be traded one by one.</param>
+void CommitProducing(Universe& universe, const TradeChunk& chunk, util::TickVector<entt::entity>& unindexed);
+
+/// <summary>
+/// Sells the production and buys the consumption of every agent in the matrix of the market, the same as
+/// `SellGood` and `PurchaseGood` would do for every agent.
+/// </summary>
+/// <param name="unindexed">The agents that can't be traded by the matrix this tick, because they trade goods that
+/// aren't in the good index, are appended to this.</param>
+void TradeMarket(Universe& universe, entt::entity market_entity, components::Market& market,
+                 components::TradeMatrix& matrix, util::TickVector<entt::entity>& unindexed);
+}  // namespace economy
+}  // namespace systems
+}  // namespace common
+}  // namespace cqsp
@@ -25,18 +25,18 @@ void cqsp::common::systems::history::SysMarketHistory::DoSystem() {
         auto& history = GetUniverse().get<components::MarketHistory>(entity);
         auto& market_data = GetUniverse().get<components::Market>(entity);
         // Loop through the prices
-        for (auto resource : market_data.market_information) {
-            history.price_history[resource.first].push_back(resource.second.price);
-            history.volume[resource.first].push_back(
-                market_data.last_market_information[resource.first].demand);
+        for (entt::entity good : market_data.GetGoods()) {
+            history.price_history[good].push_back(market_data.GetPrice(good));
+            history.volume[good].push_back(market_data.GetLast(good).demand);
         }
-        double val = 0;
-        for (entt::entity ent : market_data.participants) {
-            if (GetUniverse().any_of<components::Wallet>(ent)) {
-                auto& wallet = GetUniverse().get<components::Wallet>(ent);
-                val += wallet.GetGDPChange();
-            }
-        }
-        history.gdp.push_back(val);
+        // Added up as the participants traded
+        history.gdp.push_back(market_data.gdp);
+        history.total_volume.push_back(market_data.volume);
+        market_data.gdp = 0;
+        market_data.volume = 0;
     }
 }
+
+void cqsp::common::systems::history::SysMarketHistory::DeclareAccess(ComponentAccess& access) {
+    access.Write<components::Market, components::MarketHistory>();
+}
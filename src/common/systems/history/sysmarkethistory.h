@@ -24,6 +24,7 @@ class SysMarketHistory : public ISimulationSystem {
  public:
     explicit SysMarketHistory(Game& game) : ISimulationSystem(game) {}
     void DoSystem();
+    void DeclareAccess(ComponentAccess& access) override;
 };
 }  // namespace history
 }  // namespace cqsp::common::systems
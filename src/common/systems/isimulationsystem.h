@@ -20,6 +20,8 @@
 
 #include "common/universe.h"
 #include "common/game.h"
+#include "common/systems/componentaccess.h"
+#include "common/util/threadpool.h"
 
 namespace cqsp {
 namespace common {
@@ -35,12 +37,52 @@ class ISimulationSystem {
     /// The default is 25, which is slightly longer than the time of day.
     virtual int Interval() { return 25; }
 
+    /// Declares the components that `DoSystem` reads and writes, so that systems that don't
+    /// touch the same components can be run in parallel.
+    /// By default, a system is exclusive, and will not run alongside any other system.
+    virtual void DeclareAccess(ComponentAccess& access) { access.Exclusive(); }
+
+    /// If the entities that the system processes can be split into `Interval()` slices, with
+    /// one slice processed every tick instead of every entity once every `Interval()` ticks.
+    /// Systems that return true must skip entities that are not `InSlice`. Every entity is still
+    /// processed once per interval, so the results should still be scaled by `Interval()`.
+    virtual bool CanSlice() { return false; }
+
+    /// <summary>
+    /// Sets the slice that will be processed the next time `DoSystem` is run.
+    /// </summary>
+    void SetSlice(int current_slice, int count) {
+        slice = current_slice;
+        slice_count = count;
+    }
+
+    /// <summary>
+    /// Sets the pool that the system can split its work over, or nullptr if it should run on one thread.
+    /// </summary>
+    void SetThreadPool(util::ThreadPool* thread_pool) { pool = thread_pool; }
+
  protected:
     Game& GetGame() { return game; }
     Universe& GetUniverse() { return game.GetUniverse(); }
 
+    /// <summary>
+    /// If the entity should be processed this run. Always true when the system isn't sliced.
+    /// </summary>
+    bool InSlice(entt::entity entity) const {
+        return slice_count <= 1 || static_cast<int>(entt::to_entity(entity) % slice_count) == slice;
+    }
+
+    /// <summary>
+    /// The pool of the scheduler, which is also running other systems, so use `util::ParallelFor` on it instead of
+    /// waiting on tasks. Null if the system is run on one thread.
+    /// </summary>
+    util::ThreadPool* GetThreadPool() const { return pool; }
+
  private:
     Game& game;
+    int slice = 0;
+    int slice_count = 1;
+    util::ThreadPool* pool = nullptr;
 };
 }  // namespace systems
 }  // namespace common
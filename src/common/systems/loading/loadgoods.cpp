@@ -112,6 +112,7 @@ bool GoodLoader::LoadValue(const Hjson::Value& values, entt::entity entity) {
 
     // Basically if it fails at any point, we'll remove the component
     universe.goods[identifier] = entity;
+    universe.good_index.Add(entity);
     return true;
 }
 
@@ -126,10 +127,10 @@ bool RecipeLoader::LoadValue(const Hjson::Value& values, entt::entity entity) {
     auto& recipe_component = universe.emplace<cqspc::Recipe>(entity);
 
     Hjson::Value input_value = values["input"];
-    recipe_component.input = HjsonToLedger(universe, input_value);
+    recipe_component.input = cqspc::SmallLedger(HjsonToLedger(universe, input_value));
 
     Hjson::Value output_value = values["output"];
-    recipe_component.output = HjsonToLedger(universe, output_value);
+    recipe_component.output = cqspc::SmallLedger(HjsonToLedger(universe, output_value));
 
     // Check if it has cost
     if (values["cost"].defined()) {
@@ -148,7 +149,7 @@ bool RecipeLoader::LoadValue(const Hjson::Value& values, entt::entity entity) {
     }
 
     auto &name_object = universe.get<cqspc::Identifier>(entity);
-    universe.recipes[name_object] = entity;
+    universe.recipes[name_object.identifier] = entity;
     return true;
 }
 }  // namespace cqsp::common::systems::loading
@@ -0,0 +1,267 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "common/systems/memoryreport.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "common/components/area.h"
+#include "common/components/bodies.h"
+#include "common/components/coordinates.h"
+#include "common/components/economy.h"
+#include "common/components/history.h"
+#include "common/components/name.h"
+#include "common/components/population.h"
+#include "common/components/resource.h"
+#include "common/components/surface.h"
+
+namespace cqsp::common::systems::memory {
+namespace cqspc = cqsp::common::components;
+namespace cqspb = cqsp::common::components::bodies;
+namespace cqspt = cqsp::common::components::types;
+
+namespace {
+// The parent, left and right pointers and the color of a red-black tree node
+constexpr size_t map_node_overhead = 4 * sizeof(void*);
+// Strings shorter than this are stored inside the string itself
+const size_t small_string_capacity = std::string().capacity();
+
+template <typename Map>
+size_t MapBytes(const Map& map) {
+    return map.size() * (sizeof(typename Map::value_type) + map_node_overhead);
+}
+
+template <typename T>
+size_t VectorBytes(const std::vector<T>& vector) {
+    return vector.capacity() * sizeof(T);
+}
+
+size_t StringBytes(const std::string& string) {
+    return string.capacity() > small_string_capacity ? string.capacity() + 1 : 0;
+}
+
+size_t LedgerBytes(const cqspc::ResourceLedger& ledger) {
+    return ledger.size() * (sizeof(cqspc::LedgerMap::value_type) + map_node_overhead);
+}
+
+size_t HeapBytes(const cqspc::Name& name) { return StringBytes(name.name); }
+size_t HeapBytes(const cqspc::Identifier& identifier) { return StringBytes(identifier.identifier); }
+size_t HeapBytes(const cqspc::ResourceLedger& ledger) { return LedgerBytes(ledger); }
+size_t HeapBytes(const cqspc::DenseLedger& ledger) {
+    return ledger.capacity() * (sizeof(double) + sizeof(uint8_t)) + MapBytes(ledger.GetOverflow());
+}
+size_t HeapBytes(const cqspc::SmallLedger& ledger) {
+    // Small ledgers keep their goods inline until they outgrow it
+    return ledger.heap_capacity() * sizeof(cqspc::SmallLedger::Entry);
+}
+size_t HeapBytes(const cqspc::Recipe& recipe) { return HeapBytes(recipe.input) + HeapBytes(recipe.output); }
+size_t HeapBytes(const cqspc::RecipeCost& cost) { return LedgerBytes(cost.fixed) + LedgerBytes(cost.scaling); }
+size_t HeapBytes(const cqspc::Settlement& settlement) { return VectorBytes(settlement.population); }
+size_t HeapBytes(const cqspc::Habitation& habitation) { return VectorBytes(habitation.settlements); }
+size_t HeapBytes(const cqspc::Industry& industry) { return VectorBytes(industry.industries); }
+size_t HeapBytes(const cqspb::OrbitalSystem& system) { return VectorBytes(system.children); }
+
+size_t HeapBytes(const cqspc::Market& market) {
+    size_t bytes = VectorBytes(market.GetListed()) + market.participants.allocated();
+    for (const auto* columns : {&market.Current(), &market.Last()}) {
+        bytes += VectorBytes(columns->supply) + VectorBytes(columns->demand) + VectorBytes(columns->price) +
+                 VectorBytes(columns->sd_ratio) + MapBytes(columns->overflow);
+    }
+    return bytes;
+}
+
+size_t HeapBytes(const cqspc::TradeMatrix& matrix) {
+    return VectorBytes(matrix.agents) + VectorBytes(matrix.generation) + VectorBytes(matrix.recipe_input) +
+           VectorBytes(matrix.recipe_output) + VectorBytes(matrix.generates) + VectorBytes(matrix.converts) +
+           VectorBytes(matrix.sells_recipe) + VectorBytes(matrix.buys_recipe) + VectorBytes(matrix.unindexed) +
+           VectorBytes(matrix.prices);
+}
+
+size_t HeapBytes(const cqspc::MarketHistory& history) {
+    size_t bytes = VectorBytes(history.gdp) + VectorBytes(history.total_volume);
+    for (const auto* map : {&history.price_history, &history.sd_ratio, &history.supply, &history.demand,
+                            &history.volume}) {
+        bytes += MapBytes(*map);
+        for (const auto& [good, values] : *map) {
+            bytes += VectorBytes(values);
+        }
+    }
+    return bytes;
+}
+
+/// <summary>
+/// What is known about a component type, to measure its storage.
+/// </summary>
+struct Accountant {
+    size_t component_size = 0;
+    size_t (*heap_bytes)(entt::registry& registry) = nullptr;
+};
+
+// Components that don't allocate any memory themselves
+template <typename Component>
+Accountant Shallow() {
+    return Accountant {std::is_empty_v<Component> ? 0 : sizeof(Component), nullptr};
+}
+
+// Components that allocate memory, that is measured with HeapBytes
+template <typename Component>
+Accountant Deep() {
+    return Accountant {sizeof(Component), [](entt::registry& registry) {
+        size_t bytes = 0;
+        for (auto [entity, component] : registry.view<Component>().each()) {
+            bytes += HeapBytes(component);
+        }
+        return bytes;
+    }};
+}
+
+template <typename Component>
+std::pair<const entt::id_type, Accountant> Entry(Accountant accountant) {
+    return {entt::type_hash<Component>::value(), accountant};
+}
+
+const std::map<entt::id_type, Accountant>& GetAccountants() {
+    static const std::map<entt::id_type, Accountant> accountants {
+        Entry<cqspc::Name>(Deep<cqspc::Name>()),
+        Entry<cqspc::Identifier>(Deep<cqspc::Identifier>()),
+        Entry<cqspc::ResourceStockpile>(Deep<cqspc::ResourceStockpile>()),
+        Entry<cqspc::ResourceGenerator>(Deep<cqspc::ResourceGenerator>()),
+        Entry<cqspc::ResourceConsumption>(Deep<cqspc::ResourceConsumption>()),
+        Entry<cqspc::ResourceDemand>(Deep<cqspc::ResourceDemand>()),
+        Entry<cqspc::CostTable>(Deep<cqspc::CostTable>()),
+        Entry<cqspc::Recipe>(Deep<cqspc::Recipe>()),
+        Entry<cqspc::RecipeCost>(Deep<cqspc::RecipeCost>()),
+        Entry<cqspc::Market>(Deep<cqspc::Market>()),
+        Entry<cqspc::TradeMatrix>(Deep<cqspc::TradeMatrix>()),
+        Entry<cqspc::MarketHistory>(Deep<cqspc::MarketHistory>()),
+        Entry<cqspc::Settlement>(Deep<cqspc::Settlement>()),
+        Entry<cqspc::Habitation>(Deep<cqspc::Habitation>()),
+        Entry<cqspc::Industry>(Deep<cqspc::Industry>()),
+        Entry<cqspb::OrbitalSystem>(Deep<cqspb::OrbitalSystem>()),
+        Entry<cqspc::Wallet>(Shallow<cqspc::Wallet>()),
+        Entry<cqspc::MarketAgent>(Shallow<cqspc::MarketAgent>()),
+        Entry<cqspc::MarketCenter>(Shallow<cqspc::MarketCenter>()),
+        Entry<cqspc::Price>(Shallow<cqspc::Price>()),
+        Entry<cqspc::Employer>(Shallow<cqspc::Employer>()),
+        Entry<cqspc::Employee>(Shallow<cqspc::Employee>()),
+        Entry<cqspc::PopulationSegment>(Shallow<cqspc::PopulationSegment>()),
+        Entry<cqspc::Hunger>(Shallow<cqspc::Hunger>()),
+        Entry<cqspc::FactoryProductivity>(Shallow<cqspc::FactoryProductivity>()),
+        Entry<cqspc::FactoryProducing>(Shallow<cqspc::FactoryProducing>()),
+        Entry<cqspc::ResourceConverter>(Shallow<cqspc::ResourceConverter>()),
+        Entry<cqspc::Good>(Shallow<cqspc::Good>()),
+        Entry<cqspc::Factory>(Shallow<cqspc::Factory>()),
+        Entry<cqspc::Mine>(Shallow<cqspc::Mine>()),
+        Entry<cqspc::Farm>(Shallow<cqspc::Farm>()),
+        Entry<cqspc::RawResourceGen>(Shallow<cqspc::RawResourceGen>()),
+        Entry<cqspb::Body>(Shallow<cqspb::Body>()),
+        Entry<cqspt::Orbit>(Shallow<cqspt::Orbit>()),
+        Entry<cqspt::Kinematics>(Shallow<cqspt::Kinematics>()),
+    };
+    return accountants;
+}
+
+std::string GetComponentName(const entt::sparse_set& storage) {
+    std::string name(storage.type().name());
+    // The namespaces are the same for most components, and only make the table harder to read
+    for (std::string_view prefix : {"cqsp::common::components::", "struct ", "class "}) {
+        size_t position;
+        while ((position = name.find(prefix)) != std::string::npos) {
+            name.erase(position, prefix.size());
+        }
+    }
+    return name;
+}
+
+std::string FormatBytes(double bytes) {
+    if (std::abs(bytes) >= 1024 * 1024) {
+        return fmt::format("{:.1f} MiB", bytes / (1024 * 1024));
+    }
+    if (std::abs(bytes) >= 1024) {
+        return fmt::format("{:.1f} KiB", bytes / 1024);
+    }
+    return fmt::format("{} B", bytes);
+}
+}  // namespace
+
+MemoryReport MemoryTracker::Sample(entt::registry& registry) {
+    MemoryReport report;
+
+    // The entity identifiers themselves
+    ComponentMemory entities;
+    entities.name = "entities";
+    entities.entities = registry.alive();
+    entities.storage_bytes = registry.size() * sizeof(entt::entity);
+    entities.known = true;
+    report.components.push_back(entities);
+
+    const auto& accountants = GetAccountants();
+    for (auto [id, storage] : registry.storage()) {
+        ComponentMemory memory;
+        memory.name = GetComponentName(storage);
+        memory.entities = storage.size();
+        // The packed array of entities, and the sparse array
+        memory.storage_bytes = (storage.capacity() + storage.extent()) * sizeof(entt::entity);
+        if (auto it = accountants.find(id); it != accountants.end()) {
+            memory.known = true;
+            memory.storage_bytes += storage.capacity() * it->second.component_size;
+            if (it->second.heap_bytes != nullptr) {
+                memory.heap_bytes = it->second.heap_bytes(registry);
+            }
+        }
+        report.components.push_back(memory);
+    }
+
+    for (ComponentMemory& memory : report.components) {
+        if (auto it = last_totals.find(memory.name); it != last_totals.end()) {
+            memory.growth = static_cast<int64_t>(memory.GetTotal()) - static_cast<int64_t>(it->second);
+        }
+        last_totals[memory.name] = memory.GetTotal();
+        report.storage_bytes += memory.storage_bytes;
+        report.heap_bytes += memory.heap_bytes;
+        report.growth += memory.growth;
+    }
+
+    std::sort(report.components.begin(), report.components.end(),
+              [](const ComponentMemory& a, const ComponentMemory& b) { return a.GetTotal() > b.GetTotal(); });
+    return report;
+}
+
+std::vector<std::string> MemoryReport::Format(size_t max_rows) const {
+    std::vector<std::string> lines;
+    lines.push_back(fmt::format("{:<40} {:>10} {:>12} {:>12} {:>12}", "Component", "Entities", "Storage", "Heap",
+                                "Growth"));
+    for (size_t i = 0; i < components.size() && i < max_rows; i++) {
+        const ComponentMemory& memory = components[i];
+        // The size of unknown components isn't counted, so mark them
+        lines.push_back(fmt::format("{:<40} {:>10} {:>12} {:>12} {:>12}", memory.name + (memory.known ? "" : "*"),
+                                    memory.entities, FormatBytes(memory.storage_bytes),
+                                    FormatBytes(memory.heap_bytes), FormatBytes(memory.growth)));
+    }
+    if (components.size() > max_rows) {
+        lines.push_back(fmt::format("... and {} more", components.size() - max_rows));
+    }
+    lines.push_back(fmt::format("{:<40} {:>10} {:>12} {:>12} {:>12}", "Total", "", FormatBytes(storage_bytes),
+                                FormatBytes(heap_bytes), FormatBytes(growth)));
+    return lines;
+}
+}  // namespace cqsp::common::systems::memory
@@ -0,0 +1,90 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+namespace cqsp {
+namespace common {
+namespace systems {
+namespace memory {
+/// <summary>
+/// How much memory the storage of a component type uses.
+/// </summary>
+struct ComponentMemory {
+    std::string name;
+    size_t entities = 0;
+    /// <summary>
+    /// The sparse set, and the components themselves if the size of the component is known.
+    /// </summary>
+    size_t storage_bytes = 0;
+    /// <summary>
+    /// Memory that the components allocate themselves, such as map nodes, vectors and strings.
+    /// </summary>
+    size_t heap_bytes = 0;
+    /// <summary>
+    /// Change in storage and heap bytes since the last sample.
+    /// </summary>
+    int64_t growth = 0;
+    /// <summary>
+    /// If the size of the component is known. If it isn't, only the sparse set is counted.
+    /// </summary>
+    bool known = false;
+
+    size_t GetTotal() const { return storage_bytes + heap_bytes; }
+};
+
+/// <summary>
+/// Memory of every component storage in the universe, from largest to smallest.
+/// </summary>
+struct MemoryReport {
+    std::vector<ComponentMemory> components;
+    size_t storage_bytes = 0;
+    size_t heap_bytes = 0;
+    int64_t growth = 0;
+
+    /// <summary>
+    /// Formats the report as a table, with up to `max_rows` components.
+    /// </summary>
+    std::vector<std::string> Format(size_t max_rows = std::numeric_limits<size_t>::max()) const;
+};
+
+/// <summary>
+/// Walks all the component storages of the registry, and estimates how much memory they use.
+/// </summary>
+/// Heap memory is estimated from the sizes of the containers, assuming that a map node has three pointers
+/// and a color on top of its value, so it is not exact, but it is good enough to see where the memory goes.
+class MemoryTracker {
+ public:
+    /// <summary>
+    /// Measures the memory of the registry, and how much it grew since the previous sample.
+    /// </summary>
+    MemoryReport Sample(entt::registry& registry);
+
+ private:
+    std::map<std::string, size_t> last_totals;
+};
+}  // namespace memory
+}  // namespace systems
+}  // namespace common
+}  // namespace cqsp
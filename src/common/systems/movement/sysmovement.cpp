@@ -28,6 +28,13 @@ void SysOrbit::DoSystem() {
     ParseOrbitTree(entt::null, universe.sun);
 }
 
+void SysOrbit::DeclareAccess(ComponentAccess& access) {
+    namespace cqspc = cqsp::common::components;
+    namespace cqspt = cqsp::common::components::types;
+    access.Read<cqspc::bodies::Body>();
+    access.Write<cqspt::Orbit, cqspt::Kinematics, cqspc::bodies::OrbitalSystem>();
+}
+
 void SysOrbit::ParseOrbitTree(entt::entity parent, entt::entity body) {
     namespace cqspc = cqsp::common::components;
     namespace cqsps = cqsp::common::components::ships;
@@ -109,6 +116,10 @@ int SysSurface::Interval() {
     return 1;
 }
 
+void SysSurface::DeclareAccess(ComponentAccess& access) {
+    access.Read<components::types::SurfaceCoordinate>();
+}
+
 void SysPath::DoSystem() {
     namespace cqspc = cqsp::common::components;
     namespace cqsps = cqsp::common::components::ships;
@@ -125,6 +136,11 @@ void SysPath::DoSystem() {
 
 int SysPath::Interval() { return 1; }
 
+void SysPath::DeclareAccess(ComponentAccess& access) {
+    namespace cqspt = cqsp::common::components::types;
+    access.Read<cqspt::MoveTarget, cqspt::Kinematics, cqspt::Orbit>();
+}
+
 void LeaveSOI(Universe& universe, const entt::entity& body) {
     namespace cqspc = cqsp::common::components;
     namespace cqspb = cqsp::common::components::bodies;
@@ -27,6 +27,7 @@ class SysOrbit : public ISimulationSystem {
  public:
     explicit SysOrbit(Game& game) : ISimulationSystem(game) {}
     void DoSystem() override;
+    void DeclareAccess(ComponentAccess& access) override;
     int Interval() override { return 1; }
 
     void ParseOrbitTree(entt::entity parent, entt::entity body);
@@ -43,6 +44,7 @@ class SysPath : public ISimulationSystem {
  public:
     explicit SysPath(Game& game) : ISimulationSystem(game) {}
     void DoSystem();
+    void DeclareAccess(ComponentAccess& access) override;
     int Interval();
 };
 
@@ -50,6 +52,7 @@ class SysSurface : public ISimulationSystem {
  public:
     explicit SysSurface(Game& game) : ISimulationSystem(game) {}
     void DoSystem();
+    void DeclareAccess(ComponentAccess& access) override;
     int Interval();
 };
 }  // namespace systems
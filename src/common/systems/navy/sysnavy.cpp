@@ -26,3 +26,5 @@
 
 void cqsp::common::systems::SysNavyControl::DoSystem() { cqsp::common::Universe &universe = GetUniverse(); }
 
+void cqsp::common::systems::SysNavyControl::DeclareAccess(ComponentAccess& access) {}
+
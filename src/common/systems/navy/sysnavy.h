@@ -25,6 +25,7 @@ class SysNavyControl : public ISimulationSystem {
  public:
     explicit SysNavyControl(Game& game) : ISimulationSystem(game) {}
     void DoSystem()override;
+    void DeclareAccess(ComponentAccess& access) override;
     int Interval() override { return 1; }
 };
 }  // namespace systems
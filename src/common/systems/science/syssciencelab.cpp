@@ -22,6 +22,9 @@ void cqsp::common::systems::SysScienceLab::DoSystem() {
     auto view = GetUniverse().view<components::science::Lab>();
     // Add to the science
     for (entt::entity entity : view) {
+        if (!InSlice(entity)) {
+            continue;
+        }
         // Add to the scientific progress of the area, I guess
         auto& lab = GetUniverse().get<components::science::Lab>(entity);
         // Progress the science, I guess
@@ -33,3 +36,8 @@ void cqsp::common::systems::SysScienceLab::DoSystem() {
         // If the research is done, then research tech
     }
 }
+
+void cqsp::common::systems::SysScienceLab::DeclareAccess(ComponentAccess& access) {
+    access.Read<components::science::Lab>();
+    access.Write<components::science::ScientificProgress>();
+}
@@ -25,7 +25,9 @@ class SysScienceLab : public ISimulationSystem {
  public:
     explicit SysScienceLab(Game& game) : ISimulationSystem(game) {}
     void DoSystem()override;
+    void DeclareAccess(ComponentAccess& access) override;
     int Interval() override { return 25; }
+    bool CanSlice() override { return true; }
 };
 }  // namespace systems
 }  // namespace common
@@ -16,17 +16,20 @@
 */
 #include "common/systems/science/systechnology.h"
 
-#include <vector>
-
 #include "common/components/science.h"
 #include "common/systems/science/technology.h"
+#include "common/util/tickarena.h"
 
 void cqsp::common::systems::SysTechProgress::DoSystem() {
     auto field = GetUniverse().view<components::science::ScientificResearch>();
+    auto completed_techs = util::MakeTickVector<entt::entity>();
 
     for (entt::entity entity : field) {
+        if (!InSlice(entity)) {
+            continue;
+        }
         auto& research = GetUniverse().get<components::science::ScientificResearch>(entity);
-        std::vector<entt::entity> completed_techs;
+        completed_techs.clear();
         for (auto& res : research.current_research) {
             res.second += Interval();
             // Get the research amount
@@ -42,3 +45,9 @@ void cqsp::common::systems::SysTechProgress::DoSystem() {
         }
     }
 }
+
+void cqsp::common::systems::SysTechProgress::DeclareAccess(ComponentAccess& access) {
+    namespace cqspcs = cqsp::common::components::science;
+    access.Read<cqspcs::Technology>();
+    access.Write<cqspcs::ScientificResearch, cqspcs::TechnologicalProgress>();
+}
@@ -23,6 +23,8 @@ class SysTechProgress : public ISimulationSystem {
  public:
     explicit SysTechProgress(Game& game) : ISimulationSystem(game) {}
     void DoSystem() override;
+    void DeclareAccess(ComponentAccess& access) override;
     int Interval() override { return 25; }
+    bool CanSlice() override { return true; }
 };
 }  // namespace cqsp::common::systems
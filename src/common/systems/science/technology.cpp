@@ -54,7 +54,7 @@ void LoadTechnologies(Universe& universe, Hjson::Value& value) {
         // Verify if the tags exist
         tech.difficulty = element["difficulty"];
 
-        universe.technologies[universe.get<components::Identifier>(entity)] = entity;
+        universe.technologies[universe.get<components::Identifier>(entity).identifier] = entity;
     }
 }
 
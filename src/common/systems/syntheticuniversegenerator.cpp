@@ -0,0 +1,232 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "common/systems/syntheticuniversegenerator.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <string>
+
+#include "common/components/area.h"
+#include "common/components/bodies.h"
+#include "common/components/coordinates.h"
+#include "common/components/economy.h"
+#include "common/components/name.h"
+#include "common/components/organizations.h"
+#include "common/components/population.h"
+#include "common/components/resource.h"
+#include "common/components/surface.h"
+#include "common/systems/actions/cityactions.h"
+#include "common/systems/actions/factoryconstructaction.h"
+#include "common/systems/economy/markethelpers.h"
+
+namespace cqsp::common::systems::universegenerator {
+namespace cqspc = cqsp::common::components;
+namespace cqspb = cqsp::common::components::bodies;
+namespace cqspt = cqsp::common::components::types;
+
+SyntheticUniverseOptions SyntheticUniverseOptions::Scaled(int scale) {
+    SyntheticUniverseOptions options;
+    options.star_systems *= scale;
+    options.markets *= scale;
+    options.cities *= scale;
+    return options;
+}
+
+void SyntheticUniverseGenerator::Generate(cqsp::common::Universe& universe) {
+    GenerateGoods(universe);
+    GenerateStarSystems(universe);
+    GenerateMarkets(universe);
+    for (int i = 0; i < options.cities; i++) {
+        GenerateCity(universe, markets[i % markets.size()], i);
+    }
+}
+
+entt::entity SyntheticUniverseGenerator::CreateGood(cqsp::common::Universe& universe,
+                                                   const std::string& identifier, double price) {
+    entt::entity good = universe.create();
+    universe.emplace<cqspc::Good>(good);
+    universe.emplace<cqspc::Price>(good, price);
+    universe.emplace<cqspc::Identifier>(good, identifier);
+    universe.emplace<cqspc::Name>(good, identifier);
+    universe.goods[identifier] = good;
+    universe.good_index.Add(good);
+    return good;
+}
+
+void SyntheticUniverseGenerator::GenerateGoods(cqsp::common::Universe& universe) {
+    for (int i = 0; i < options.raw_goods; i++) {
+        raw_goods.push_back(CreateGood(universe, fmt::format("raw_{}", i), 1 + i % 3));
+    }
+    CreateGood(universe, "food", 1);
+    entt::entity consumer_good = CreateGood(universe, "consumer_good", 20);
+
+    // Every manufactured good is made out of two raw goods
+    std::vector<entt::entity> manufactured;
+    for (int i = 0; i < options.manufactured_goods; i++) {
+        std::string identifier = fmt::format("manufactured_{}", i);
+        entt::entity good = CreateGood(universe, identifier, 5);
+        manufactured.push_back(good);
+
+        entt::entity recipe = universe.create();
+        auto& rec = universe.emplace<cqspc::Recipe>(recipe);
+        rec.input[raw_goods[i % raw_goods.size()]] = 1;
+        rec.input[raw_goods[(i + 1) % raw_goods.size()]] = 1;
+        rec.output[good] = 1;
+        rec.interval = 1;
+        auto& cost = universe.emplace<cqspc::RecipeCost>(recipe);
+        cost.fixed[raw_goods[0]] = 100;
+        cost.scaling[raw_goods[i % raw_goods.size()]] = 10;
+        universe.emplace<cqspc::Identifier>(recipe, identifier);
+        universe.recipes[identifier] = recipe;
+        recipes.push_back(recipe);
+    }
+
+    // And consumer goods are made out of two manufactured goods
+    if (!manufactured.empty()) {
+        entt::entity recipe = universe.create();
+        auto& rec = universe.emplace<cqspc::Recipe>(recipe);
+        rec.input[manufactured[0]] = 1;
+        rec.input[manufactured[manufactured.size() / 2]] = 1;
+        rec.output[consumer_good] = 1;
+        rec.interval = 1;
+        universe.emplace<cqspc::RecipeCost>(recipe);
+        universe.emplace<cqspc::Identifier>(recipe, "consumer_good");
+        universe.recipes["consumer_good"] = recipe;
+        recipes.push_back(recipe);
+    }
+}
+
+void SyntheticUniverseGenerator::GenerateStarSystems(cqsp::common::Universe& universe) {
+    for (int s = 0; s < options.star_systems; s++) {
+        entt::entity star_system = universe.create();
+        double x = universe.random->GetRandomInt(-1000, 1000);
+        double y = universe.random->GetRandomInt(-1000, 1000);
+        universe.emplace<cqspt::GalacticCoordinate>(star_system, x, y);
+
+        entt::entity star = universe.create();
+        universe.emplace<cqspb::Star>(star);
+        universe.emplace<cqspb::LightEmitter>(star);
+        auto& star_body = universe.emplace<cqspb::Body>(star);
+        star_body.radius = 696340;
+        star_body.mass = 1.989e30;
+        star_body.GM = cqspt::SunMu;
+        star_body.star_system = star_system;
+        auto& star_orbit = universe.emplace<cqspt::Orbit>(star);
+        auto& star_kinematics = universe.emplace<cqspt::Kinematics>(star);
+        universe.emplace<cqspc::Name>(star, fmt::format("Star {}", s));
+        auto& orbital_system = universe.emplace<cqspb::OrbitalSystem>(star);
+        if (s == 0) {
+            universe.sun = star;
+        } else {
+            // SysOrbit only walks the bodies under the sun, so the other stars orbit far out around it
+            star_orbit = cqspt::Orbit(1e12 * s, 0, 0, 0, 0, 0);
+            star_orbit.reference_body = universe.sun;
+            cqspt::UpdatePos(star_kinematics, star_orbit);
+            universe.get<cqspb::OrbitalSystem>(universe.sun).push_back(star);
+        }
+
+        for (int b = 0; b < options.bodies_per_system; b++) {
+            entt::entity planet = universe.create();
+            universe.emplace<cqspb::Planet>(planet);
+            auto& body = universe.emplace<cqspb::Body>(planet);
+            body.radius = 6371;
+            body.mass = 5.972e24;
+            body.GM = 398600;
+            body.star_system = star_system;
+
+            // Spread the planets out from 0.4 to about 30 AU
+            double sma = 6e7 * (b + 1) * (1 + universe.random->GetRandomInt(0, 100) / 100.);
+            double anomaly = universe.random->GetRandomInt(0, 628) / 100.;
+            auto& orbit = universe.emplace<cqspt::Orbit>(planet, sma, 0.01, 0, 0, 0, anomaly);
+            orbit.reference_body = star;
+            body.SOI = cqspb::CalculateSOI(body.mass, star_body.mass, sma);
+            auto& kinematics = universe.emplace<cqspt::Kinematics>(planet);
+            cqspt::UpdatePos(kinematics, orbit);
+
+            universe.emplace<cqspc::Name>(planet, fmt::format("Planet {}-{}", s, b));
+            universe.emplace<cqspc::Habitation>(planet);
+            orbital_system.push_back(planet);
+            planets.push_back(planet);
+        }
+    }
+}
+
+void SyntheticUniverseGenerator::GenerateMarkets(cqsp::common::Universe& universe) {
+    // Every market needs its own planet
+    int market_count = std::clamp(options.markets, 1, std::max(1, static_cast<int>(planets.size())));
+    auto goods = universe.view<cqspc::Good, cqspc::Price>();
+    for (int i = 0; i < market_count; i++) {
+        entt::entity market_entity = economy::CreateMarket(universe);
+        auto& market = universe.get<cqspc::Market>(market_entity);
+        for (entt::entity good : goods) {
+            market[good].price = universe.get<cqspc::Price>(good);
+        }
+        if (i < static_cast<int>(planets.size())) {
+            universe.emplace<cqspc::MarketCenter>(planets[i], market_entity);
+        }
+        markets.push_back(market_entity);
+    }
+}
+
+void SyntheticUniverseGenerator::GenerateCity(cqsp::common::Universe& universe, entt::entity market, int index) {
+    namespace cqspa = cqsp::common::systems::actions;
+    // Put the city on the planet that the market is on
+    size_t market_index = std::find(markets.begin(), markets.end(), market) - markets.begin();
+    entt::entity planet = planets[market_index % planets.size()];
+    // The starting money of the agents
+    const uint32_t epoch = cqspc::Wallet::GetEpoch(universe.date);
+
+    double latitude = universe.random->GetRandomInt(-90, 90);
+    double longitude = universe.random->GetRandomInt(-180, 180);
+    entt::entity city = cqsp::common::actions::CreateCity(universe, planet, latitude, longitude);
+    universe.emplace<cqspc::Name>(city, fmt::format("City {}", index));
+    universe.emplace<cqspc::Industry>(city);
+
+    for (int i = 0; i < options.segments_per_city; i++) {
+        entt::entity segment = universe.create();
+        uint64_t population = 100000 + universe.random->GetRandomInt(0, 10000000);
+        universe.emplace<cqspc::PopulationSegment>(segment, population);
+        universe.emplace<cqspc::ResourceStockpile>(segment);
+        universe.emplace<cqspc::Employee>(segment);
+        universe.get<cqspc::Settlement>(city).population.push_back(segment);
+        economy::AddParticipant(universe, market, segment);
+        universe.get<cqspc::Wallet>(segment).Add(1000000, epoch);
+    }
+
+    for (int i = 0; i < options.factories_per_city && !recipes.empty(); i++) {
+        entt::entity recipe = recipes[(index + i) % recipes.size()];
+        entt::entity factory = cqspa::CreateFactory(universe, city, recipe, 10);
+        universe.emplace<cqspc::FactoryProducing>(factory);
+        economy::AddParticipant(universe, market, factory);
+        universe.get<cqspc::Wallet>(factory).Add(1000000, epoch);
+    }
+
+    for (int i = 0; i < options.mines_per_city && !raw_goods.empty(); i++) {
+        entt::entity good = raw_goods[(index + i) % raw_goods.size()];
+        entt::entity mine = cqspa::CreateMine(universe, city, good, 20, 1);
+        economy::AddParticipant(universe, market, mine);
+        universe.get<cqspc::Wallet>(mine).Add(1000000, epoch);
+    }
+
+    for (int i = 0; i < options.farms_per_city; i++) {
+        entt::entity farm = cqspa::CreateFarm(universe, city, universe.goods["food"], 20, 1);
+        economy::AddParticipant(universe, market, farm);
+        universe.get<cqspc::Wallet>(farm).Add(1000000, epoch);
+    }
+}
+}  // namespace cqsp::common::systems::universegenerator
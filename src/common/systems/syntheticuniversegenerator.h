@@ -0,0 +1,80 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "common/universe.h"
+#include "common/systems/sysuniversegenerator.h"
+
+namespace cqsp {
+namespace common {
+namespace systems {
+namespace universegenerator {
+/// <summary>
+/// How many of each thing the synthetic universe generator creates.
+/// </summary>
+struct SyntheticUniverseOptions {
+    int star_systems = 1;
+    int bodies_per_system = 8;
+    int markets = 1;
+    int cities = 4;
+    int segments_per_city = 2;
+    int factories_per_city = 4;
+    int mines_per_city = 2;
+    int farms_per_city = 1;
+    int raw_goods = 6;
+    int manufactured_goods = 6;
+
+    /// <summary>
+    /// Options for a universe with `scale` times more star systems, markets and cities than the default.
+    /// </summary>
+    static SyntheticUniverseOptions Scaled(int scale);
+};
+
+/// <summary>
+/// Generates a universe with configurable counts of everything without any scripts or data, to test and
+/// benchmark the simulation on universes larger than the default one.
+/// </summary>
+/// The goods and recipes are generated too: raw goods are mined, manufactured goods are made from two
+/// raw goods, and `consumer_good` is made from two manufactured goods. Farms make `food`. Cities are
+/// spread over the markets, and every market is on its own planet. The first star is the sun of the
+/// universe, and the other stars orbit it, so that every body is in the orbit tree.
+class SyntheticUniverseGenerator : public ISysUniverseGenerator {
+ public:
+    explicit SyntheticUniverseGenerator(const SyntheticUniverseOptions& options) : options(options) {}
+    void Generate(cqsp::common::Universe& universe);
+
+ private:
+    void GenerateGoods(cqsp::common::Universe& universe);
+    void GenerateStarSystems(cqsp::common::Universe& universe);
+    void GenerateMarkets(cqsp::common::Universe& universe);
+    void GenerateCity(cqsp::common::Universe& universe, entt::entity market, int index);
+
+    entt::entity CreateGood(cqsp::common::Universe& universe, const std::string& identifier, double price);
+
+    SyntheticUniverseOptions options;
+    std::vector<entt::entity> raw_goods;
+    std::vector<entt::entity> recipes;
+    std::vector<entt::entity> planets;
+    std::vector<entt::entity> markets;
+};
+}  // namespace universegenerator
+}  // namespace systems
+}  // namespace common
+}  // namespace cqsp
@@ -0,0 +1,140 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "common/systems/systemscheduler.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <utility>
+
+using cqsp::common::systems::simulation::SystemScheduler;
+
+/// <summary>
+/// The dependency graph of the systems that are run in a single tick.
+/// </summary>
+struct SystemScheduler::TickGraph {
+    std::vector<int> due;
+    std::vector<std::vector<int>> successors;
+    std::vector<int> remaining_dependencies;
+    int completed = 0;
+
+    std::mutex mutex;
+    std::condition_variable done;
+};
+
+SystemScheduler::SystemScheduler(int thread_count) {
+    if (thread_count > 1) {
+        pool = std::make_unique<util::ThreadPool>(thread_count);
+    }
+}
+
+void SystemScheduler::AddSystem(ISimulationSystem* system, entt::registry& registry, std::string_view name) {
+    ComponentAccess access;
+    system->DeclareAccess(access);
+    access.AssureStorage(registry);
+    system->SetThreadPool(pool.get());
+
+    // The conflict matrix is symmetric, so add to both the new row and the existing rows
+    std::vector<bool> row;
+    for (size_t i = 0; i < accesses.size(); i++) {
+        bool conflict = access.ConflictsWith(accesses[i]);
+        conflicts[i].push_back(conflict);
+        row.push_back(conflict);
+    }
+    row.push_back(true);
+    conflicts.push_back(std::move(row));
+
+    systems.push_back(system);
+    accesses.push_back(std::move(access));
+    SystemTiming timing;
+    timing.name = name;
+    timings.push_back(timing);
+}
+
+std::vector<int> SystemScheduler::GetDueSystems(int date) {
+    std::vector<int> due;
+    for (int i = 0; i < static_cast<int>(systems.size()); i++) {
+        ISimulationSystem* system = systems[i];
+        int interval = system->Interval();
+        if (amortized && interval > 1 && system->CanSlice()) {
+            // Every tick processes the entities in one slice, so every entity is processed
+            // once per interval, the same as if it wasn't sliced
+            system->SetSlice(date % interval, interval);
+            due.push_back(i);
+        } else if (date % interval == 0) {
+            system->SetSlice(0, 1);
+            due.push_back(i);
+        }
+    }
+    return due;
+}
+
+void SystemScheduler::Run(const std::vector<int>& due) {
+    if (pool == nullptr || due.size() <= 1) {
+        for (int index : due) {
+            RunSystem(index);
+        }
+        return;
+    }
+
+    auto graph = std::make_shared<TickGraph>();
+    graph->due = due;
+    graph->successors.resize(due.size());
+    graph->remaining_dependencies.resize(due.size(), 0);
+    for (size_t second = 0; second < due.size(); second++) {
+        for (size_t first = 0; first < second; first++) {
+            if (Conflicts(due[first], due[second])) {
+                graph->successors[first].push_back(static_cast<int>(second));
+                graph->remaining_dependencies[second]++;
+            }
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(graph->mutex);
+    for (size_t node = 0; node < due.size(); node++) {
+        if (graph->remaining_dependencies[node] == 0) {
+            Launch(graph, static_cast<int>(node));
+        }
+    }
+    graph->done.wait(lock, [&]() { return graph->completed == static_cast<int>(due.size()); });
+}
+
+void SystemScheduler::RunSystem(int index) {
+    auto start = std::chrono::high_resolution_clock::now();
+    systems[index]->DoSystem();
+    auto end = std::chrono::high_resolution_clock::now();
+
+    SystemTiming& timing = timings[index];
+    timing.last_time = std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    timing.total_time += timing.last_time;
+    timing.run_count++;
+}
+
+void SystemScheduler::Launch(std::shared_ptr<TickGraph> graph, int node) {
+    pool->Submit([this, graph, node]() {
+        RunSystem(graph->due[node]);
+
+        std::lock_guard<std::mutex> lock(graph->mutex);
+        for (int successor : graph->successors[node]) {
+            if (--graph->remaining_dependencies[successor] == 0) {
+                Launch(graph, successor);
+            }
+        }
+        graph->completed++;
+        graph->done.notify_all();
+    });
+}
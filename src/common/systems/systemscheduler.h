@@ -0,0 +1,101 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "common/systems/componentaccess.h"
+#include "common/systems/isimulationsystem.h"
+#include "common/util/threadpool.h"
+
+namespace cqsp {
+namespace common {
+namespace systems {
+namespace simulation {
+/// <summary>
+/// How long a system has taken to run, in microseconds.
+/// </summary>
+struct SystemTiming {
+    std::string name;
+    int run_count = 0;
+    int64_t last_time = 0;
+    int64_t total_time = 0;
+};
+
+/// <summary>
+/// Runs simulation systems, running the ones that don't touch the same components in parallel.
+/// </summary>
+/// Every system declares the components it reads and writes through `ISimulationSystem::DeclareAccess`.
+/// When systems are run, a dependency graph is built from the systems that are due, where a system
+/// depends on every system added before it that it conflicts with. Systems are then run on a worker
+/// pool as soon as all of the systems they depend on are complete, so the result is the same as
+/// running all of them in the order they were added.
+class SystemScheduler {
+ public:
+    /// <summary>
+    /// If thread_count is less than 2, all the systems are run serially on the calling thread.
+    /// </summary>
+    explicit SystemScheduler(int thread_count);
+
+    void AddSystem(ISimulationSystem* system, entt::registry& registry, std::string_view name);
+
+    /// <summary>
+    /// Gets the systems that have to run on this date, and sets the slice they will process.
+    /// </summary>
+    /// When amortized, systems that can be sliced are run every tick on one slice of their entities,
+    /// instead of on all their entities when the date is a multiple of their interval.
+    std::vector<int> GetDueSystems(int date);
+
+    /// <summary>
+    /// Runs the systems at the given indices, and waits for all of them to complete.
+    /// </summary>
+    /// <param name="due">Indices of the systems to run, in the order they were added</param>
+    void Run(const std::vector<int>& due);
+
+    bool Conflicts(int first, int second) const { return conflicts[first][second]; }
+
+    int GetThreadCount() const { return pool == nullptr ? 1 : pool->GetThreadCount(); }
+
+    const std::vector<SystemTiming>& GetTimings() const { return timings; }
+
+    void SetAmortized(bool amortize) { amortized = amortize; }
+    bool IsAmortized() const { return amortized; }
+
+ private:
+    struct TickGraph;
+
+    void RunSystem(int index);
+    void Launch(std::shared_ptr<TickGraph> graph, int node);
+
+    std::vector<ISimulationSystem*> systems;
+    std::vector<ComponentAccess> accesses;
+    std::vector<std::vector<bool>> conflicts;
+    // Each system is only run once per tick, so every system writes to its own timing
+    std::vector<SystemTiming> timings;
+    std::unique_ptr<util::ThreadPool> pool;
+    bool amortized = false;
+};
+}  // namespace simulation
+}  // namespace systems
+}  // namespace common
+}  // namespace cqsp
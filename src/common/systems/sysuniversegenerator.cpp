@@ -39,17 +39,28 @@
 #include "actions/shiplaunchaction.h"
 
 namespace cqsp::common::systems::universegenerator {
+namespace {
+// Scripts index the tables by identifier, so they are copied into lua tables
+sol::table ToTable(cqsp::scripting::ScriptInterface& script_engine, const util::IdentifierTable& identifiers) {
+    sol::table table = script_engine.create_table();
+    for (const auto& [identifier, entity] : identifiers) {
+        table[identifier] = entity;
+    }
+    return table;
+}
+}  // namespace
+
 void ScriptUniverseGenerator::Generate(cqsp::common::Universe& universe) {
     namespace cqspb = cqsp::common::components::bodies;
     namespace cqsps = cqsp::common::components::ships;
     namespace cqspt = cqsp::common::components::types;
     namespace cqspc = cqsp::common::components;
 
-    script_engine["goods"] = universe.goods;
-    script_engine["recipes"] = universe.recipes;
+    script_engine["goods"] = ToTable(script_engine, universe.goods);
+    script_engine["recipes"] = ToTable(script_engine, universe.recipes);
     script_engine["terrain_colors"] = universe.terrain_data;
-    script_engine["fields"] = universe.fields;
-    script_engine["technologies"] = universe.technologies;
+    script_engine["fields"] = ToTable(script_engine, universe.fields);
+    script_engine["technologies"] = ToTable(script_engine, universe.technologies);
 
     // Create player
     auto player = universe.create();
@@ -19,7 +19,23 @@
 #include <memory>
 
 #include "common/util/random/stdrandom.h"
+#include "common/components/economy.h"
+#include "common/components/resource.h"
+#include "common/systems/economy/economygroups.h"
+#include "common/systems/economy/tradematrix.h"
 
-cqsp::common::Universe::Universe() {
-    random = std::make_unique<cqsp::common::util::StdRandom>(42);
+cqsp::common::Universe::Universe(int seed) {
+    random = std::make_unique<cqsp::common::util::StdRandom>(seed);
+    systems::economy::RegisterEconomyGroups(*this);
+    systems::economy::RegisterTradeMatrices(*this);
+    on_construct<components::ResourceStockpile>().connect<&Universe::BindStockpile>(*this);
+    on_construct<components::Market>().connect<&Universe::BindMarket>(*this);
+}
+
+void cqsp::common::Universe::BindStockpile(entt::registry& registry, entt::entity entity) {
+    registry.get<components::ResourceStockpile>(entity).Bind(good_index);
+}
+
+void cqsp::common::Universe::BindMarket(entt::registry& registry, entt::entity entity) {
+    registry.get<components::Market>(entity).Bind(good_index);
 }
@@ -16,6 +16,7 @@
 */
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <string>
 #include <memory>
@@ -23,6 +24,9 @@
 #include <entt/entt.hpp>
 
 #include "common/stardate.h"
+#include "common/components/goodindex.h"
+#include "common/components/journal.h"
+#include "common/util/identifiertable.h"
 #include "common/util/random/random.h"
 #include "common/systems/names/namegenerator.h"
 
@@ -30,18 +34,32 @@ namespace cqsp {
 namespace common {
 class Universe : public entt::registry {
  public:
-    Universe();
+    explicit Universe(int seed = default_seed);
+
+    static const int default_seed = 42;
     components::StarDate date;
 
-    std::map<std::string, entt::entity> goods;
-    std::map<std::string, entt::entity> recipes;
+    /// <summary>
+    /// The goods, recipes, fields, technologies and planets by their identifier. Systems that look them up every
+    /// tick should keep a handle to them instead.
+    /// </summary>
+    util::IdentifierTable goods;
+    /// <summary>
+    /// Dense index of the goods, which are added to it when they are loaded.
+    /// </summary>
+    components::GoodIndex good_index;
+    /// <summary>
+    /// The trades of the tick, which are paid into the wallets at the end of the tick.
+    /// </summary>
+    components::Journal journal;
+    util::IdentifierTable recipes;
     std::map<std::string, entt::entity> terrain_data;
     std::map<std::string, systems::names::NameGenerator> name_generators;
-    std::map<std::string, entt::entity> fields;
-    std::map<std::string, entt::entity> technologies;
-    std::map<std::string, entt::entity> planets;
+    util::IdentifierTable fields;
+    util::IdentifierTable technologies;
+    util::IdentifierTable planets;
 
-    entt::entity sun;
+    entt::entity sun = entt::null;
 
     void EnableTick() { to_tick = true; }
     void DisableTick() { to_tick = false; }
@@ -49,7 +67,11 @@ class Universe : public entt::registry {
 
     std::unique_ptr<cqsp::common::util::IRandom> random;
  private:
-    bool to_tick = false;
+    void BindStockpile(entt::registry& registry, entt::entity entity);
+    void BindMarket(entt::registry& registry, entt::entity entity);
+
+    // Set by the client and cleared by the simulation, which can be on different threads
+    std::atomic<bool> to_tick = false;
 };
 }  // namespace common
 }  // namespace cqsp
@@ -0,0 +1,106 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "common/universesnapshot.h"
+
+#include <type_traits>
+
+#include "common/components/area.h"
+#include "common/components/bodies.h"
+#include "common/components/coordinates.h"
+#include "common/components/economy.h"
+#include "common/components/infrastructure.h"
+#include "common/components/name.h"
+#include "common/components/organizations.h"
+#include "common/components/player.h"
+#include "common/components/population.h"
+#include "common/components/resource.h"
+#include "common/components/science.h"
+#include "common/components/ships.h"
+#include "common/components/surface.h"
+
+namespace cqsp::common {
+namespace {
+template <typename Component>
+void CopyComponent(Universe& universe, entt::registry& registry) {
+    auto view = universe.view<Component>();
+    registry.storage<Component>().reserve(view.size());
+    for (entt::entity entity : view) {
+        if constexpr (std::is_empty_v<Component>) {
+            registry.emplace<Component>(entity);
+        } else {
+            registry.emplace<Component>(entity, view.template get<Component>(entity));
+        }
+    }
+}
+}  // namespace
+
+std::shared_ptr<const UniverseSnapshot> TakeSnapshot(Universe& universe) {
+    namespace cqspc = cqsp::common::components;
+    auto snapshot = std::make_shared<UniverseSnapshot>();
+    snapshot->date = universe.date;
+    // Every entity keeps the same id as in the universe, including the ones without any copied component, so that
+    // the entities that components refer to, like the industries of a city, can always be looked up in the snapshot
+    universe.each([&](entt::entity entity) { snapshot->registry.create(entity); });
+    CopyComponent<cqspc::types::Kinematics>(universe, snapshot->registry);
+    CopyComponent<cqspc::types::Orbit>(universe, snapshot->registry);
+    CopyComponent<cqspc::Market>(universe, snapshot->registry);
+    CopyComponent<cqspc::Wallet>(universe, snapshot->registry);
+    CopyComponent<cqspc::PopulationSegment>(universe, snapshot->registry);
+    CopyComponent<cqspc::Name>(universe, snapshot->registry);
+    CopyComponent<cqspc::Identifier>(universe, snapshot->registry);
+    // Star system view
+    CopyComponent<cqspc::bodies::Body>(universe, snapshot->registry);
+    CopyComponent<cqspc::bodies::LightEmitter>(universe, snapshot->registry);
+    CopyComponent<cqspc::bodies::OrbitalSystem>(universe, snapshot->registry);
+    CopyComponent<cqspc::ships::Ship>(universe, snapshot->registry);
+    CopyComponent<cqspc::Habitation>(universe, snapshot->registry);
+    CopyComponent<cqspc::types::SurfaceCoordinate>(universe, snapshot->registry);
+    CopyComponent<cqspc::bodies::Star>(universe, snapshot->registry);
+    CopyComponent<cqspc::bodies::Planet>(universe, snapshot->registry);
+    CopyComponent<cqspc::bodies::Terrain>(universe, snapshot->registry);
+    CopyComponent<cqspc::bodies::TerrainData>(universe, snapshot->registry);
+    // Planet viewer and market window
+    CopyComponent<cqspc::Settlement>(universe, snapshot->registry);
+    CopyComponent<cqspc::Industry>(universe, snapshot->registry);
+    CopyComponent<cqspc::Factory>(universe, snapshot->registry);
+    CopyComponent<cqspc::Mine>(universe, snapshot->registry);
+    CopyComponent<cqspc::Farm>(universe, snapshot->registry);
+    CopyComponent<cqspc::MarketCenter>(universe, snapshot->registry);
+    CopyComponent<cqspc::Employee>(universe, snapshot->registry);
+    CopyComponent<cqspc::Hunger>(universe, snapshot->registry);
+    CopyComponent<cqspc::ResourceStockpile>(universe, snapshot->registry);
+    CopyComponent<cqspc::ResourceGenerator>(universe, snapshot->registry);
+    CopyComponent<cqspc::ResourceConverter>(universe, snapshot->registry);
+    CopyComponent<cqspc::FactoryProductivity>(universe, snapshot->registry);
+    CopyComponent<cqspc::Recipe>(universe, snapshot->registry);
+    CopyComponent<cqspc::RecipeCost>(universe, snapshot->registry);
+    CopyComponent<cqspc::infrastructure::SpacePort>(universe, snapshot->registry);
+    CopyComponent<cqspc::infrastructure::CityPower>(universe, snapshot->registry);
+    CopyComponent<cqspc::infrastructure::PowerPlant>(universe, snapshot->registry);
+    CopyComponent<cqspc::infrastructure::BrownOut>(universe, snapshot->registry);
+    CopyComponent<cqspc::science::Lab>(universe, snapshot->registry);
+    // Civilization and technology panels
+    CopyComponent<cqspc::Civilization>(universe, snapshot->registry);
+    CopyComponent<cqspc::Organization>(universe, snapshot->registry);
+    CopyComponent<cqspc::Player>(universe, snapshot->registry);
+    CopyComponent<cqspc::Governed>(universe, snapshot->registry);
+    CopyComponent<cqspc::science::TechnologicalProgress>(universe, snapshot->registry);
+    CopyComponent<cqspc::science::ScientificResearch>(universe, snapshot->registry);
+    CopyComponent<cqspc::ships::Fleet>(universe, snapshot->registry);
+    return snapshot;
+}
+}  // namespace cqsp::common
@@ -0,0 +1,47 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <memory>
+
+#include <entt/entt.hpp>
+
+#include "common/stardate.h"
+#include "common/universe.h"
+
+namespace cqsp {
+namespace common {
+/// <summary>
+/// Read only copy of the parts of the universe that the client displays, taken at the end of a tick.
+/// </summary>
+/// The snapshot holds the kinematics, orbits, markets, wallets, population segments and names of the
+/// universe, the bodies, terrain, cities, civilizations, fleets and technologies that the star system view
+/// and the panels display, and the industries, stockpiles, recipes and infrastructure of the cities that the
+/// planet viewer displays. Market histories are not copied, because they grow every tick. Every entity of the
+/// universe is in the snapshot with the same id, so an entity from the universe can be used to get its
+/// components from the snapshot.
+struct UniverseSnapshot {
+    components::StarDate date;
+    entt::registry registry;
+};
+
+/// <summary>
+/// Copies the components in the snapshot from the universe. The universe must not be ticking.
+/// </summary>
+std::shared_ptr<const UniverseSnapshot> TakeSnapshot(Universe& universe);
+}  // namespace common
+}  // namespace cqsp
@@ -0,0 +1,100 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+namespace cqsp::common::util {
+/// <summary>
+/// A set of entities, stored as a sparse set: the entities are packed into an array, and found through an array of
+/// their positions by entity id.
+/// </summary>
+/// Iterating over the set is a walk over a contiguous array, and adding, removing and finding entities take constant
+/// time. Removing an entity moves the last entity into its place, so the entities aren't kept in any order.
+class EntitySet {
+ public:
+    /// <returns>if the entity wasn't already in the set</returns>
+    bool insert(entt::entity entity) {
+        if (contains(entity)) {
+            return false;
+        }
+        const auto id = static_cast<size_t>(entt::to_entity(entity));
+        if (id >= positions.size()) {
+            positions.resize(id + 1, none);
+        }
+        if (positions[id] != none) {
+            // An older version of the entity, which has been destroyed, is replaced
+            entities[positions[id]] = entity;
+            return true;
+        }
+        positions[id] = static_cast<uint32_t>(entities.size());
+        entities.push_back(entity);
+        return true;
+    }
+
+    /// <returns>if the entity was in the set</returns>
+    bool erase(entt::entity entity) {
+        if (!contains(entity)) {
+            return false;
+        }
+        const auto id = static_cast<size_t>(entt::to_entity(entity));
+        const uint32_t position = positions[id];
+        entities[position] = entities.back();
+        positions[static_cast<size_t>(entt::to_entity(entities[position]))] = position;
+        entities.pop_back();
+        positions[id] = none;
+        return true;
+    }
+
+    bool contains(entt::entity entity) const {
+        if (entity == entt::null) {
+            return false;
+        }
+        const auto id = static_cast<size_t>(entt::to_entity(entity));
+        // The entity in the set could be an older version of the entity
+        return id < positions.size() && positions[id] != none && entities[positions[id]] == entity;
+    }
+
+    size_t size() const { return entities.size(); }
+    bool empty() const { return entities.empty(); }
+    void clear() {
+        entities.clear();
+        positions.clear();
+    }
+
+    auto begin() const { return entities.begin(); }
+    auto end() const { return entities.end(); }
+
+    /// <summary>
+    /// How much memory the set has allocated, in bytes.
+    /// </summary>
+    size_t allocated() const {
+        return entities.capacity() * sizeof(entt::entity) + positions.capacity() * sizeof(uint32_t);
+    }
+
+ private:
+    static constexpr uint32_t none = UINT32_MAX;
+
+    std::vector<entt::entity> entities;
+    // The position of every entity in `entities`, by the id of the entity
+    std::vector<uint32_t> positions;
+};
+}  // namespace cqsp::common::util
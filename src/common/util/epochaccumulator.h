@@ -0,0 +1,49 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <cstdint>
+
+namespace cqsp::common::util {
+/// <summary>
+/// A value that is added up over an epoch, such as a tick, and reads as zero once the epoch is over.
+/// </summary>
+/// Instead of being cleared when an epoch ends, the accumulator keeps the epoch that it was last written in, and starts
+/// again from zero when it is written in a later epoch. Nothing has to go through every accumulator at the end of an
+/// epoch, so keeping them costs as much as the accumulators that are written, not as much as the ones that exist.
+template <typename T>
+class EpochAccumulator {
+ public:
+    /// <returns>the value that was added up in the epoch, or zero if nothing was added in it</returns>
+    T Get(uint32_t epoch) const { return stamp == epoch ? value : T(); }
+
+    void Add(uint32_t epoch, const T& amount) {
+        if (stamp != epoch) {
+            value = T();
+            stamp = epoch;
+        }
+        value += amount;
+    }
+
+    /// <returns>the epoch that the accumulator was last written in</returns>
+    uint32_t GetEpoch() const { return stamp; }
+
+ private:
+    T value = T();
+    uint32_t stamp = 0;
+};
+}  // namespace cqsp::common::util
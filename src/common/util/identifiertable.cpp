@@ -0,0 +1,82 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "common/util/identifiertable.h"
+
+#include <functional>
+
+using cqsp::common::util::IdentifierTable;
+
+namespace {
+size_t Hash(std::string_view identifier) { return std::hash<std::string_view>()(identifier); }
+}  // namespace
+
+IdentifierTable::Handle IdentifierTable::Intern(std::string_view identifier) {
+    // Keep the table at most half full, so that probes stay short
+    if ((entries.size() + 1) * 2 > slots.size()) {
+        Rehash(slots.empty() ? 16 : slots.size() * 2);
+    }
+    const size_t slot = FindSlot(identifier, Hash(identifier));
+    if (slots[slot] == none) {
+        slots[slot] = static_cast<int>(entries.size());
+        entries.emplace_back(std::string(identifier), entt::null);
+    }
+    return Handle(slots[slot]);
+}
+
+int IdentifierTable::Lookup(std::string_view identifier) const {
+    if (slots.empty()) {
+        return none;
+    }
+    return slots[FindSlot(identifier, Hash(identifier))];
+}
+
+size_t IdentifierTable::FindSlot(std::string_view identifier, size_t hash) const {
+    const size_t mask = slots.size() - 1;
+    size_t slot = hash & mask;
+    while (slots[slot] != none && entries[slots[slot]].first != identifier) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void IdentifierTable::Rehash(size_t slot_count) {
+    slots.assign(slot_count, none);
+    for (size_t id = 0; id < entries.size(); id++) {
+        slots[FindSlot(entries[id].first, Hash(entries[id].first))] = static_cast<int>(id);
+    }
+}
+
+IdentifierTable::const_iterator IdentifierTable::find(std::string_view identifier) const {
+    const int id = Lookup(identifier);
+    if (id == none || entries[id].second == entt::null) {
+        return end();
+    }
+    return const_iterator(&entries, id);
+}
+
+size_t IdentifierTable::size() const {
+    size_t count = 0;
+    for (const Entry& entry : entries) {
+        count += entry.second != entt::null;
+    }
+    return count;
+}
+
+void IdentifierTable::clear() {
+    entries.clear();
+    slots.clear();
+}
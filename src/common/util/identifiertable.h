@@ -0,0 +1,155 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <entt/entt.hpp>
+
+namespace cqsp::common::util {
+/// <summary>
+/// Maps identifiers, such as the names of goods, to entities, in a flat hash table.
+/// </summary>
+/// Every identifier is given a compact id the first time that it is seen, which can be kept as a `Handle` so
+/// that the entity can be looked up later in constant time, without hashing the identifier again. Handles can
+/// be taken before the identifier is loaded, and then they refer to `entt::null` until it is.
+///
+/// Identifiers that refer to `entt::null` are treated as if they aren't in the table, so it can be used like
+/// the `std::map` that it replaces.
+class IdentifierTable {
+ public:
+    typedef std::pair<std::string, entt::entity> Entry;
+
+    /// <summary>
+    /// A reference to an identifier in the table.
+    /// </summary>
+    class Handle {
+     public:
+        Handle() = default;
+        bool IsValid() const { return id != none; }
+        bool operator==(const Handle& other) const { return id == other.id; }
+        bool operator!=(const Handle& other) const { return id != other.id; }
+
+     private:
+        friend class IdentifierTable;
+        explicit Handle(int id) : id(id) {}
+        int id = none;
+    };
+
+    /// <summary>
+    /// Gets the handle of the identifier, and adds it to the table if it isn't in it yet.
+    /// </summary>
+    Handle Intern(std::string_view identifier);
+
+    /// <returns>the handle of the identifier, or an invalid handle if it isn't in the table</returns>
+    Handle GetHandle(std::string_view identifier) const { return Handle(Lookup(identifier)); }
+
+    /// <returns>the entity that the handle refers to, or `entt::null`</returns>
+    entt::entity Get(Handle handle) const {
+        return handle.IsValid() ? entries[handle.id].second : static_cast<entt::entity>(entt::null);
+    }
+    entt::entity operator[](Handle handle) const { return Get(handle); }
+
+    /// <summary>
+    /// The entity of the identifier, which is added to the table if it isn't already, the same as `std::map`.
+    /// Unlike `std::map`, the reference is invalidated when another identifier is added.
+    /// </summary>
+    entt::entity& operator[](std::string_view identifier) { return entries[Intern(identifier).id].second; }
+
+    /// <summary>
+    /// Iterates over the identifiers in the order that they were added, skipping those that refer to
+    /// `entt::null`.
+    /// </summary>
+    class const_iterator {
+     public:
+        using value_type = Entry;
+        using reference = const Entry&;
+        using pointer = const Entry*;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::forward_iterator_tag;
+
+        const_iterator(const std::vector<Entry>* entries, size_t position) : entries(entries), position(position) {
+            SkipNull();
+        }
+
+        reference operator*() const { return (*entries)[position]; }
+        pointer operator->() const { return &(*entries)[position]; }
+
+        const_iterator& operator++() {
+            position++;
+            SkipNull();
+            return *this;
+        }
+
+        const_iterator operator++(int) {
+            const_iterator copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        bool operator==(const const_iterator& other) const { return position == other.position; }
+        bool operator!=(const const_iterator& other) const { return position != other.position; }
+
+     private:
+        void SkipNull() {
+            while (position < entries->size() && (*entries)[position].second == entt::null) {
+                position++;
+            }
+        }
+
+        const std::vector<Entry>* entries;
+        size_t position;
+    };
+
+    const_iterator begin() const { return const_iterator(&entries, 0); }
+    const_iterator end() const { return const_iterator(&entries, entries.size()); }
+
+    const_iterator find(std::string_view identifier) const;
+    bool contains(std::string_view identifier) const { return find(identifier) != end(); }
+
+    /// <summary>
+    /// The number of identifiers that refer to an entity.
+    /// </summary>
+    size_t size() const;
+    bool empty() const { return size() == 0; }
+
+    /// <summary>
+    /// Removes every identifier. Handles that were taken before are invalid after this.
+    /// </summary>
+    void clear();
+
+ private:
+    static constexpr int none = -1;
+
+    /// <returns>the id of the identifier, or `none`</returns>
+    int Lookup(std::string_view identifier) const;
+
+    /// <returns>the slot that the identifier is in, or the empty slot that it would be put in</returns>
+    size_t FindSlot(std::string_view identifier, size_t hash) const;
+
+    void Rehash(size_t slot_count);
+
+    std::vector<Entry> entries;
+    // Open addressing table of the ids of the entries, the size is always a power of two
+    std::vector<int> slots;
+};
+}  // namespace cqsp::common::util
@@ -20,3 +20,4 @@
 
 // Define the thing
 std::map<std::string, int> profiler_information_map;
+std::mutex profiler_information_mutex;
@@ -17,16 +17,22 @@
 #pragma once
 
 #include <map>
+#include <mutex>
 #include <string>
 
 #include <chrono>
 
 extern std::map<std::string, int> profiler_information_map;
+// Blocks are timed on the simulation thread too, so hold this while using the map
+extern std::mutex profiler_information_mutex;
 #define BEGIN_TIMED_BLOCK(NAME) std::chrono::high_resolution_clock::time_point \
                                 block_start_##NAME = std::chrono::high_resolution_clock::now();
 
 #define END_TIMED_BLOCK(NAME) std::chrono::high_resolution_clock::time_point block_end_##NAME = \
                                                 std::chrono::high_resolution_clock::now(); \
-                                profiler_information_map[#NAME] =\
-                                std::chrono::duration_cast<std::chrono::microseconds> \
-                                        (block_end_##NAME - block_start_##NAME).count();
+                                { \
+                                    std::lock_guard<std::mutex> lock_##NAME(profiler_information_mutex); \
+                                    profiler_information_map[#NAME] = \
+                                    std::chrono::duration_cast<std::chrono::microseconds> \
+                                            (block_end_##NAME - block_start_##NAME).count(); \
+                                }
@@ -22,6 +22,9 @@ class IRandom {
     explicit IRandom(int _seed) : seed(_seed) {}
     virtual int GetRandomInt(int, int) = 0;
     virtual int GetRandomNormal(double, double) = 0;
+
+    int GetSeed() const { return seed; }
+
  protected:
     int seed;
 };
@@ -0,0 +1,117 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "common/util/threadpool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+namespace cqsp::common::util {
+ThreadPool::ThreadPool(int thread_count) {
+    for (int i = 0; i < thread_count; i++) {
+        workers.emplace_back([this]() { WorkerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    condition.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::Submit(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push(std::move(task));
+    }
+    condition.notify_one();
+}
+
+namespace {
+/// <summary>
+/// The indices of a ParallelFor that haven't been taken yet, and the ones that have been completed.
+/// </summary>
+struct ParallelForState {
+    explicit ParallelForState(int count, const std::function<void(int)>& task) : count(count), task(task) {}
+
+    // Runs indices until there are none left
+    void Run() {
+        int index;
+        while ((index = next.fetch_add(1)) < count) {
+            task(index);
+            if (completed.fetch_add(1) + 1 == count) {
+                completed.notify_all();
+            }
+        }
+    }
+
+    const int count;
+    // Only called for indices that are taken before the ParallelFor returns
+    const std::function<void(int)>& task;
+    std::atomic<int> next = 0;
+    std::atomic<int> completed = 0;
+};
+}  // namespace
+
+void ThreadPool::ParallelFor(int count, const std::function<void(int)>& task) {
+    if (count <= 0) {
+        return;
+    }
+    auto state = std::make_shared<ParallelForState>(count, task);
+    // Workers that start after every index is taken return straight away
+    int helpers = std::min(count, GetThreadCount() + 1) - 1;
+    for (int i = 0; i < helpers; i++) {
+        Submit([state]() { state->Run(); });
+    }
+    state->Run();
+    for (int done = state->completed.load(); done < count; done = state->completed.load()) {
+        state->completed.wait(done);
+    }
+}
+
+void ParallelFor(ThreadPool* pool, int count, const std::function<void(int)>& task) {
+    if (pool == nullptr || count <= 1) {
+        for (int i = 0; i < count; i++) {
+            task(i);
+        }
+        return;
+    }
+    pool->ParallelFor(count, task);
+}
+
+void ThreadPool::WorkerLoop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this]() { return stopping || !tasks.empty(); });
+            if (stopping && tasks.empty()) {
+                return;
+            }
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
+}  // namespace cqsp::common::util
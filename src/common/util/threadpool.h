@@ -0,0 +1,64 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace cqsp::common::util {
+/// <summary>
+/// A fixed set of worker threads that run tasks off a shared queue.
+/// </summary>
+class ThreadPool {
+ public:
+    explicit ThreadPool(int thread_count);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void Submit(std::function<void()> task);
+
+    /// <summary>
+    /// Runs the task for every index from 0 to count, on the workers and on the calling thread, and returns once
+    /// the task has been run for every index.
+    /// </summary>
+    /// The calling thread takes indices as well, so this can be called from a task that is running on the pool
+    /// without waiting on workers that are busy.
+    void ParallelFor(int count, const std::function<void(int)>& task);
+
+    int GetThreadCount() const { return static_cast<int>(workers.size()); }
+
+ private:
+    void WorkerLoop();
+
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable condition;
+    bool stopping = false;
+};
+
+/// <summary>
+/// Runs the task for every index on the pool, or in order on the calling thread if there is no pool.
+/// </summary>
+void ParallelFor(ThreadPool* pool, int count, const std::function<void(int)>& task);
+}  // namespace cqsp::common::util
@@ -0,0 +1,115 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "common/util/tickarena.h"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace cqsp::common::util {
+namespace {
+std::mutex arenas_mutex;
+// The arenas of every thread, which remove themselves when their thread exits
+std::vector<TickArena*> arenas;
+TickArenaStats last_stats;
+}  // namespace
+
+TickArena::TickArena() {
+    std::lock_guard<std::mutex> lock(arenas_mutex);
+    arenas.push_back(this);
+}
+
+TickArena::~TickArena() {
+    {
+        std::lock_guard<std::mutex> lock(arenas_mutex);
+        arenas.erase(std::remove(arenas.begin(), arenas.end(), this), arenas.end());
+    }
+    for (Block& block : blocks) {
+        ::operator delete(block.memory);
+    }
+}
+
+TickArena& TickArena::Get() {
+    thread_local TickArena arena;
+    return arena;
+}
+
+void TickArena::ResetAll() {
+    std::lock_guard<std::mutex> lock(arenas_mutex);
+    TickArenaStats stats;
+    for (TickArena* arena : arenas) {
+        stats.used += arena->used;
+        stats.block_allocations += arena->block_allocations;
+        arena->Reset();
+        stats.reserved += arena->Reserved();
+    }
+    stats.high_water = std::max(last_stats.high_water, stats.used);
+    last_stats = stats;
+}
+
+TickArenaStats TickArena::GetStats() {
+    std::lock_guard<std::mutex> lock(arenas_mutex);
+    return last_stats;
+}
+
+void TickArena::Reset() {
+    if (blocks.size() > 1) {
+        // Merge the blocks, so that everything fits in the first block next tick
+        size_t total = 0;
+        for (Block& block : blocks) {
+            total += block.size;
+            ::operator delete(block.memory);
+        }
+        blocks.clear();
+        blocks.push_back({static_cast<std::byte*>(::operator new(total)), total});
+    }
+    offset = 0;
+    used = 0;
+    block_allocations = 0;
+}
+
+size_t TickArena::Reserved() const {
+    size_t reserved = 0;
+    for (const Block& block : blocks) {
+        reserved += block.size;
+    }
+    return reserved;
+}
+
+void* TickArena::do_allocate(size_t bytes, size_t alignment) {
+    if (!blocks.empty()) {
+        void* pointer = blocks.back().memory + offset;
+        size_t space = blocks.back().size - offset;
+        if (std::align(alignment, bytes, pointer, space) != nullptr) {
+            offset = blocks.back().size - space + bytes;
+            used += bytes;
+            return pointer;
+        }
+    }
+    // Large enough that the allocation fits, however the block is aligned
+    AddBlock(std::max(bytes + alignment, blocks.empty() ? initial_block_size : blocks.back().size * 2));
+    return do_allocate(bytes, alignment);
+}
+
+void TickArena::AddBlock(size_t size) {
+    blocks.push_back({static_cast<std::byte*>(::operator new(size)), size});
+    offset = 0;
+    block_allocations++;
+}
+}  // namespace cqsp::common::util
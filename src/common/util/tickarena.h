@@ -0,0 +1,108 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace cqsp::common::util {
+/// <summary>
+/// How much memory the tick arenas used.
+/// </summary>
+struct TickArenaStats {
+    // Bytes allocated from the arenas in the last tick
+    size_t used = 0;
+    // The most bytes allocated from the arenas in a single tick
+    size_t high_water = 0;
+    // Bytes that the arenas hold on to between ticks
+    size_t reserved = 0;
+    // Blocks that the arenas had to allocate from the heap in the last tick, which should be 0 once the ticks
+    // are steady. Allocations that fit in the blocks the arenas already have aren't counted
+    size_t block_allocations = 0;
+};
+
+/// <summary>
+/// A monotonic allocator for the scratch data of a tick, which is all freed at once at the end of the tick.
+/// </summary>
+/// Every thread has its own arena, so systems that run in parallel don't share one. Deallocating does nothing,
+/// and the memory is reused after `ResetAll`, which the simulation calls at the end of every tick. When an arena
+/// needs more than one block in a tick, the blocks are merged into one on reset, so the ticks after that don't
+/// allocate at all.
+///
+/// Nothing allocated from an arena may outlive the tick, so containers that use it must not be moved into
+/// components, which would keep the arena's memory.
+class TickArena : public std::pmr::memory_resource {
+ public:
+    TickArena();
+    ~TickArena();
+
+    TickArena(const TickArena&) = delete;
+    TickArena& operator=(const TickArena&) = delete;
+
+    /// <summary>
+    /// The arena of the calling thread.
+    /// </summary>
+    static TickArena& Get();
+
+    /// <summary>
+    /// Frees everything that was allocated from the arenas of every thread. Must only be called between ticks,
+    /// when no system is running.
+    /// </summary>
+    static void ResetAll();
+
+    /// <summary>
+    /// The usage of all the arenas, as of the last `ResetAll`.
+    /// </summary>
+    static TickArenaStats GetStats();
+
+    void Reset();
+
+    size_t Used() const { return used; }
+    size_t Reserved() const;
+
+ private:
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* pointer, size_t bytes, size_t alignment) override {}
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+    void AddBlock(size_t size);
+
+    struct Block {
+        std::byte* memory;
+        size_t size;
+    };
+    static constexpr size_t initial_block_size = 64 * 1024;
+
+    std::vector<Block> blocks;
+    // Position in the last block
+    size_t offset = 0;
+    size_t used = 0;
+    size_t block_allocations = 0;
+};
+
+/// <summary>
+/// A vector for the scratch data of a tick, which allocates from the arena of the thread.
+/// </summary>
+template <typename T>
+using TickVector = std::pmr::vector<T>;
+
+template <typename T>
+TickVector<T> MakeTickVector() {
+    return TickVector<T>(&TickArena::Get());
+}
+}  // namespace cqsp::common::util
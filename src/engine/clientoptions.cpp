@@ -46,6 +46,8 @@ Hjson::Value cqsp::client::ClientOptions::GetDefaultOptions() {
     default_options["icon"] = "icon.png";
     default_options["audio"]["music"] = 1.0f;
     default_options["audio"]["ui"] = 0.80f;
+    // Changes the results of the simulation, so it's off unless asked for, like in cqsp-headless
+    default_options["simulation"]["amortize"] = false;
     return default_options;
 }
 
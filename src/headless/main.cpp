@@ -0,0 +1,216 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include "common/game.h"
+#include "common/simulation.h"
+#include "common/systems/checksum.h"
+#include "common/systems/memoryreport.h"
+#include "common/systems/sysuniversegenerator.h"
+#include "common/util/logging.h"
+#include "common/util/paths.h"
+#include "common/util/tickarena.h"
+#include "headless/packageloader.h"
+
+namespace {
+struct HeadlessOptions {
+    int seed = 42;
+    int ticks = 1000;
+    int memory_interval = 0;
+    bool timings = false;
+    bool amortize = false;
+    std::string record_path;
+    std::string verify_path;
+    std::string data_path;
+};
+
+void PrintHelp() {
+    fmt::print("Usage: cqsp-headless [options]\n"
+               "Runs the Conquer Space simulation without a window.\n\n"
+               "  --seed <n>      Seed of the universe (default 42)\n"
+               "  --ticks <n>     Number of ticks to run (default 1000)\n"
+               "  --timings       Print how long each system took to run, and the memory used by the tick arena\n"
+               "  --amortize      Spread systems that run every n ticks over every tick\n"
+               "  --data <path>   Path to the data folder (default ../data)\n"
+               "  --record <path> Write the checksum of every tick to a file\n"
+               "  --verify <path> Run with the seed and ticks of a recorded file, and report the first tick\n"
+               "                  that has a different checksum. --amortize has to match the recorded run\n"
+               "  --memory <n>    Print the memory used by each component every n ticks, and after the last tick\n"
+               "  --help          Shows this help message\n");
+}
+
+/// Returns false if the program should exit
+bool ParseOptions(int argc, char* argv[], HeadlessOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--seed" && has_value) {
+            options.seed = std::atoi(argv[++i]);
+        } else if (arg == "--ticks" && has_value) {
+            options.ticks = std::atoi(argv[++i]);
+        } else if (arg == "--data" && has_value) {
+            options.data_path = argv[++i];
+        } else if (arg == "--record" && has_value) {
+            options.record_path = argv[++i];
+        } else if (arg == "--verify" && has_value) {
+            options.verify_path = argv[++i];
+        } else if (arg == "--memory" && has_value) {
+            options.memory_interval = std::atoi(argv[++i]);
+        } else if (arg == "--timings") {
+            options.timings = true;
+        } else if (arg == "--amortize") {
+            options.amortize = true;
+        } else if (arg == "--help") {
+            PrintHelp();
+            return false;
+        } else {
+            fmt::print("Unknown option {}\n", arg);
+            PrintHelp();
+            return false;
+        }
+    }
+    return true;
+}
+
+void PrintTimings(const cqsp::common::systems::simulation::Simulation& simulation) {
+    fmt::print("{:<60} {:>8} {:>12} {:>12}\n", "System", "Runs", "Total (ms)", "Average (us)");
+    for (const auto& timing : simulation.GetSystemTimings()) {
+        double average = timing.run_count == 0 ? 0 : static_cast<double>(timing.total_time) / timing.run_count;
+        fmt::print("{:<60} {:>8} {:>12.3f} {:>12.3f}\n", timing.name, timing.run_count,
+                   timing.total_time / 1000., average);
+    }
+    auto arena = cqsp::common::util::TickArena::GetStats();
+    fmt::print("Tick arena: {} bytes used last tick, {} bytes high water, {} bytes reserved, "
+               "{} blocks allocated last tick\n",
+               arena.used, arena.high_water, arena.reserved, arena.block_allocations);
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    HeadlessOptions options;
+    if (!ParseOptions(argc, argv, options)) {
+        return 0;
+    }
+
+    cqsp::common::util::ExePath::exe_path = argv[0];
+    spdlog::set_default_logger(cqsp::common::util::make_logger("headless", true));
+    if (options.data_path.empty()) {
+        options.data_path = cqsp::common::util::GetCqspDataPath();
+    }
+
+    namespace cqspcs = cqsp::common::systems::checksum;
+    cqspcs::ChecksumStream recorded;
+    if (!options.verify_path.empty()) {
+        std::ifstream input(options.verify_path);
+        if (!recorded.Read(input)) {
+            fmt::print("Cannot read checksums from {}\n", options.verify_path);
+            return 1;
+        }
+        if (recorded.amortize != options.amortize) {
+            fmt::print("{} was recorded {} --amortize, run it again {} it\n", options.verify_path,
+                       recorded.amortize ? "with" : "without", recorded.amortize ? "with" : "without");
+            return 1;
+        }
+        // Rerun the recorded run
+        options.seed = recorded.seed;
+        options.ticks = static_cast<int>(recorded.ticks.size());
+    }
+
+    cqsp::common::Game game(options.seed);
+    cqsp::common::Universe& universe = game.GetUniverse();
+
+    // Load the universe
+    std::filesystem::path core_package = std::filesystem::path(options.data_path) / "core";
+    if (!cqsp::headless::LoadPackage(game, core_package)) {
+        fmt::print("Cannot load the core package from {}\n", core_package.string());
+        return 1;
+    }
+    cqsp::headless::RunPackageScripts(game, core_package);
+
+    using cqsp::common::systems::universegenerator::ScriptUniverseGenerator;
+    ScriptUniverseGenerator script_generator(game.GetScriptInterface());
+    script_generator.Generate(universe);
+
+    using cqsp::common::systems::simulation::Simulation;
+    Simulation simulation(game);
+    simulation.SetAmortized(options.amortize);
+
+    cqspcs::ChecksumStream recording;
+    recording.seed = options.seed;
+    recording.amortize = options.amortize;
+    cqspcs::ChecksumVerifier verifier(recorded);
+    cqsp::common::systems::memory::MemoryTracker memory_tracker;
+    auto print_memory = [&]() {
+        fmt::print("Memory on date {}\n", universe.date.GetDate());
+        for (const std::string& line : memory_tracker.Sample(universe).Format()) {
+            fmt::print("{}\n", line);
+        }
+    };
+
+    auto start = std::chrono::high_resolution_clock::now();
+    // Fewer than the requested ticks are run if the verifier stops the run early
+    int ticks_run = 0;
+    for (int i = 0; i < options.ticks; i++) {
+        simulation.tick();
+        ticks_run++;
+        if (!options.record_path.empty()) {
+            recording.Record(universe);
+        }
+        if (!options.verify_path.empty() && !verifier.Verify(universe)) {
+            break;
+        }
+        // The last tick is printed after the timings
+        if (options.memory_interval > 0 && (i + 1) % options.memory_interval == 0 && i + 1 < options.ticks) {
+            print_memory();
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double seconds = std::chrono::duration<double>(end - start).count();
+    fmt::print("Ran {} ticks with seed {} in {:.3f} s ({:.1f} ticks/s)\n", ticks_run, options.seed, seconds,
+               seconds > 0 ? ticks_run / seconds : 0.);
+    if (options.timings) {
+        PrintTimings(simulation);
+    }
+    if (options.memory_interval > 0) {
+        print_memory();
+    }
+
+    if (!options.record_path.empty()) {
+        std::ofstream output(options.record_path);
+        recording.Write(output);
+        fmt::print("Wrote {} checksums to {}\n", recording.ticks.size(), options.record_path);
+    }
+    if (!options.verify_path.empty()) {
+        if (verifier.GetDivergence().has_value()) {
+            const auto& divergence = *verifier.GetDivergence();
+            fmt::print("Diverged at tick {} (date {}) in {}\n", divergence.tick, divergence.date,
+                       cqspcs::ToString(divergence.component));
+            return 2;
+        }
+        fmt::print("All {} ticks match {}\n", recorded.ticks.size(), options.verify_path);
+    }
+    return 0;
+}
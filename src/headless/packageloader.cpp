@@ -0,0 +1,206 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "headless/packageloader.h"
+
+#include <hjson.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "common/scripting/luafunctions.h"
+#include "common/systems/loading/hjsonloader.h"
+#include "common/systems/loading/loadgoods.h"
+#include "common/systems/loading/loadnames.h"
+#include "common/systems/loading/loadplanets.h"
+#include "common/systems/science/fields.h"
+#include "common/systems/science/technology.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+std::string ReadFile(const fs::path& path) {
+    std::ifstream stream(path, std::ios::binary);
+    std::stringstream buffer;
+    buffer << stream.rdbuf();
+    return buffer.str();
+}
+
+/// Gets all the files in the directory, sorted so that the load order is always the same
+std::vector<fs::path> GetFiles(const fs::path& directory) {
+    std::vector<fs::path> files;
+    for (const auto& entry : fs::recursive_directory_iterator(directory)) {
+        if (entry.is_regular_file()) {
+            files.push_back(entry.path());
+        }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+/// Reads a hjson file, or if it's a directory, reads all the hjson arrays in the directory into a single array,
+/// the same way the asset loader does.
+Hjson::Value ReadHjson(const fs::path& path) {
+    Hjson::DecoderOptions dec_opt;
+    dec_opt.comments = false;
+
+    if (!fs::is_directory(path)) {
+        try {
+            return Hjson::Unmarshal(ReadFile(path), dec_opt);
+        } catch (Hjson::syntax_error& ex) {
+            SPDLOG_ERROR("Failed to load hjson {}: {}", path.string(), ex.what());
+            return Hjson::Value();
+        }
+    }
+
+    Hjson::Value values(Hjson::Type::Vector);
+    for (const fs::path& file : GetFiles(path)) {
+        try {
+            Hjson::Value result = Hjson::Unmarshal(ReadFile(file), dec_opt);
+            if (result.type() != Hjson::Type::Vector) {
+                SPDLOG_ERROR("Failed to load hjson file {}: it needs to be a array", file.string());
+                continue;
+            }
+            for (int k = 0; k < result.size(); k++) {
+                values.push_back(result[k]);
+            }
+        } catch (Hjson::syntax_error& ex) {
+            SPDLOG_ERROR("Failed to load hjson file {}: {}", file.string(), ex.what());
+        }
+    }
+    return values;
+}
+
+void LoadResource(cqsp::common::Universe& universe, const std::map<std::string, fs::path>& assets,
+                  const std::string& asset_name,
+                  void (*func)(cqsp::common::Universe& universe, Hjson::Value& value)) {
+    auto it = assets.find(asset_name);
+    if (it == assets.end()) {
+        return;
+    }
+    Hjson::Value value = ReadHjson(it->second);
+    try {
+        func(universe, value);
+    } catch (std::runtime_error& error) {
+        SPDLOG_INFO("Failed to load hjson asset {}: {}", asset_name, error.what());
+    } catch (Hjson::index_out_of_bounds &) {
+    }
+}
+
+template<class T>
+void LoadResource(cqsp::common::Universe& universe, const std::map<std::string, fs::path>& assets,
+                  const std::string& asset_name) {
+    using cqsp::common::systems::loading::HjsonLoader;
+    static_assert(std::is_base_of<HjsonLoader, T>::value, "Class is not child of");
+    auto it = assets.find(asset_name);
+    if (it == assets.end()) {
+        return;
+    }
+    std::unique_ptr<HjsonLoader> ptr = std::make_unique<T>(universe);
+    Hjson::Value value = ReadHjson(it->second);
+    try {
+        ptr->LoadHjson(value);
+    } catch (std::runtime_error& error) {
+        SPDLOG_INFO("Failed to load hjson asset {}: {}", asset_name, error.what());
+    } catch (Hjson::index_out_of_bounds &) {
+    }
+}
+}  // namespace
+
+namespace cqsp::headless {
+bool LoadPackage(cqsp::common::Game& game, const fs::path& package_path) {
+    if (!fs::exists(package_path / "info.hjson")) {
+        SPDLOG_ERROR("Failed to load package {}", package_path.string());
+        return false;
+    }
+    Hjson::Value info = ReadHjson(package_path / "info.hjson");
+    SPDLOG_INFO("Loading package {}", info["name"].to_string());
+
+    // The asset loader always loads these directories
+    fs::path data_path = package_path / "data";
+    std::map<std::string, fs::path> assets;
+    assets["goods"] = data_path / "goods";
+    assets["recipes"] = data_path / "recipes";
+    assets["names"] = data_path / "names";
+
+    // Then the hjson assets listed in the data folder
+    if (fs::exists(data_path / "resource.hjson")) {
+        Hjson::Value resources = ReadHjson(data_path / "resource.hjson");
+        for (const auto [key, val] : resources) {
+            if (val["type"].to_string() != "hjson") {
+                continue;
+            }
+            assets[key] = data_path / val["path"].to_string();
+        }
+    }
+
+    using namespace cqsp::common::systems::loading;  // NOLINT
+    cqsp::common::Universe& universe = game.GetUniverse();
+    LoadResource<GoodLoader>(universe, assets, "goods");
+    LoadResource<RecipeLoader>(universe, assets, "recipes");
+    LoadResource<PlanetLoader>(universe, assets, "planets");
+    LoadResource(universe, assets, "names", LoadNameLists);
+    LoadResource(universe, assets, "tech_fields", cqsp::common::systems::science::LoadFields);
+    LoadResource(universe, assets, "tech_list", cqsp::common::systems::science::LoadTechnologies);
+    LoadResource(universe, assets, "terrain_colors", LoadTerrainData);
+
+    auto& script_interface = game.GetScriptInterface();
+    cqsp::scripting::LoadFunctions(universe, script_interface);
+
+    // Scripts are required with dots instead of slashes, so universegen/defaultgen.lua is
+    // require("universegen.defaultgen")
+    std::map<std::string, fs::path> scripts;
+    fs::path script_path = package_path / "scripts";
+    if (fs::is_directory(script_path)) {
+        for (const fs::path& file : GetFiles(script_path)) {
+            if (file.extension() != ".lua") {
+                continue;
+            }
+            std::string name = fs::relative(file, script_path).replace_extension().generic_string();
+            std::replace(name.begin(), name.end(), '/', '.');
+            scripts[name] = file;
+        }
+    }
+    script_interface["require"] = [&script_interface, scripts](const char* script) {
+        auto it = scripts.find(script);
+        if (it == scripts.end()) {
+            SPDLOG_INFO("Cannot find require {}", script);
+            return sol::make_object(script_interface, sol::nil);
+        }
+        return script_interface.require_script(script, ReadFile(it->second));
+    };
+
+    script_interface.RegisterDataGroup("generators");
+    script_interface.RegisterDataGroup("events");
+    return true;
+}
+
+bool RunPackageScripts(cqsp::common::Game& game, const fs::path& package_path) {
+    fs::path base = package_path / "scripts" / "base.lua";
+    if (!fs::exists(base)) {
+        SPDLOG_INFO("No script file for package {}", package_path.string());
+        return false;
+    }
+    game.GetScriptInterface().RunScript(ReadFile(base));
+    return true;
+}
+}  // namespace cqsp::headless
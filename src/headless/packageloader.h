@@ -0,0 +1,37 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <filesystem>
+
+#include "common/game.h"
+
+namespace cqsp::headless {
+/// <summary>
+/// Loads the data and scripts of a package straight from the disk into the game.
+/// </summary>
+/// The client loads packages through the asset manager, which needs a window to load textures and shaders,
+/// so this only loads the hjson data and the lua scripts that the simulation needs.
+/// <param name="package_path">Path to the package, which is the folder containing info.hjson</param>
+/// <returns>False if the package cannot be found</returns>
+bool LoadPackage(cqsp::common::Game& game, const std::filesystem::path& package_path);
+
+/// <summary>
+/// Runs scripts/base.lua of the package, which adds the universe generators and events.
+/// </summary>
+bool RunPackageScripts(cqsp::common::Game& game, const std::filesystem::path& package_path);
+}  // namespace cqsp::headless
@@ -0,0 +1,155 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "common/components/auction.h"
+#include "common/systems/economy/auctionhandler.h"
+
+namespace cqspc = cqsp::common::components;
+
+namespace {
+const entt::entity good = static_cast<entt::entity>(1);
+const entt::entity agent = static_cast<entt::entity>(2);
+
+// The auction house before the order books, which kept every order in a sorted vector
+struct SortedListAuction {
+    std::map<entt::entity, cqspc::DescendingSortedOrderList> sell_orders;
+    std::map<entt::entity, cqspc::AscendingSortedOrderList> buy_orders;
+
+    void AddSellOrder(const cqspc::Order& order) { sell_orders[good].put(order); }
+
+    double GetSupply() {
+        double supply = 0;
+        for (const cqspc::Order& order : sell_orders[good]) {
+            supply += order.quantity;
+        }
+        return supply;
+    }
+
+    bool BuyGood(double price, double quantity) {
+        auto& sell_order_list = sell_orders[good];
+        while (!sell_order_list.empty()) {
+            cqspc::Order& first = sell_order_list.front();
+            if (first.price > price) {
+                break;
+            }
+            if (first.quantity > quantity) {
+                first.quantity -= quantity;
+                return true;
+            }
+            quantity -= first.quantity;
+            sell_order_list.erase(sell_order_list.begin());
+        }
+        if (quantity <= 0) {
+            return true;
+        }
+        buy_orders[good].put(cqspc::Order(price, quantity, agent));
+        return false;
+    }
+};
+
+struct BookAuction {
+    cqspc::AuctionHouse auction_house;
+
+    void AddSellOrder(cqspc::Order order) { auction_house.AddSellOrder(good, std::move(order)); }
+    double GetSupply() { return auction_house.GetSupply(good); }
+    bool BuyGood(double price, double quantity) {
+        return cqsp::common::systems::BuyGood(auction_house, agent, good, price, quantity);
+    }
+};
+
+std::vector<cqspc::Order> MakeOrders(int count) {
+    std::mt19937 random(42);
+    // A thousand price levels, with many orders at every level
+    std::uniform_int_distribution<int> price(1, 1000);
+    std::uniform_int_distribution<int> quantity(1, 100);
+    std::vector<cqspc::Order> orders;
+    for (int i = 0; i < count; i++) {
+        orders.emplace_back(price(random) / 10., quantity(random), agent);
+    }
+    return orders;
+}
+
+template <typename Auction>
+void MeasureAuction(cqsp::benchmark::BenchmarkReport& report, const std::string& backend,
+                    const cqsp::benchmark::BenchmarkValues& values, const std::vector<cqspc::Order>& orders) {
+    volatile double sink = 0;
+    auto add = [&](const std::string& operation, auto function) {
+        report.Add("auction", backend + " " + operation, values, cqsp::benchmark::Measure(function, 3));
+    };
+    add("put", [&]() {
+        Auction auction;
+        for (const cqspc::Order& order : orders) {
+            auction.AddSellOrder(order);
+        }
+        sink = auction.GetSupply();
+    });
+
+    Auction auction;
+    for (const cqspc::Order& order : orders) {
+        auction.AddSellOrder(order);
+    }
+    const int trades = 1000;
+    add("GetSupply", [&]() {
+        double supply = 0;
+        for (int i = 0; i < trades; i++) {
+            supply += auction.GetSupply();
+        }
+        sink = supply;
+    });
+    // Every buy fills as much as the order that is put back, so the book stays about the same size
+    add("trade", [&]() {
+        for (int i = 0; i < trades; i++) {
+            const cqspc::Order& order = orders[i % orders.size()];
+            auction.BuyGood(1000, order.quantity);
+            auction.AddSellOrder(order);
+        }
+        sink = auction.GetSupply();
+    });
+}
+
+// Clears the same number of bids and asks at once, instead of matching them one at a time
+void MeasureCallAuction(cqsp::benchmark::BenchmarkReport& report, const cqsp::benchmark::BenchmarkValues& values,
+                        const std::vector<cqspc::Order>& orders) {
+    cqspc::CallOrders call_orders;
+    for (size_t i = 0; i < orders.size(); i++) {
+        (i % 2 == 0 ? call_orders.bids : call_orders.asks).push_back(orders[i]);
+    }
+    volatile double sink = 0;
+    report.Add("auction", "call auction clear", values, cqsp::benchmark::Measure([&]() {
+        // Clearing sorts the orders, so it is given a copy
+        cqspc::CallOrders copy = call_orders;
+        sink = cqsp::common::systems::ClearCallAuction(copy).volume;
+    }, 3));
+}
+}  // namespace
+
+// Compares the price level order books of the auction house with the sorted order lists that they replaced, with
+// up to 10^5 resting orders for a good.
+CQSP_BENCHMARK(Auction) {
+    for (int count : {1000, 10000, 100000}) {
+        std::vector<cqspc::Order> orders = MakeOrders(count);
+        cqsp::benchmark::BenchmarkValues values {{"orders", count}};
+        MeasureAuction<SortedListAuction>(report, "sorted list", values, orders);
+        MeasureAuction<BookAuction>(report, "order book", values, orders);
+        MeasureCallAuction(report, values, orders);
+    }
+}
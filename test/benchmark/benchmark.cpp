@@ -0,0 +1,90 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include "benchmark.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <string>
+
+namespace cqsp::benchmark {
+namespace {
+std::vector<std::pair<std::string, BenchmarkFunction>>& GetRegistry() {
+    static std::vector<std::pair<std::string, BenchmarkFunction>> registry;
+    return registry;
+}
+
+std::string EscapeJson(std::string_view text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped;
+}
+}  // namespace
+
+void BenchmarkReport::Add(std::string_view benchmark, std::string_view name, const BenchmarkValues& values) {
+    results.push_back({std::string(benchmark), std::string(name), values});
+}
+
+void BenchmarkReport::Add(std::string_view benchmark, std::string_view name, BenchmarkValues values,
+                          const Timing& timing) {
+    values.emplace_back("mean_us", timing.mean);
+    values.emplace_back("min_us", timing.min);
+    values.emplace_back("max_us", timing.max);
+    values.emplace_back("iterations", timing.iterations);
+    Add(benchmark, name, values);
+}
+
+void BenchmarkReport::WriteJson(std::ostream& stream) const {
+    stream << "[\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& result = results[i];
+        stream << fmt::format("  {{\"benchmark\": \"{}\", \"name\": \"{}\"", EscapeJson(result.benchmark),
+                              EscapeJson(result.name));
+        for (const auto& [key, value] : result.values) {
+            stream << fmt::format(", \"{}\": {}", EscapeJson(key), value);
+        }
+        stream << (i + 1 < results.size() ? "},\n" : "}\n");
+    }
+    stream << "]\n";
+}
+
+void BenchmarkReport::Print() const {
+    for (const Result& result : results) {
+        std::string line = fmt::format("{:<24} {:<40}", result.benchmark, result.name);
+        for (const auto& [key, value] : result.values) {
+            line += fmt::format(" {}={:.4g}", key, value);
+        }
+        fmt::print("{}\n", line);
+    }
+}
+
+int RegisterBenchmark(const char* name, BenchmarkFunction function) {
+    GetRegistry().emplace_back(name, function);
+    return static_cast<int>(GetRegistry().size());
+}
+
+std::vector<std::pair<std::string, BenchmarkFunction>> GetBenchmarks() {
+    auto benchmarks = GetRegistry();
+    std::sort(benchmarks.begin(), benchmarks.end());
+    return benchmarks;
+}
+}  // namespace cqsp::benchmark
@@ -0,0 +1,106 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#pragma once
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace cqsp::benchmark {
+/// <summary>
+/// How long a function took to run, in microseconds.
+/// </summary>
+struct Timing {
+    int iterations = 0;
+    double mean = 0;
+    double min = 0;
+    double max = 0;
+};
+
+/// <summary>
+/// Runs the function at least `min_iterations` times, and until it has run for at least `min_time`.
+/// </summary>
+template <typename Function>
+Timing Measure(Function&& function, int min_iterations = 5,
+               std::chrono::milliseconds min_time = std::chrono::milliseconds(200)) {
+    Timing timing;
+    double total = 0;
+    auto start = std::chrono::steady_clock::now();
+    while (timing.iterations < min_iterations || std::chrono::steady_clock::now() - start < min_time) {
+        auto begin = std::chrono::steady_clock::now();
+        function();
+        auto end = std::chrono::steady_clock::now();
+        double time = std::chrono::duration<double, std::micro>(end - begin).count();
+        if (timing.iterations == 0 || time < timing.min) {
+            timing.min = time;
+        }
+        if (time > timing.max) {
+            timing.max = time;
+        }
+        total += time;
+        timing.iterations++;
+    }
+    timing.mean = total / timing.iterations;
+    return timing;
+}
+
+typedef std::vector<std::pair<std::string, double>> BenchmarkValues;
+
+/// <summary>
+/// Results of the benchmarks, which are written as JSON so that they can be compared between runs.
+/// </summary>
+class BenchmarkReport {
+ public:
+    void Add(std::string_view benchmark, std::string_view name, const BenchmarkValues& values);
+
+    /// <summary>
+    /// Adds the values, as well as the mean, min and max time, and the number of iterations.
+    /// </summary>
+    void Add(std::string_view benchmark, std::string_view name, BenchmarkValues values, const Timing& timing);
+
+    void WriteJson(std::ostream& stream) const;
+    void Print() const;
+
+ private:
+    struct Result {
+        std::string benchmark;
+        std::string name;
+        BenchmarkValues values;
+    };
+    std::vector<Result> results;
+};
+
+typedef void (*BenchmarkFunction)(BenchmarkReport& report);
+
+int RegisterBenchmark(const char* name, BenchmarkFunction function);
+
+/// <summary>
+/// All the registered benchmarks, sorted by name.
+/// </summary>
+std::vector<std::pair<std::string, BenchmarkFunction>> GetBenchmarks();
+}  // namespace cqsp::benchmark
+
+/// <summary>
+/// Defines a benchmark, which is run by cqsp-benchmark.
+/// </summary>
+#define CQSP_BENCHMARK(name)                                                                         \
+    void name(::cqsp::benchmark::BenchmarkReport& report);                                        \
+    static int name##_registration = ::cqsp::benchmark::RegisterBenchmark(#name, name);           \
+    void name(::cqsp::benchmark::BenchmarkReport& report)
@@ -0,0 +1,141 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "benchmark.h"
+#include "common/game.h"
+#include "common/components/area.h"
+#include "common/components/economy.h"
+#include "common/components/population.h"
+#include "common/components/resource.h"
+#include "common/systems/economy/economygroups.h"
+#include "common/systems/syntheticuniversegenerator.h"
+
+namespace cqspc = cqsp::common::components;
+namespace economy = cqsp::common::systems::economy;
+using cqsp::common::Universe;
+using cqsp::common::systems::universegenerator::SyntheticUniverseGenerator;
+using cqsp::common::systems::universegenerator::SyntheticUniverseOptions;
+
+namespace {
+double ReadMinesWithView(entt::registry& universe) {
+    double total = 0;
+    auto view = universe.view<cqspc::RawResourceGen, cqspc::ResourceGenerator, cqspc::MarketAgent>();
+    for (entt::entity entity : view) {
+        auto& generator = universe.get<cqspc::ResourceGenerator>(entity);
+        total += generator.begin()->second + entt::to_integral(universe.get<cqspc::MarketAgent>(entity).market);
+    }
+    return total;
+}
+
+double ReadMinesWithGroup(Universe& universe) {
+    double total = 0;
+    for (auto [entity, generator, agent] : economy::MineGroup(universe).each()) {
+        total += generator.begin()->second + entt::to_integral(agent.market);
+    }
+    return total;
+}
+
+double ReadConsumersWithView(entt::registry& universe) {
+    double total = 0;
+    for (auto [entity, segment] : universe.view<cqspc::PopulationSegment>().each()) {
+        if (universe.any_of<cqspc::MarketAgent>(entity)) {
+            total += segment.population + entt::to_integral(universe.get<cqspc::MarketAgent>(entity).market);
+        }
+    }
+    return total;
+}
+
+double ReadConsumersWithGroup(Universe& universe) {
+    double total = 0;
+    for (auto [entity, segment, agent] : economy::ConsumerGroup(universe).each()) {
+        total += segment.population + entt::to_integral(agent.market);
+    }
+    return total;
+}
+
+template <typename Component>
+void CopyComponent(entt::registry& from, entt::registry& to, const std::vector<entt::entity>& entities) {
+    for (entt::entity entity : entities) {
+        if (!from.all_of<Component>(entity)) {
+            continue;
+        }
+        if constexpr (std::is_empty_v<Component>) {
+            to.emplace<Component>(entity);
+        } else {
+            to.emplace<Component>(entity, from.get<Component>(entity));
+        }
+    }
+}
+
+// Copies the components that the view functions read into a registry that never had the economy groups. They are
+// added in order of entity id, like the generator adds them, so the storages aren't sorted by the groups.
+void CopyWithoutGroups(Universe& universe, entt::registry& baseline) {
+    std::vector<entt::entity> entities;
+    universe.each([&](entt::entity entity) { entities.push_back(entity); });
+    std::sort(entities.begin(), entities.end());
+    for (entt::entity entity : entities) {
+        baseline.create(entity);
+    }
+    CopyComponent<cqspc::MarketAgent>(universe, baseline, entities);
+    CopyComponent<cqspc::ResourceGenerator>(universe, baseline, entities);
+    CopyComponent<cqspc::RawResourceGen>(universe, baseline, entities);
+    CopyComponent<cqspc::PopulationSegment>(universe, baseline, entities);
+}
+
+template <typename ViewFunction, typename GroupFunction>
+void Compare(cqsp::benchmark::BenchmarkReport& report, entt::registry& baseline, Universe& universe,
+             const std::string& name, const cqsp::benchmark::BenchmarkValues& values, ViewFunction view_function,
+             GroupFunction group_function) {
+    // Written to a volatile so that the reads aren't optimized away
+    volatile double sink = 0;
+    auto view_timing = cqsp::benchmark::Measure([&]() { sink = view_function(baseline); });
+    auto group_timing = cqsp::benchmark::Measure([&]() { sink = group_function(universe); });
+    cqsp::benchmark::BenchmarkValues view_values = values;
+    view_values.emplace_back("groups", 0);
+    report.Add("groups", name, view_values, view_timing);
+    cqsp::benchmark::BenchmarkValues group_values = values;
+    group_values.emplace_back("groups", 1);
+    group_values.emplace_back("speedup", view_timing.mean / group_timing.mean);
+    report.Add("groups", name, group_values, group_timing);
+}
+}  // namespace
+
+// Compares iterating over the economy groups to iterating over views and looking up every component, on a
+// universe that is 100 and 1000 times larger than the default synthetic universe. The universe creates the groups
+// when it is constructed, so the views are read from a copy that has the storage layout from before the groups.
+CQSP_BENCHMARK(Groups) {
+    for (int scale : {100, 1000}) {
+        cqsp::common::Game game;
+        Universe& universe = game.GetUniverse();
+        SyntheticUniverseGenerator(SyntheticUniverseOptions::Scaled(scale)).Generate(universe);
+
+        entt::registry baseline;
+        CopyWithoutGroups(universe, baseline);
+
+        cqsp::benchmark::BenchmarkValues values {
+            {"scale", scale},
+            {"agents", universe.view<cqspc::MarketAgent>().size()},
+        };
+        Compare(report, baseline, universe, "SysMine", values, &ReadMinesWithView, &ReadMinesWithGroup);
+        Compare(report, baseline, universe, "SysPopulationConsumption", values, &ReadConsumersWithView,
+                &ReadConsumersWithGroup);
+    }
+}
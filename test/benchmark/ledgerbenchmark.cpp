@@ -0,0 +1,172 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <string>
+#include <vector>
+
+#include "benchmark.h"
+#include "common/components/denseledger.h"
+#include "common/components/resource.h"
+#include "common/components/smallledger.h"
+
+using cqsp::common::components::DenseLedger;
+using cqsp::common::components::GoodIndex;
+using cqsp::common::components::ResourceLedger;
+using cqsp::common::components::SmallLedger;
+
+namespace {
+// How many ledgers every operation is run on, so that the time is long enough to measure
+const int ledger_count = 1000;
+
+template <typename Ledger>
+struct LedgerSet {
+    std::vector<Ledger> ledgers;
+    Ledger other;
+    volatile double sink = 0;
+};
+
+template <typename Ledger>
+void MeasureOperations(cqsp::benchmark::BenchmarkReport& report, const std::string& backend,
+                       const cqsp::benchmark::BenchmarkValues& values, LedgerSet<Ledger>& set) {
+    auto add = [&](const std::string& operation, auto function) {
+        report.Add("ledger", backend + " " + operation, values, cqsp::benchmark::Measure(function));
+    };
+    add("+=", [&]() {
+        for (Ledger& ledger : set.ledgers) {
+            ledger += set.other;
+        }
+    });
+    add("MultiplyAdd", [&]() {
+        for (Ledger& ledger : set.ledgers) {
+            ledger.MultiplyAdd(set.other, 0.5);
+        }
+    });
+    add(">=", [&]() {
+        int count = 0;
+        for (Ledger& ledger : set.ledgers) {
+            count += ledger >= set.other;
+        }
+        set.sink = count;
+    });
+    add("MultiplyAndGetSum", [&]() {
+        double sum = 0;
+        for (Ledger& ledger : set.ledgers) {
+            sum += ledger.MultiplyAndGetSum(set.other);
+        }
+        set.sink = sum;
+    });
+    add("GetSum", [&]() {
+        double sum = 0;
+        for (Ledger& ledger : set.ledgers) {
+            sum += ledger.GetSum();
+        }
+        set.sink = sum;
+    });
+}
+
+// Builds a new ledger from a generator and a recipe for every agent, the way that SysAgent does every tick
+template <typename Ledger>
+void MeasureTrade(cqsp::benchmark::BenchmarkReport& report, const std::string& backend,
+                  const cqsp::benchmark::BenchmarkValues& values, LedgerSet<Ledger>& set) {
+    auto timing = cqsp::benchmark::Measure([&]() {
+        double sum = 0;
+        for (Ledger& generator : set.ledgers) {
+            Ledger selling;
+            selling.MultiplyAdd(generator, 0.5);
+            selling.MultiplyAdd(set.other, 2);
+            sum += selling.GetSum();
+        }
+        set.sink = sum;
+    });
+    report.Add("ledger", backend + " trade", values, timing);
+}
+
+// Evaluates a factory cost for every ledger, with expression templates, and with a copy of the ledger for every
+// operator, which is what the operators did before
+void MeasureCost(cqsp::benchmark::BenchmarkReport& report, const cqsp::benchmark::BenchmarkValues& values,
+                 LedgerSet<ResourceLedger>& set) {
+    report.Add("ledger", "map cost expression", values, cqsp::benchmark::Measure([&]() {
+        double sum = 0;
+        for (const ResourceLedger& scaling : set.ledgers) {
+            ResourceLedger cost = scaling * 10 + set.other;
+            sum += cost.GetSum();
+        }
+        set.sink = sum;
+    }));
+    report.Add("ledger", "map cost temporaries", values, cqsp::benchmark::Measure([&]() {
+        double sum = 0;
+        for (const ResourceLedger& scaling : set.ledgers) {
+            ResourceLedger scaled = scaling;
+            scaled *= 10;
+            ResourceLedger cost = scaled;
+            cost += set.other;
+            sum += cost.GetSum();
+        }
+        set.sink = sum;
+    }));
+}
+}  // namespace
+
+// Compares the map and dense ledgers on ledgers that have every good, and ledgers that only have a few goods,
+// with 8, 64 and 512 goods. The small ledger is only measured on the ledgers with a few goods, which is what it is
+// for.
+CQSP_BENCHMARK(Ledger) {
+    for (int good_count : {8, 64, 512}) {
+        entt::registry registry;
+        GoodIndex index;
+        std::vector<entt::entity> goods;
+        for (int i = 0; i < good_count; i++) {
+            goods.push_back(registry.create());
+            index.Add(goods.back());
+        }
+
+        for (int filled : {3, good_count}) {
+            LedgerSet<ResourceLedger> map_set;
+            LedgerSet<DenseLedger> dense_set;
+            LedgerSet<SmallLedger> small_set;
+            map_set.ledgers.resize(ledger_count);
+            dense_set.ledgers.resize(ledger_count, DenseLedger(index));
+            dense_set.other.Bind(index);
+            for (int l = 0; l < ledger_count; l++) {
+                // Spread the goods out, so that the sparse ledgers don't all have the same goods
+                for (int g = 0; g < filled; g++) {
+                    entt::entity good = goods[(l * 7 + g) % good_count];
+                    map_set.ledgers[l][good] = l + g;
+                    dense_set.ledgers[l][good] = l + g;
+                }
+                if (filled <= static_cast<int>(SmallLedger::inline_capacity)) {
+                    small_set.ledgers.emplace_back(map_set.ledgers[l]);
+                }
+            }
+            for (int g = 0; g < filled; g++) {
+                map_set.other[goods[g]] = 1 + g;
+                dense_set.other[goods[g]] = 1 + g;
+            }
+            small_set.other = SmallLedger(map_set.other);
+
+            cqsp::benchmark::BenchmarkValues values {{"goods", good_count}, {"filled", filled}};
+            // Trade first, because the map ledger's MultiplyAndGetSum adds every good to the other ledger
+            MeasureTrade(report, "map", values, map_set);
+            MeasureCost(report, values, map_set);
+            MeasureOperations(report, "map", values, map_set);
+            MeasureOperations(report, "dense", values, dense_set);
+            if (!small_set.ledgers.empty()) {
+                MeasureTrade(report, "small", values, small_set);
+                MeasureOperations(report, "small", values, small_set);
+            }
+        }
+    }
+}
@@ -0,0 +1,56 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <fmt/format.h>
+
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include "benchmark.h"
+
+int main(int argc, char* argv[]) {
+    std::string filter;
+    std::string output;
+    for (int i = 1; i < argc; i++) {
+        std::string_view arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--output" && i + 1 < argc) {
+            output = argv[++i];
+        } else {
+            fmt::print("Usage: cqsp-benchmark [--filter <name>] [--output <file.json>]\n");
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    cqsp::benchmark::BenchmarkReport report;
+    for (const auto& [name, function] : cqsp::benchmark::GetBenchmarks()) {
+        if (!filter.empty() && name.find(filter) == std::string::npos) {
+            continue;
+        }
+        fmt::print("Running {}\n", name);
+        function(report);
+    }
+    report.Print();
+
+    if (!output.empty()) {
+        std::ofstream stream(output);
+        report.WriteJson(stream);
+        fmt::print("Wrote results to {}\n", output);
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <cstdint>
+#include <vector>
+
+#include "benchmark.h"
+#include "common/game.h"
+#include "common/components/economy.h"
+#include "common/components/population.h"
+#include "common/components/resource.h"
+#include "common/systems/economy/economygroups.h"
+#include "common/systems/economy/populationdemand.h"
+#include "common/systems/economy/syspopulation.h"
+#include "common/systems/syntheticuniversegenerator.h"
+
+namespace cqspc = cqsp::common::components;
+namespace cqspcs = cqsp::common::systems;
+namespace economy = cqsp::common::systems::economy;
+using cqsp::common::Universe;
+using cqsp::common::systems::universegenerator::SyntheticUniverseGenerator;
+using cqsp::common::systems::universegenerator::SyntheticUniverseOptions;
+
+namespace {
+// Computes the demand of every segment on its own, the way that SysPopulationConsumption did before the demand was
+// computed in columns
+void ConsumePerSegment(Universe& universe) {
+    const entt::entity good = universe.goods["consumer_good"];
+    const entt::entity food = universe.goods["food"];
+    const uint32_t epoch = cqspc::Wallet::GetEpoch(universe.date);
+    auto consumers = economy::ConsumerGroup(universe);
+    for (auto [entity, segment, market_agent] : consumers.each()) {
+        uint64_t consumption = segment.population / 100000;
+        auto& wallet = universe.get_or_emplace<cqspc::Wallet>(entity);
+        auto& market = universe.get<cqspc::Market>(market_agent.market);
+        double food_price = market.GetPrice(food);
+        if (consumption * food_price > wallet.GetBalance()) {
+            universe.get_or_emplace<cqspc::ResourceConsumption>(entity)[food] = wallet.GetBalance() / food_price;
+        } else {
+            universe.get_or_emplace<cqspc::ResourceConsumption>(entity)[food] = consumption;
+            double amount_consumer = wallet.GetBalance() - food_price * consumption;
+            double good_price = market.GetPrice(good);
+            if (amount_consumer / good_price > segment.population / 20000) {
+                universe.get_or_emplace<cqspc::ResourceConsumption>(entity)[good] = amount_consumer / good_price;
+            }
+        }
+        wallet.Add(segment.population / 1000, epoch);
+    }
+}
+}  // namespace
+
+// Compares computing the demand of a million population segments on 16 markets one by one with computing it in
+// columns, and measures how long computing the columns takes without gathering and scattering them.
+CQSP_BENCHMARK(PopulationDemand) {
+    cqsp::common::Game game;
+    Universe& universe = game.GetUniverse();
+    SyntheticUniverseOptions options = SyntheticUniverseOptions::Scaled(16);
+    options.cities = 1000;
+    options.segments_per_city = 1000;
+    options.factories_per_city = 0;
+    options.mines_per_city = 0;
+    options.farms_per_city = 0;
+    SyntheticUniverseGenerator generator(options);
+    generator.Generate(universe);
+    universe.date.IncrementDate();
+
+    cqsp::benchmark::BenchmarkValues values {
+        {"segments", universe.view<cqspc::PopulationSegment>().size()},
+        {"markets", universe.view<cqspc::Market>().size()},
+    };
+    report.Add("population", "PerSegment", values, cqsp::benchmark::Measure([&]() { ConsumePerSegment(universe); }));
+    cqspcs::SysPopulationConsumption consumption(game);
+    report.Add("population", "SysPopulationConsumption", values,
+               cqsp::benchmark::Measure([&]() { consumption.DoSystem(); }));
+
+    const int segments = static_cast<int>(universe.view<cqspc::PopulationSegment>().size());
+    std::vector<double> inputs[5];
+    for (std::vector<double>& column : inputs) {
+        column.resize(segments);
+    }
+    for (int i = 0; i < segments; i++) {
+        const double population = 100000 + (i * 7919) % 10000000;
+        inputs[0][i] = static_cast<double>(static_cast<uint64_t>(population) / 100000);
+        inputs[1][i] = static_cast<double>(static_cast<uint64_t>(population) / 20000);
+        inputs[2][i] = 1000000 + i % 1000;
+        inputs[3][i] = 1 + i % 16;
+        inputs[4][i] = 20 + i % 16;
+    }
+    std::vector<double> food(segments);
+    std::vector<double> good(segments);
+    report.Add("population", "ComputePopulationDemand", values, cqsp::benchmark::Measure([&]() {
+                   economy::ComputePopulationDemand({segments, inputs[0].data(), inputs[1].data(), inputs[2].data(),
+                                                     inputs[3].data(), inputs[4].data(), food.data(), good.data()});
+               }));
+}
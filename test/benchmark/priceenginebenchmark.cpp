@@ -0,0 +1,132 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "benchmark.h"
+#include "common/game.h"
+#include "common/components/economy.h"
+#include "common/systems/economy/priceengine.h"
+#include "common/systems/economy/sysagent.h"
+#include "common/systems/economy/sysfactory.h"
+#include "common/systems/economy/sysmarket.h"
+#include "common/systems/economy/syspopulation.h"
+#include "common/systems/syntheticuniversegenerator.h"
+
+namespace cqspc = cqsp::common::components;
+namespace cqspcs = cqsp::common::systems;
+namespace economy = cqsp::common::systems::economy;
+using cqsp::common::systems::universegenerator::SyntheticUniverseGenerator;
+using cqsp::common::systems::universegenerator::SyntheticUniverseOptions;
+
+namespace {
+constexpr int tick_count = 500;
+// The prices have converged when no price moves by more than this fraction in a tick
+constexpr double convergence_tolerance = 1e-3;
+// The variance of the prices is measured over the last ticks
+constexpr int variance_ticks = 100;
+
+/// <summary>
+/// Runs the economy of a synthetic universe with the engine, and reports how many ticks it took for the prices to
+/// stop moving, and how much they still move at the end.
+/// </summary>
+void MeasureEngine(cqsp::benchmark::BenchmarkReport& report, const std::string& name,
+                   std::unique_ptr<economy::PriceEngine> engine) {
+    cqsp::common::Game game;
+    cqsp::common::Universe& universe = game.GetUniverse();
+    SyntheticUniverseGenerator generator(SyntheticUniverseOptions::Scaled(10));
+    generator.Generate(universe);
+
+    cqspcs::SysPopulationConsumption consumption(game);
+    cqspcs::SysMine mine(game);
+    cqspcs::SysAgent agent(game);
+    cqspcs::SysMarket market(game);
+    market.SetPriceEngine(std::move(engine));
+
+    // The prices of every good on every market after every tick
+    std::vector<std::vector<double>> prices;
+    // Mean time of SysMarket, in microseconds
+    double market_time = 0;
+    for (int tick = 0; tick < tick_count; tick++) {
+        universe.date.IncrementDate();
+        consumption.DoSystem();
+        mine.DoSystem();
+        agent.DoSystem();
+        auto start = std::chrono::steady_clock::now();
+        market.DoSystem();
+        auto end = std::chrono::steady_clock::now();
+        market_time += std::chrono::duration<double, std::micro>(end - start).count() / tick_count;
+        universe.journal.Settle(universe, universe.date);
+
+        std::vector<double>& tick_prices = prices.emplace_back();
+        for (auto [entity, market_comp] : universe.view<cqspc::Market>().each()) {
+            tick_prices.insert(tick_prices.end(), market_comp.Current().price.begin(),
+                               market_comp.Current().price.end());
+        }
+    }
+
+    // The first tick after which no price moved by more than the tolerance
+    int converged = 0;
+    for (int tick = 1; tick < tick_count; tick++) {
+        const size_t count = std::min(prices[tick].size(), prices[tick - 1].size());
+        for (size_t i = 0; i < count; i++) {
+            double previous = prices[tick - 1][i];
+            if (previous > 0 && std::abs(prices[tick][i] - previous) / previous > convergence_tolerance) {
+                converged = tick + 1;
+                break;
+            }
+        }
+    }
+
+    // The variance of every price over the last ticks, relative to its mean so that cheap and expensive goods count
+    // the same, averaged over the prices
+    double variance = 0;
+    const size_t price_count = prices[tick_count - variance_ticks].size();
+    for (size_t i = 0; i < price_count; i++) {
+        double sum = 0;
+        double squares = 0;
+        for (int tick = tick_count - variance_ticks; tick < tick_count; tick++) {
+            sum += prices[tick][i];
+            squares += prices[tick][i] * prices[tick][i];
+        }
+        double mean = sum / variance_ticks;
+        if (mean > 0) {
+            variance += (squares / variance_ticks - mean * mean) / (mean * mean) / price_count;
+        }
+    }
+
+    report.Add("price engine", name, {
+        {"ticks", tick_count},
+        {"ticks_to_convergence", converged},
+        {"converged", converged < tick_count},
+        {"relative_price_variance", variance},
+        {"sysmarket_mean", market_time},
+    });
+}
+}  // namespace
+
+// Compares how fast the price engines of SysMarket settle the prices of a synthetic universe
+CQSP_BENCHMARK(PriceEngines) {
+    MeasureEngine(report, "FixedStep", std::make_unique<economy::FixedStepPriceEngine>());
+    MeasureEngine(report, "Tatonnement", std::make_unique<economy::TatonnementPriceEngine>());
+    MeasureEngine(report, "Secant", std::make_unique<economy::SecantPriceEngine>());
+}
@@ -0,0 +1,144 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "benchmark.h"
+#include "common/game.h"
+#include "common/components/bodies.h"
+#include "common/components/economy.h"
+#include "common/components/population.h"
+#include "common/systems/economy/sysagent.h"
+#include "common/systems/economy/sysfactory.h"
+#include "common/systems/economy/sysmarket.h"
+#include "common/systems/economy/tradematrix.h"
+#include "common/systems/economy/syspopulation.h"
+#include "common/systems/history/sysmarkethistory.h"
+#include "common/systems/movement/sysmovement.h"
+#include "common/systems/syntheticuniversegenerator.h"
+#include "common/util/threadpool.h"
+
+namespace cqspc = cqsp::common::components;
+namespace cqspcs = cqsp::common::systems;
+using cqsp::common::systems::universegenerator::SyntheticUniverseGenerator;
+using cqsp::common::systems::universegenerator::SyntheticUniverseOptions;
+
+namespace {
+template <typename System>
+void MeasureSystem(cqsp::benchmark::BenchmarkReport& report, cqsp::common::Game& game, const std::string& name,
+                   const cqsp::benchmark::BenchmarkValues& values, cqsp::common::util::ThreadPool* pool = nullptr) {
+    System system(game);
+    system.SetThreadPool(pool);
+    // The payments that the system recorded are settled as part of its time, as they would be at the end of the tick
+    report.Add("scaling", name, values, cqsp::benchmark::Measure([&]() {
+                   cqsp::common::Universe& universe = game.GetUniverse();
+                   system.DoSystem();
+                   universe.journal.Settle(universe, universe.date);
+               }));
+}
+}  // namespace
+
+// Measures how long each of the main simulation systems take on universes that are 1, 10, 100 and 1000
+// times larger than the default synthetic universe.
+CQSP_BENCHMARK(Scaling) {
+    for (int scale : {1, 10, 100, 1000}) {
+        cqsp::common::Game game;
+        cqsp::common::Universe& universe = game.GetUniverse();
+        SyntheticUniverseGenerator generator(SyntheticUniverseOptions::Scaled(scale));
+        generator.Generate(universe);
+        universe.date.IncrementDate();
+
+        cqsp::benchmark::BenchmarkValues values {
+            {"scale", scale},
+            {"agents", universe.view<cqspc::MarketAgent>().size()},
+            {"markets", universe.view<cqspc::Market>().size()},
+            {"segments", universe.view<cqspc::PopulationSegment>().size()},
+            {"bodies", universe.view<cqspc::bodies::Body>().size()},
+        };
+        MeasureSystem<cqspcs::SysAgent>(report, game, "SysAgent", values);
+        // SysAgent only rebuilds the trade matrices when agents join or leave a market
+        report.Add("scaling", "BuildTradeMatrices", values, cqsp::benchmark::Measure([&]() {
+            for (auto [market, matrix] : universe.view<cqspc::TradeMatrix>().each()) {
+                matrix.dirty = true;
+            }
+            cqspcs::economy::BuildTradeMatrices(universe);
+        }));
+        MeasureSystem<cqspcs::SysMine>(report, game, "SysMine", values);
+        MeasureSystem<cqspcs::SysPopulationConsumption>(report, game, "SysPopulationConsumption", values);
+        MeasureSystem<cqspcs::SysMarket>(report, game, "SysMarket", values);
+        MeasureSystem<cqspcs::history::SysMarketHistory>(report, game, "SysMarketHistory", values);
+        MeasureSystem<cqspcs::SysOrbit>(report, game, "SysOrbit", values);
+    }
+}
+
+// Measures how SysAgent and SysMarket scale with the number of cores on universes with 1 to 64 markets, which are
+// traded and cleared in parallel. The number of cities stays the same, so only the number of markets changes.
+CQSP_BENCHMARK(MarketScaling) {
+    const int cores = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    cqsp::common::util::ThreadPool pool(cores);
+    for (int markets : {1, 2, 4, 8, 16, 32, 64}) {
+        cqsp::common::Game game;
+        cqsp::common::Universe& universe = game.GetUniverse();
+        SyntheticUniverseOptions options = SyntheticUniverseOptions::Scaled(100);
+        options.markets = markets;
+        SyntheticUniverseGenerator generator(options);
+        generator.Generate(universe);
+        universe.date.IncrementDate();
+
+        for (int threads : {1, cores}) {
+            cqsp::common::util::ThreadPool* used = threads > 1 ? &pool : nullptr;
+            cqsp::benchmark::BenchmarkValues values {
+                {"markets", universe.view<cqspc::Market>().size()},
+                {"agents", universe.view<cqspc::MarketAgent>().size()},
+                {"threads", threads},
+            };
+            MeasureSystem<cqspcs::SysAgent>(report, game, "SysAgent", values, used);
+            MeasureSystem<cqspcs::SysMarket>(report, game, "SysMarket", values, used);
+        }
+    }
+}
+
+// Measures how SysAgent scales with the number of threads on universes with up to 10^5 agents, where the agents
+// are planned and committed in parallel. Every city has 9 agents, so the largest universe, with 12000 cities, has
+// 108000 agents. The number of agents is recorded with every result.
+CQSP_BENCHMARK(AgentScaling) {
+    const int cores = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    for (int scale : {100, 1000, 3000}) {
+        cqsp::common::Game game;
+        cqsp::common::Universe& universe = game.GetUniverse();
+        SyntheticUniverseGenerator generator(SyntheticUniverseOptions::Scaled(scale));
+        generator.Generate(universe);
+        universe.date.IncrementDate();
+
+        for (int threads = 1; threads <= cores; threads *= 2) {
+            std::unique_ptr<cqsp::common::util::ThreadPool> pool;
+            if (threads > 1) {
+                pool = std::make_unique<cqsp::common::util::ThreadPool>(threads);
+            }
+            cqsp::benchmark::BenchmarkValues values {
+                {"scale", scale},
+                {"agents", universe.view<cqspc::MarketAgent>().size()},
+                {"threads", threads},
+            };
+            MeasureSystem<cqspcs::SysAgent>(report, game, "SysAgent", values, pool.get());
+        }
+    }
+}
@@ -17,16 +17,22 @@
 #include <gtest/gtest.h>
 
 #include <algorithm>
+#include <random>
+#include <vector>
 
 #include <iostream>
 
 #include "common/components/auction.h"
 #include "common/systems/economy/auctionhandler.h"
+#include "common/util/threadpool.h"
 
 using cqsp::common::components::DescendingSortedOrderList;
 using cqsp::common::components::AscendingSortedOrderList;
 using cqsp::common::components::Order;
 using cqsp::common::components::AuctionHouse;
+using cqsp::common::components::SellOrderBook;
+using cqsp::common::components::OrderBatch;
+using cqsp::common::components::ClearingResult;
 
 entt::entity test_good = static_cast<entt::entity>(1);
 entt::entity test_agent = static_cast <entt::entity>(2);
@@ -252,3 +258,145 @@ TEST(AuctionTest, OverpricedSellOrderTest) {
     EXPECT_EQ(100, auction_house.GetDemand(test_good));
     EXPECT_EQ(100, auction_house.GetSupply(test_good));
 }
+
+TEST(AuctionTest, OrderBookTest) {
+    SellOrderBook book;
+    entt::entity other_agent = static_cast<entt::entity>(3);
+    book.put(Order(20, 10, test_agent));
+    book.put(Order(10, 5, test_agent));
+    book.put(Order(10, 5, other_agent));
+    book.put(Order(30, 10, test_agent));
+    EXPECT_EQ(book.size(), 4);
+    EXPECT_EQ(book.GetLevels().size(), 3);
+    EXPECT_EQ(book.GetQuantity(), 30);
+
+    // The cheapest level is first, and the orders in it are filled in the order they were put
+    EXPECT_EQ(book.front().price, 10);
+    EXPECT_EQ(book.front().agent, test_agent);
+    EXPECT_EQ(book.Fill(7, [](double price) { return price <= 20; }), 0);
+    EXPECT_EQ(book.front().agent, other_agent);
+    EXPECT_EQ(book.front().quantity, 3);
+    EXPECT_EQ(book.GetQuantity(), 23);
+
+    // Only fills the levels that match
+    EXPECT_EQ(book.Fill(20, [](double price) { return price <= 20; }), 7);
+    EXPECT_EQ(book.size(), 1);
+    EXPECT_EQ(book.GetLevels().size(), 1);
+    EXPECT_EQ(book.front().price, 30);
+    EXPECT_EQ(book.GetQuantity(), 10);
+
+    EXPECT_EQ(book.Fill(15, [](double price) { return true; }), 5);
+    EXPECT_TRUE(book.empty());
+    EXPECT_EQ(book.GetQuantity(), 0);
+}
+
+TEST(AuctionTest, BestPriceTest) {
+    AuctionHouse auction_house;
+    auction_house.AddSellOrder(test_good, Order(30, 10, test_agent));
+    auction_house.AddSellOrder(test_good, Order(10, 10, test_agent));
+
+    // Buys the cheapest first, even though the other order is too expensive
+    EXPECT_TRUE(cqsp::common::systems::BuyGood(auction_house, test_agent, test_good, 20, 10));
+    EXPECT_EQ(auction_house.GetSupply(test_good), 10);
+    EXPECT_EQ(auction_house.sell_orders[test_good].front().price, 30);
+
+    auction_house.AddBuyOrder(test_good, Order(5, 10, test_agent));
+    auction_house.AddBuyOrder(test_good, Order(25, 10, test_agent));
+    EXPECT_FALSE(cqsp::common::systems::SellGood(auction_house, test_agent, test_good, 20, 15));
+    EXPECT_EQ(auction_house.GetDemand(test_good), 10);
+    EXPECT_EQ(auction_house.GetSupply(test_good), 15);
+}
+
+namespace {
+entt::entity Agent(int agent) { return static_cast<entt::entity>(agent); }
+
+void ExpectSameResult(const ClearingResult& a, const ClearingResult& b) {
+    EXPECT_EQ(a.price, b.price);
+    EXPECT_EQ(a.volume, b.volume);
+    ASSERT_EQ(a.bought.size(), b.bought.size());
+    ASSERT_EQ(a.sold.size(), b.sold.size());
+    for (size_t i = 0; i < a.bought.size(); i++) {
+        EXPECT_EQ(a.bought[i].agent, b.bought[i].agent);
+        EXPECT_EQ(a.bought[i].quantity, b.bought[i].quantity);
+    }
+    for (size_t i = 0; i < a.sold.size(); i++) {
+        EXPECT_EQ(a.sold[i].agent, b.sold[i].agent);
+        EXPECT_EQ(a.sold[i].quantity, b.sold[i].quantity);
+    }
+}
+}  // namespace
+
+TEST(AuctionTest, CallAuctionTest) {
+    AuctionHouse auction_house;
+    OrderBatch batch;
+    batch.Buy(test_good, Order(12, 10, Agent(1)));
+    batch.Buy(test_good, Order(9, 10, Agent(2)));
+    batch.Sell(test_good, Order(8, 5, Agent(3)));
+    batch.Sell(test_good, Order(10, 10, Agent(4)));
+    auction_house.Submit(batch);
+    cqsp::common::systems::ClearCallAuctions(auction_house);
+    EXPECT_TRUE(auction_house.call_orders.empty());
+
+    // 10 is traded at any price from 10 to 12, and the middle is taken
+    const ClearingResult& result = auction_house.clearing_results[test_good];
+    EXPECT_EQ(result.price, 11);
+    EXPECT_EQ(result.volume, 10);
+    ASSERT_EQ(result.bought.size(), 1);
+    EXPECT_EQ(result.bought[0].agent, Agent(1));
+    EXPECT_EQ(result.bought[0].quantity, 10);
+    // The cheapest ask is filled, and the rest of the volume comes from the next one
+    ASSERT_EQ(result.sold.size(), 2);
+    EXPECT_EQ(result.sold[0].agent, Agent(3));
+    EXPECT_EQ(result.sold[0].quantity, 5);
+    EXPECT_EQ(result.sold[1].agent, Agent(4));
+    EXPECT_EQ(result.sold[1].quantity, 5);
+}
+
+TEST(AuctionTest, CallAuctionRationingTest) {
+    cqsp::common::components::CallOrders orders;
+    orders.bids.push_back(Order(10, 10, Agent(1)));
+    orders.asks.push_back(Order(10, 30, Agent(2)));
+    orders.asks.push_back(Order(10, 10, Agent(3)));
+    ClearingResult result = cqsp::common::systems::ClearCallAuction(orders);
+    EXPECT_EQ(result.price, 10);
+    EXPECT_EQ(result.volume, 10);
+    // Both asks are at the same price, so they share the volume
+    ASSERT_EQ(result.sold.size(), 2);
+    EXPECT_DOUBLE_EQ(result.sold[0].quantity, 7.5);
+    EXPECT_DOUBLE_EQ(result.sold[1].quantity, 2.5);
+
+    // Nothing trades when the bids are below the asks
+    cqsp::common::components::CallOrders apart;
+    apart.bids.push_back(Order(5, 10, Agent(1)));
+    apart.asks.push_back(Order(10, 10, Agent(2)));
+    EXPECT_EQ(cqsp::common::systems::ClearCallAuction(apart).volume, 0);
+}
+
+TEST(AuctionTest, CallAuctionDeterminismTest) {
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> price(1, 20);
+    std::uniform_int_distribution<int> quantity(1, 100);
+    std::vector<OrderBatch::Entry> entries;
+    for (int i = 0; i < 200; i++) {
+        entt::entity good = static_cast<entt::entity>(i % 10);
+        entries.push_back({good, (i / 10) % 2 == 0, Order(price(random), quantity(random), Agent(i % 7))});
+    }
+
+    AuctionHouse serial;
+    serial.Submit(OrderBatch {entries});
+    cqsp::common::systems::ClearCallAuctions(serial);
+
+    // The orders in a different order, cleared in parallel, clear the same
+    std::shuffle(entries.begin(), entries.end(), random);
+    AuctionHouse parallel;
+    parallel.Submit(OrderBatch {entries});
+    cqsp::common::util::ThreadPool pool(4);
+    cqsp::common::systems::ClearCallAuctions(parallel, &pool);
+
+    ASSERT_EQ(serial.clearing_results.size(), 10);
+    ASSERT_EQ(parallel.clearing_results.size(), 10);
+    for (auto& [good, result] : serial.clearing_results) {
+        EXPECT_GT(result.volume, 0);
+        ExpectSameResult(result, parallel.clearing_results[good]);
+    }
+}
@@ -0,0 +1,184 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <gtest/gtest.h>
+
+#include <utility>
+#include <vector>
+
+#include "common/components/denseledger.h"
+#include "common/components/resource.h"
+
+using cqsp::common::components::DenseLedger;
+using cqsp::common::components::GoodIndex;
+using cqsp::common::components::ResourceLedger;
+
+TEST(Common_DenseLedger, DenseLedgerComparison) {
+    entt::registry reg;
+    entt::entity good_one = reg.create();
+    entt::entity good_two = reg.create();
+    GoodIndex index;
+    // Add them in the other order, so that the index isn't the same as the entity
+    index.Add(good_two);
+    index.Add(good_one);
+    DenseLedger first(index), second(index);
+
+    first[good_one] = 10;
+    second[good_one] = 20;
+    EXPECT_TRUE(first < second);
+    EXPECT_FALSE(first > second);
+    EXPECT_FALSE(first == second);
+
+    first.clear();
+    EXPECT_TRUE(first < second);
+    EXPECT_FALSE(first > second);
+    EXPECT_FALSE(first == second);
+
+    second.clear();
+    first[good_two] = 15;
+    first[good_one] = 5;
+    second[good_two] = 10;
+    EXPECT_TRUE(first > second);
+    EXPECT_FALSE(first < second);
+    EXPECT_FALSE(first == second);
+
+    second[good_two] = 15;
+    second[good_one] = 5;
+    EXPECT_FALSE(first > second);
+    EXPECT_FALSE(first < second);
+    EXPECT_TRUE(first == second);
+
+    first.clear();
+    second.clear();
+    first[good_two] = 15;
+    first[good_one] = 5;
+    second[good_two] = 15;
+    second[good_one] = 10;
+    EXPECT_FALSE(first > second);
+    EXPECT_FALSE(first < second);
+    EXPECT_FALSE(first == second);
+
+    // The same as the map ledger
+    EXPECT_EQ(first >= second, first.ToLedger() >= second.ToLedger());
+    EXPECT_EQ(first <= second, first.ToLedger() <= second.ToLedger());
+}
+
+TEST(Common_DenseLedger, DenseLedgerDoubleComparison) {
+    entt::registry reg;
+    entt::entity good_one = reg.create();
+    entt::entity good_two = reg.create();
+    GoodIndex index;
+    index.Add(good_one);
+    DenseLedger first(index);
+
+    EXPECT_FALSE(first > 0);
+    EXPECT_TRUE(first == 0);
+    EXPECT_TRUE(first >= 0);
+
+    // Goods are present even if they are zero
+    first[good_one] = 0;
+    first[good_two] = 0;
+    EXPECT_EQ(first.size(), 2);
+    EXPECT_TRUE(first == 0);
+
+    first[good_one] = 10;
+    first[good_two] = -5;
+    EXPECT_FALSE(first > 0);
+    EXPECT_FALSE(first < 0);
+    EXPECT_FALSE(first >= 0);
+    EXPECT_TRUE(first > -10);
+}
+
+TEST(Common_DenseLedger, DenseLedgerArithmetic) {
+    entt::registry reg;
+    entt::entity good_one = reg.create();
+    entt::entity good_two = reg.create();
+    // Not in the index, so it is in the overflow
+    entt::entity field = reg.create();
+    GoodIndex index;
+    index.Add(good_one);
+    index.Add(good_two);
+
+    DenseLedger first(index), second(index);
+    first[good_one] = 10;
+    first[field] = 1;
+    second[good_two] = 4;
+    second[field] = 2;
+
+    first += second;
+    EXPECT_DOUBLE_EQ(first[good_one], 10);
+    EXPECT_DOUBLE_EQ(first[good_two], 4);
+    EXPECT_DOUBLE_EQ(first[field], 3);
+    EXPECT_EQ(first.size(), 3);
+
+    first.MultiplyAdd(second, 0.5);
+    EXPECT_DOUBLE_EQ(first.Get(good_two), 6);
+    EXPECT_DOUBLE_EQ(first.Get(field), 4);
+    EXPECT_DOUBLE_EQ(first.GetSum(), 20);
+    EXPECT_DOUBLE_EQ(first.MultiplyAndGetSum(second), 6 * 4 + 4 * 2);
+
+    first -= second * 10;
+    EXPECT_DOUBLE_EQ(first.Get(good_two), -34);
+    first.RemoveResourcesLimited(second);
+    EXPECT_DOUBLE_EQ(first.Get(good_two), 0);
+    EXPECT_DOUBLE_EQ(first.Get(good_one), 10);
+
+    ResourceLedger cost;
+    cost[good_one] = 4;
+    EXPECT_TRUE(first.EnoughToTransfer(cost));
+    first -= cost;
+    EXPECT_DOUBLE_EQ(first.Get(good_one), 6);
+    ResourceLedger removed = first.LimitedRemoveResources(cost * 2);
+    EXPECT_DOUBLE_EQ(removed[good_one], 6);
+    EXPECT_FALSE(first.EnoughToTransfer(cost));
+
+    // Iterated in the order of the index, then the overflow
+    std::vector<std::pair<entt::entity, double>> entries;
+    for (const auto& [good, amount] : first) {
+        entries.emplace_back(good, amount);
+    }
+    ASSERT_EQ(entries.size(), 3);
+    EXPECT_EQ(entries[0].first, good_one);
+    EXPECT_EQ(entries[1].first, good_two);
+    EXPECT_EQ(entries[2].first, field);
+}
+
+TEST(Common_DenseLedger, DenseLedgerBind) {
+    entt::registry reg;
+    entt::entity good_one = reg.create();
+    entt::entity good_two = reg.create();
+    GoodIndex index;
+    index.Add(good_one);
+    index.Add(good_two);
+
+    // An unbound ledger keeps everything in the overflow, until it is bound
+    DenseLedger unbound;
+    unbound[good_one] = 5;
+    EXPECT_EQ(unbound.GetOverflow().size(), 1);
+    DenseLedger bound(index);
+    bound[good_two] = 3;
+    unbound += bound;
+    EXPECT_EQ(unbound.GetIndex(), &index);
+    EXPECT_TRUE(unbound.GetOverflow().empty());
+    EXPECT_DOUBLE_EQ(unbound[good_one], 5);
+    EXPECT_DOUBLE_EQ(unbound[good_two], 3);
+
+    // And converts to and from the map ledger
+    ResourceLedger ledger = unbound.ToLedger();
+    EXPECT_DOUBLE_EQ(ledger[good_one], 5);
+    DenseLedger copy(index, ledger);
+    EXPECT_TRUE(copy == unbound);
+}
@@ -0,0 +1,116 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "common/components/economy.h"
+#include "common/components/journal.h"
+#include "common/util/threadpool.h"
+
+using cqsp::common::components::Journal;
+using cqsp::common::components::JournalEntry;
+using cqsp::common::components::StarDate;
+using cqsp::common::components::Wallet;
+
+TEST(Common_Journal, SettleTest) {
+    entt::registry registry;
+    entt::entity buyer = registry.create();
+    entt::entity seller = registry.create();
+    entt::entity market = registry.create();
+    entt::entity good = registry.create();
+    registry.emplace<Wallet>(buyer, entt::null, 100);
+    registry.emplace<Wallet>(seller, entt::null, 0);
+
+    Journal journal;
+    journal.Record({buyer, market, 30, good, 3});
+    journal.Record({market, seller, 20, good, 2});
+    journal.Record({buyer, market, 10, good, 1});
+    EXPECT_EQ(journal.GetPendingCount(), 3);
+    EXPECT_DOUBLE_EQ(journal.GetPendingDebit(buyer), 40);
+    EXPECT_DOUBLE_EQ(journal.GetPendingDebit(seller), 0);
+    // Nothing is paid until it is settled
+    EXPECT_DOUBLE_EQ(registry.get<Wallet>(buyer), 100);
+
+    journal.Settle(registry, StarDate());
+    EXPECT_EQ(journal.GetPendingCount(), 0);
+    EXPECT_DOUBLE_EQ(journal.GetPendingDebit(buyer), 0);
+    EXPECT_EQ(journal.GetSettled().size(), 3);
+    EXPECT_DOUBLE_EQ(registry.get<Wallet>(buyer), 60);
+    EXPECT_DOUBLE_EQ(registry.get<Wallet>(seller), 20);
+    // The market doesn't have a wallet, so it is skipped
+    EXPECT_FALSE(registry.all_of<Wallet>(market));
+
+    // Settled entries aren't paid again
+    journal.Settle(registry, StarDate());
+    EXPECT_TRUE(journal.GetSettled().empty());
+    EXPECT_DOUBLE_EQ(registry.get<Wallet>(buyer), 60);
+}
+
+TEST(Common_Journal, ThreadTest) {
+    // Entries recorded on many threads are settled in the same order as when they are recorded on one
+    entt::registry registry;
+    entt::entity market = registry.create();
+    entt::entity good = registry.create();
+    std::vector<entt::entity> agents;
+    for (int i = 0; i < 64; i++) {
+        agents.push_back(registry.create());
+        registry.emplace<Wallet>(agents.back(), entt::null, 1000);
+    }
+    auto record = [&](Journal& journal, int i) {
+        for (int trade = 0; trade < 10; trade++) {
+            journal.Record({agents[i], market, 0.1 * (trade + 1), good, 1.0});
+            journal.Record({market, agents[(i + trade) % agents.size()], 0.3, good, 3.0});
+        }
+    };
+
+    Journal serial;
+    for (int i = 0; i < static_cast<int>(agents.size()); i++) {
+        record(serial, i);
+    }
+    Journal parallel;
+    cqsp::common::util::ThreadPool pool(4);
+    pool.ParallelFor(static_cast<int>(agents.size()), [&](int i) { record(parallel, i); });
+    EXPECT_EQ(parallel.GetPendingCount(), serial.GetPendingCount());
+    // The debits that the threads kept on their own are added up
+    for (entt::entity agent : agents) {
+        EXPECT_DOUBLE_EQ(parallel.GetPendingDebit(agent), serial.GetPendingDebit(agent));
+    }
+
+    serial.Settle(registry, StarDate());
+    parallel.Settle(registry, StarDate());
+    ASSERT_EQ(serial.GetSettled().size(), parallel.GetSettled().size());
+    for (size_t i = 0; i < serial.GetSettled().size(); i++) {
+        EXPECT_EQ(serial.GetSettled()[i].payer, parallel.GetSettled()[i].payer);
+        EXPECT_EQ(serial.GetSettled()[i].payee, parallel.GetSettled()[i].payee);
+        EXPECT_EQ(serial.GetSettled()[i].amount, parallel.GetSettled()[i].amount);
+    }
+}
+
+TEST(Common_Journal, DestroyTest) {
+    // Journals that are created where an earlier journal was don't see its entries
+    entt::registry registry;
+    entt::entity buyer = registry.create();
+    entt::entity market = registry.create();
+    for (int i = 0; i < 3; i++) {
+        auto journal = std::make_unique<Journal>();
+        journal->Record({buyer, market, 10, entt::null, 1});
+        EXPECT_EQ(journal->GetPendingCount(), 1);
+        EXPECT_DOUBLE_EQ(journal->GetPendingDebit(buyer), 10);
+    }
+}
@@ -104,3 +104,47 @@ TEST(Common_ResourceLedger, ResourceLedgerDoubleComparison) {
     EXPECT_FALSE(first >= 0);
     EXPECT_FALSE(first <= 0);
 }
+
+TEST(Common_ResourceLedger, ResourceLedgerExpression) {
+    entt::registry reg;
+    entt::entity good_one = reg.create();
+    entt::entity good_two = reg.create();
+    entt::entity good_three = reg.create();
+    ResourceLedger scaling, fixed;
+    scaling[good_one] = 2;
+    scaling[good_three] = 1;
+    fixed[good_two] = 5;
+    fixed[good_three] = 3;
+
+    ResourceLedger cost = scaling * 10 + fixed;
+    EXPECT_EQ(cost.size(), 3u);
+    EXPECT_DOUBLE_EQ(cost[good_one], 20);
+    EXPECT_DOUBLE_EQ(cost[good_two], 5);
+    EXPECT_DOUBLE_EQ(cost[good_three], 13);
+
+    ResourceLedger difference = fixed - scaling;
+    EXPECT_DOUBLE_EQ(difference[good_one], -2);
+    EXPECT_DOUBLE_EQ(difference[good_three], 2);
+
+    // Only the goods in the left ledger are kept, and the right ledger isn't changed
+    ResourceLedger product = scaling * fixed;
+    EXPECT_EQ(product.size(), 2u);
+    EXPECT_DOUBLE_EQ(product[good_one], 0);
+    EXPECT_DOUBLE_EQ(product[good_three], 3);
+    EXPECT_FALSE(fixed.HasGood(good_one));
+
+    // Reading the ledger that is being assigned to
+    cost = cost * 2 - fixed;
+    EXPECT_DOUBLE_EQ(cost[good_one], 40);
+    EXPECT_DOUBLE_EQ(cost[good_two], 5);
+    EXPECT_DOUBLE_EQ(cost[good_three], 23);
+
+    ResourceLedger total;
+    total[good_two] = 1;
+    total += scaling * 0.5 + fixed;
+    EXPECT_DOUBLE_EQ(total[good_one], 1);
+    EXPECT_DOUBLE_EQ(total[good_two], 6);
+    EXPECT_DOUBLE_EQ(total[good_three], 3.5);
+    total -= fixed * 2;
+    EXPECT_DOUBLE_EQ(total[good_two], -4);
+}
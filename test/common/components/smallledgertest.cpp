@@ -0,0 +1,146 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "common/components/resource.h"
+#include "common/components/smallledger.h"
+
+using cqsp::common::components::ResourceLedger;
+using cqsp::common::components::SmallLedger;
+
+TEST(Common_SmallLedger, SmallLedgerComparison) {
+    entt::registry reg;
+    entt::entity good_one = reg.create();
+    entt::entity good_two = reg.create();
+    SmallLedger first, second;
+
+    first[good_one] = 10;
+    second[good_one] = 20;
+    EXPECT_TRUE(first < second);
+    EXPECT_FALSE(first > second);
+    EXPECT_FALSE(first == second);
+
+    first.clear();
+    EXPECT_TRUE(first < second);
+    EXPECT_FALSE(first > second);
+
+    second.clear();
+    first[good_two] = 15;
+    first[good_one] = 5;
+    second[good_two] = 10;
+    EXPECT_TRUE(first > second);
+    EXPECT_FALSE(first < second);
+
+    second[good_two] = 15;
+    second[good_one] = 5;
+    EXPECT_TRUE(first == second);
+
+    second[good_one] = 10;
+    // The same as the map ledger, and comparing against it directly
+    EXPECT_EQ(first >= second, first.ToLedger() >= second.ToLedger());
+    EXPECT_EQ(first <= second, first.ToLedger() <= second.ToLedger());
+    EXPECT_EQ(first <= second, first <= second.ToLedger());
+    EXPECT_TRUE(first > 0.);
+    EXPECT_FALSE(first > 5.);
+}
+
+TEST(Common_SmallLedger, SmallLedgerSorted) {
+    entt::registry reg;
+    std::vector<entt::entity> goods;
+    for (int i = 0; i < 4; i++) {
+        goods.push_back(reg.create());
+    }
+    SmallLedger ledger;
+    // Inserted out of order, but iterated in order like a map
+    ledger[goods[3]] = 4;
+    ledger[goods[1]] = 2;
+    ledger.emplace(goods[0], 1);
+    ledger.emplace(goods[2], 3);
+    EXPECT_FALSE(ledger.emplace(goods[2], 10).second);
+
+    ResourceLedger map = ledger.ToLedger();
+    ASSERT_EQ(ledger.size(), map.size());
+    auto it = map.begin();
+    for (const auto& [good, amount] : ledger) {
+        EXPECT_EQ(good, it->first);
+        EXPECT_EQ(amount, it->second);
+        ++it;
+    }
+    EXPECT_DOUBLE_EQ(ledger.GetSum(), 10);
+    EXPECT_DOUBLE_EQ(ledger.Get(goods[2]), 3);
+    EXPECT_FALSE(ledger.OnHeap());
+}
+
+TEST(Common_SmallLedger, SmallLedgerArithmetic) {
+    entt::registry reg;
+    entt::entity good_one = reg.create();
+    entt::entity good_two = reg.create();
+    entt::entity good_three = reg.create();
+    SmallLedger first, second;
+    first[good_one] = 10;
+    first[good_three] = 4;
+    second[good_two] = 5;
+    second[good_three] = 1;
+
+    SmallLedger sum = first + second;
+    EXPECT_DOUBLE_EQ(sum.Get(good_one), 10);
+    EXPECT_DOUBLE_EQ(sum.Get(good_two), 5);
+    EXPECT_DOUBLE_EQ(sum.Get(good_three), 5);
+
+    SmallLedger difference = first - second;
+    EXPECT_DOUBLE_EQ(difference.Get(good_two), -5);
+    EXPECT_DOUBLE_EQ(difference.Get(good_three), 3);
+
+    first.MultiplyAdd(second, 2);
+    EXPECT_EQ(first.size(), 3u);
+    EXPECT_DOUBLE_EQ(first.Get(good_two), 10);
+    EXPECT_DOUBLE_EQ(first.Get(good_three), 6);
+    EXPECT_DOUBLE_EQ(first.MultiplyAndGetSum(second), 10 * 5 + 6 * 1);
+    EXPECT_DOUBLE_EQ(first.MultiplyAndGetSum(second.ToLedger()), 10 * 5 + 6 * 1);
+
+    ResourceLedger map;
+    map[good_one] = 1;
+    first -= map;
+    EXPECT_DOUBLE_EQ(first.Get(good_one), 9);
+}
+
+TEST(Common_SmallLedger, SmallLedgerOverflowsToHeap) {
+    entt::registry reg;
+    SmallLedger ledger;
+    std::vector<entt::entity> goods;
+    for (size_t i = 0; i < SmallLedger::inline_capacity * 2; i++) {
+        goods.push_back(reg.create());
+    }
+    // Backwards, so that every good is inserted at the front
+    for (auto it = goods.rbegin(); it != goods.rend(); ++it) {
+        ledger[*it] = static_cast<double>(entt::to_integral(*it));
+        EXPECT_EQ(ledger.OnHeap(), ledger.size() > SmallLedger::inline_capacity);
+    }
+    ASSERT_EQ(ledger.size(), goods.size());
+    for (size_t i = 0; i < goods.size(); i++) {
+        EXPECT_EQ(ledger.begin()[i].first, goods[i]);
+        EXPECT_DOUBLE_EQ(ledger.Get(goods[i]), static_cast<double>(entt::to_integral(goods[i])));
+    }
+
+    ledger.clear();
+    EXPECT_FALSE(ledger.OnHeap());
+    ledger[goods[0]] = 1;
+    EXPECT_FALSE(ledger.OnHeap());
+    EXPECT_DOUBLE_EQ(ledger.GetSum(), 1);
+}
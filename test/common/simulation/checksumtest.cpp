@@ -0,0 +1,112 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "common/game.h"
+#include "common/systems/checksum.h"
+#include "common/components/coordinates.h"
+#include "common/components/economy.h"
+#include "common/components/population.h"
+#include "common/components/resource.h"
+
+namespace cqspc = cqsp::common::components;
+namespace cqspcs = cqsp::common::systems::checksum;
+
+class ChecksumTest : public ::testing::Test {
+ protected:
+    void SetUp() {
+        cqsp::common::Universe& universe = game.GetUniverse();
+        good = universe.create();
+        city = universe.create();
+        universe.emplace<cqspc::Wallet>(city, entt::null, 100);
+        universe.emplace<cqspc::PopulationSegment>(city).population = 10000;
+        universe.emplace<cqspc::ResourceStockpile>(city)[good] = 20;
+        universe.emplace<cqspc::types::Kinematics>(city).position = glm::dvec3(1, 2, 3);
+    }
+
+    cqsp::common::Game game;
+    entt::entity good;
+    entt::entity city;
+};
+
+TEST_F(ChecksumTest, StableTest) {
+    cqsp::common::Universe& universe = game.GetUniverse();
+    auto first = cqspcs::ComputeChecksum(universe);
+    auto second = cqspcs::ComputeChecksum(universe);
+    EXPECT_EQ(first.hashes, second.hashes);
+
+    // Only the changed component has a different hash
+    universe.get<cqspc::Wallet>(city).Add(1, cqspc::Wallet::GetEpoch(universe.date));
+    auto changed = cqspcs::ComputeChecksum(universe);
+    EXPECT_NE(changed[cqspcs::ChecksumComponent::Wallet], first[cqspcs::ChecksumComponent::Wallet]);
+    EXPECT_EQ(changed[cqspcs::ChecksumComponent::Stockpile], first[cqspcs::ChecksumComponent::Stockpile]);
+    EXPECT_EQ(changed[cqspcs::ChecksumComponent::Population], first[cqspcs::ChecksumComponent::Population]);
+}
+
+TEST_F(ChecksumTest, VerifyTest) {
+    cqsp::common::Universe& universe = game.GetUniverse();
+    cqspcs::ChecksumStream recording;
+    recording.amortize = true;
+    for (int i = 0; i < 5; i++) {
+        universe.date.IncrementDate();
+        universe.get<cqspc::ResourceStockpile>(city)[good] += 1;
+        recording.Record(universe);
+    }
+
+    // Read and write the recording
+    std::stringstream stream;
+    recording.Write(stream);
+    cqspcs::ChecksumStream recorded;
+    ASSERT_TRUE(recorded.Read(stream));
+    ASSERT_EQ(recorded.ticks.size(), 5);
+    EXPECT_EQ(recorded.seed, recording.seed);
+    EXPECT_TRUE(recorded.amortize);
+    EXPECT_EQ(recorded.ticks[4].hashes, recording.ticks[4].hashes);
+
+    // Run it again, but diverge at the fourth tick
+    cqsp::common::Game other_game;
+    cqsp::common::Universe& other = other_game.GetUniverse();
+    entt::entity other_good = other.create();
+    entt::entity other_city = other.create();
+    other.emplace<cqspc::Wallet>(other_city, entt::null, 100);
+    other.emplace<cqspc::PopulationSegment>(other_city).population = 10000;
+    other.emplace<cqspc::ResourceStockpile>(other_city)[other_good] = 20;
+    other.emplace<cqspc::types::Kinematics>(other_city).position = glm::dvec3(1, 2, 3);
+
+    cqspcs::ChecksumVerifier verifier(recorded);
+    for (int i = 0; i < 5; i++) {
+        other.date.IncrementDate();
+        other.get<cqspc::ResourceStockpile>(other_city)[other_good] += (i == 3) ? 2 : 1;
+        bool matches = verifier.Verify(other);
+        EXPECT_EQ(matches, i < 3);
+    }
+    ASSERT_TRUE(verifier.GetDivergence().has_value());
+    EXPECT_EQ(verifier.GetDivergence()->tick, 3);
+    EXPECT_EQ(verifier.GetDivergence()->component, cqspcs::ChecksumComponent::Stockpile);
+}
+
+TEST(RandomSeedTest, SeedTest) {
+    cqsp::common::Game first(1234);
+    cqsp::common::Game second(1234);
+    EXPECT_EQ(first.GetUniverse().random->GetSeed(), 1234);
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(first.GetUniverse().random->GetRandomInt(0, 1000000),
+                  second.GetUniverse().random->GetRandomInt(0, 1000000));
+    }
+}
@@ -17,11 +17,14 @@
 #include <gtest/gtest.h>
 
 #include <iostream>
+#include <vector>
 
 #include "common/universe.h"
 #include "common/components/economy.h"
+#include "common/components/history.h"
 #include "common/systems/economy/sysmarket.h"
 #include "common/systems/economy/markethelpers.h"
+#include "common/systems/history/sysmarkethistory.h"
 
 namespace cqspc = cqsp::common::components;
 
@@ -68,7 +71,7 @@ TEST_F(MarketTwoTest, SellTest) {
     auto& stockpile = universe.get<cqspc::ResourceStockpile>(agent1);
     stockpile[good_1] = 100;
     // Now test sell the goods
-    ASSERT_TRUE(cqsp::common::systems::economy::SellGood(universe, agent1, stockpile));
+    ASSERT_TRUE(cqsp::common::systems::economy::SellGood(universe, agent1, stockpile.ToLedger()));
     // Then check if the goods are sold
     auto& market_comp = universe.get<cqspc::Market>(market);
 
@@ -78,17 +81,19 @@ TEST_F(MarketTwoTest, SellTest) {
     // Check if agent sold resources
     EXPECT_EQ(stockpile[good_1], 0);
     // So the supply is 100 now
-    // Check if wallet is subtracted
+    // Check if wallet is added to once the journal is settled
+    EXPECT_EQ(universe.get<cqspc::Wallet>(agent1).GetBalance(), 0);
+    universe.journal.Settle(universe, universe.date);
     auto& wallet = universe.get<cqspc::Wallet>(agent1);
     EXPECT_EQ(wallet.GetBalance(), good_1_default_price * 100);
 }
 
 TEST_F(MarketTwoTest, BuyTest) {
     // Add money to the wallet so that they have enough to buy
-    universe.get<cqspc::Wallet>(agent1) = 100 * good_1_default_price;
+    universe.get<cqspc::Wallet>(agent1).Set(100 * good_1_default_price, cqspc::Wallet::GetEpoch(universe.date));
 
     // Now test sell the goods
-    cqspc::ResourceStockpile to_buy;
+    cqspc::ResourceLedger to_buy;
     to_buy[good_1] = 100;
     ASSERT_TRUE(cqsp::common::systems::economy::PurchaseGood(universe, agent1, to_buy));
 
@@ -98,13 +103,31 @@ TEST_F(MarketTwoTest, BuyTest) {
     EXPECT_EQ(market_comp[good_1].demand, 100);
 
     // Check wallet
+    universe.journal.Settle(universe, universe.date);
     EXPECT_EQ(universe.get<cqspc::Wallet>(agent1).GetBalance(), 0);
 }
 
+TEST_F(MarketTwoTest, BuyTwiceTest) {
+    // Enough money for one purchase, but not for two
+    universe.get<cqspc::Wallet>(agent1).Set(100 * good_1_default_price, cqspc::Wallet::GetEpoch(universe.date));
+
+    cqspc::ResourceLedger to_buy;
+    to_buy[good_1] = 60;
+    ASSERT_TRUE(cqsp::common::systems::economy::PurchaseGood(universe, agent1, to_buy));
+    EXPECT_DOUBLE_EQ(universe.journal.GetPendingDebit(agent1), 60 * good_1_default_price);
+    // The first purchase isn't paid yet, but is still counted
+    EXPECT_FALSE(cqsp::common::systems::economy::PurchaseGood(universe, agent1, to_buy));
+    EXPECT_EQ(universe.get<cqspc::Market>(market)[good_1].demand, 60);
+
+    universe.journal.Settle(universe, universe.date);
+    EXPECT_EQ(universe.get<cqspc::Wallet>(agent1).GetBalance(), 40 * good_1_default_price);
+    EXPECT_DOUBLE_EQ(universe.journal.GetPendingDebit(agent1), 0);
+}
+
 TEST_F(MarketTwoTest, BuySellTest) {
     // Add the resources and sell them, then try buying them, then get the change in price
-    universe.get<cqspc::Wallet>(agent1) = 100 * good_1_default_price;
-    universe.get<cqspc::Wallet>(agent2) = 100 * good_1_default_price;
+    universe.get<cqspc::Wallet>(agent1).Set(100 * good_1_default_price, cqspc::Wallet::GetEpoch(universe.date));
+    universe.get<cqspc::Wallet>(agent2).Set(100 * good_1_default_price, cqspc::Wallet::GetEpoch(universe.date));
 
     // Add the goods
     universe.get<cqspc::ResourceStockpile>(agent1)[good_1] = 100;
@@ -135,8 +158,8 @@ TEST_F(MarketTwoTest, BuySellTest) {
 // So there is an over supply the price should drop.
 TEST_F(MarketTwoTest, BuySellOverSupplyTest) {
     // Add the resources and sell them, then try buying them, then get the change in price
-    universe.get<cqspc::Wallet>(agent1) = 1000 * good_1_default_price;
-    universe.get<cqspc::Wallet>(agent2) = 1000 * good_1_default_price;
+    universe.get<cqspc::Wallet>(agent1).Set(1000 * good_1_default_price, cqspc::Wallet::GetEpoch(universe.date));
+    universe.get<cqspc::Wallet>(agent2).Set(1000 * good_1_default_price, cqspc::Wallet::GetEpoch(universe.date));
 
     // Add the goods
     universe.get<cqspc::ResourceStockpile>(agent1)[good_1] = 100;
@@ -164,3 +187,97 @@ TEST_F(MarketTwoTest, BuySellOverSupplyTest) {
     // Check the price, lower price due to higher supply over demand
     EXPECT_LE(market_comp[good_1].price, good_1_default_price);
 }
+
+TEST_F(MarketTwoTest, DoubleBufferTest) {
+    // The good is put in the columns of the market when it is added to the index
+    universe.good_index.Add(good_1);
+    auto& market_comp = universe.get<cqspc::Market>(market);
+    market_comp[good_1].supply = 100;
+    market_comp[good_1].demand = 50;
+    EXPECT_EQ(market_comp.Current().overflow.count(good_1), 0);
+    EXPECT_EQ(market_comp.GetPrice(good_1), good_1_default_price);
+
+    cqsp::common::systems::SysMarket market_system(game);
+    market_system.DoSystem();
+
+    // The supply and demand of the tick are kept as the last market information
+    cqspc::MarketElementInformation last = market_comp.GetLast(good_1);
+    EXPECT_EQ(last.supply, 100);
+    EXPECT_EQ(last.demand, 50);
+    EXPECT_EQ(last.sd_ratio, 2);
+    EXPECT_EQ(market_comp.GetSupply(good_1), 0);
+    EXPECT_EQ(market_comp.GetDemand(good_1), 0);
+    // The last market information has the price that the good was traded at
+    EXPECT_EQ(last.price, good_1_default_price);
+    EXPECT_LT(market_comp.GetPrice(good_1), good_1_default_price);
+
+    // Goods that aren't in the index and weren't traded keep their price
+    EXPECT_EQ(market_comp.GetPrice(good_2), good_2_default_price);
+    std::vector<entt::entity> goods = market_comp.GetGoods();
+    ASSERT_EQ(goods.size(), 2u);
+    EXPECT_EQ(goods[0], good_1);
+    EXPECT_EQ(goods[1], good_2);
+
+    // The next tick adds to the other columns
+    double price = market_comp.GetPrice(good_1);
+    market_comp[good_1].demand = 100;
+    market_system.DoSystem();
+    EXPECT_EQ(market_comp.GetLast(good_1).supply, 0);
+    EXPECT_EQ(market_comp.GetLast(good_1).demand, 100);
+    EXPECT_EQ(market_comp.GetLast(good_1).price, price);
+    EXPECT_GT(market_comp.GetPrice(good_1), price);
+}
+
+TEST_F(MarketTwoTest, EpochTest) {
+    universe.good_index.Add(good_1);
+    auto& market_comp = universe.get<cqspc::Market>(market);
+    cqsp::common::systems::SysMarket market_system(game);
+    market_comp[good_1].supply = 100;
+    market_system.DoSystem();
+    const double price = market_comp.GetPrice(good_1);
+    EXPECT_EQ(market_comp.GetLast(good_1).supply, 100);
+
+    // The supply of the last epoch is still in the columns, but isn't read
+    EXPECT_FALSE(market_comp.HasTrades());
+    EXPECT_EQ(market_comp.GetSupply(good_1), 0);
+
+    // A market that nobody traded on keeps its prices, and has nothing in the tick before
+    market_system.DoSystem();
+    EXPECT_EQ(market_comp.GetPrice(good_1), price);
+    EXPECT_EQ(market_comp.GetLast(good_1).supply, 0);
+    EXPECT_EQ(market_comp.GetLast(good_1).price, price);
+
+    // Writing to the market clears the supply of the older epoch first
+    market_comp[good_1].demand = 10;
+    EXPECT_TRUE(market_comp.HasTrades());
+    EXPECT_EQ(market_comp.GetSupply(good_1), 0);
+    EXPECT_EQ(market_comp.GetDemand(good_1), 10);
+    market_system.DoSystem();
+    EXPECT_EQ(market_comp.GetLast(good_1).demand, 10);
+    EXPECT_EQ(market_comp.GetLast(good_1).price, price);
+    EXPECT_GT(market_comp.GetPrice(good_1), price);
+}
+
+TEST_F(MarketTwoTest, HistoryTest) {
+    universe.get<cqspc::Wallet>(agent1).Set(0, cqspc::Wallet::GetEpoch(universe.date));
+    universe.get<cqspc::Wallet>(agent2).Set(100 * good_1_default_price, cqspc::Wallet::GetEpoch(universe.date));
+    universe.get<cqspc::ResourceStockpile>(agent1)[good_1] = 100;
+    cqspc::ResourceLedger ledger;
+    ledger[good_1] = 100;
+    ASSERT_TRUE(cqsp::common::systems::economy::SellGood(universe, agent1, ledger));
+    ledger[good_1] = 50;
+    ASSERT_TRUE(cqsp::common::systems::economy::PurchaseGood(universe, agent2, ledger));
+
+    // The market adds up what was traded on it, so the history doesn't need to look at the participants
+    cqsp::common::systems::history::SysMarketHistory history_system(game);
+    history_system.DoSystem();
+    auto& history = universe.get<cqspc::MarketHistory>(market);
+    ASSERT_EQ(history.gdp.size(), 1u);
+    EXPECT_EQ(history.gdp.back(), 50 * good_1_default_price);
+    EXPECT_EQ(history.total_volume.back(), 100);
+
+    // Which is cleared after it is recorded
+    history_system.DoSystem();
+    EXPECT_EQ(history.gdp.back(), 0);
+    EXPECT_EQ(history.total_volume.back(), 0);
+}
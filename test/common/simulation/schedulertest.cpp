@@ -0,0 +1,177 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "common/game.h"
+#include "common/systems/isimulationsystem.h"
+#include "common/systems/systemscheduler.h"
+#include "common/components/economy.h"
+#include "common/components/coordinates.h"
+
+namespace cqspc = cqsp::common::components;
+namespace cqspcs = cqsp::common::systems;
+using cqsp::common::systems::simulation::SystemScheduler;
+
+namespace {
+std::mutex order_mutex;
+std::vector<int> run_order;
+
+template<int Id, typename Reads, typename Writes>
+class TestSystem : public cqspcs::ISimulationSystem {
+ public:
+    explicit TestSystem(cqsp::common::Game& game) : cqspcs::ISimulationSystem(game) {}
+    void DoSystem() override {
+        std::lock_guard<std::mutex> lock(order_mutex);
+        run_order.push_back(Id);
+    }
+    void DeclareAccess(cqspcs::ComponentAccess& access) override {
+        access.Read<Reads>();
+        access.Write<Writes>();
+    }
+};
+
+class ExclusiveSystem : public cqspcs::ISimulationSystem {
+ public:
+    explicit ExclusiveSystem(cqsp::common::Game& game) : cqspcs::ISimulationSystem(game) {}
+    void DoSystem() override {
+        std::lock_guard<std::mutex> lock(order_mutex);
+        run_order.push_back(-1);
+    }
+};
+
+class SlicedSystem : public cqspcs::ISimulationSystem {
+ public:
+    explicit SlicedSystem(cqsp::common::Game& game) : cqspcs::ISimulationSystem(game) {}
+    void DoSystem() override {
+        for (entt::entity entity : GetUniverse().view<cqspc::Wallet>()) {
+            if (InSlice(entity)) {
+                processed[entity]++;
+            }
+        }
+    }
+    void DeclareAccess(cqspcs::ComponentAccess& access) override { access.Read<cqspc::Wallet>(); }
+    bool CanSlice() override { return true; }
+
+    std::map<entt::entity, int> processed;
+};
+
+int IndexOf(int id) {
+    return static_cast<int>(std::find(run_order.begin(), run_order.end(), id) - run_order.begin());
+}
+}  // namespace
+
+TEST(SystemSchedulerTest, ConflictTest) {
+    cqsp::common::Game game;
+    SystemScheduler scheduler(4);
+    TestSystem<0, cqspc::MarketAgent, cqspc::Wallet> wallet_writer(game);
+    TestSystem<1, cqspc::Wallet, cqspc::Market> wallet_reader(game);
+    TestSystem<2, cqspc::types::Orbit, cqspc::types::Kinematics> kinematics(game);
+    TestSystem<3, cqspc::MarketAgent, cqspc::MarketHistory> agent_reader(game);
+    ExclusiveSystem exclusive(game);
+
+    scheduler.AddSystem(&wallet_writer, game.GetUniverse(), "wallet_writer");
+    scheduler.AddSystem(&wallet_reader, game.GetUniverse(), "wallet_reader");
+    scheduler.AddSystem(&kinematics, game.GetUniverse(), "kinematics");
+    scheduler.AddSystem(&agent_reader, game.GetUniverse(), "agent_reader");
+    scheduler.AddSystem(&exclusive, game.GetUniverse(), "exclusive");
+
+    // Write and read of the same component
+    EXPECT_TRUE(scheduler.Conflicts(0, 1));
+    EXPECT_TRUE(scheduler.Conflicts(1, 0));
+    // Nothing in common
+    EXPECT_FALSE(scheduler.Conflicts(0, 2));
+    EXPECT_FALSE(scheduler.Conflicts(1, 2));
+    // Both only read the same component
+    EXPECT_FALSE(scheduler.Conflicts(0, 3));
+    // Exclusive systems conflict with everything
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(scheduler.Conflicts(i, 4));
+    }
+}
+
+TEST(SystemSchedulerTest, OrderTest) {
+    cqsp::common::Game game;
+    SystemScheduler scheduler(4);
+    TestSystem<0, cqspc::MarketAgent, cqspc::Wallet> first(game);
+    TestSystem<1, cqspc::types::Orbit, cqspc::types::Kinematics> unrelated(game);
+    TestSystem<2, cqspc::Wallet, cqspc::Market> second(game);
+    TestSystem<3, cqspc::Market, cqspc::MarketHistory> third(game);
+    ExclusiveSystem exclusive(game);
+    TestSystem<4, cqspc::types::Kinematics, cqspc::MarketCenter> last(game);
+
+    scheduler.AddSystem(&first, game.GetUniverse(), "first");
+    scheduler.AddSystem(&unrelated, game.GetUniverse(), "unrelated");
+    scheduler.AddSystem(&second, game.GetUniverse(), "second");
+    scheduler.AddSystem(&third, game.GetUniverse(), "third");
+    scheduler.AddSystem(&exclusive, game.GetUniverse(), "exclusive");
+    scheduler.AddSystem(&last, game.GetUniverse(), "last");
+
+    for (int i = 0; i < 100; i++) {
+        run_order.clear();
+        scheduler.Run({0, 1, 2, 3, 4, 5});
+        ASSERT_EQ(run_order.size(), 6);
+        // The economy chain has to keep its order
+        EXPECT_LT(IndexOf(0), IndexOf(2));
+        EXPECT_LT(IndexOf(2), IndexOf(3));
+        // The exclusive system runs after everything added before it, and before everything after it
+        EXPECT_EQ(IndexOf(-1), 4);
+        EXPECT_EQ(IndexOf(4), 5);
+    }
+}
+
+TEST(SystemSchedulerTest, AmortizedTest) {
+    cqsp::common::Game game;
+    SystemScheduler scheduler(1);
+    SlicedSystem sliced(game);
+    TestSystem<0, cqspc::MarketAgent, cqspc::Wallet> unsliced(game);
+    scheduler.AddSystem(&sliced, game.GetUniverse(), "sliced");
+    scheduler.AddSystem(&unsliced, game.GetUniverse(), "unsliced");
+    for (int i = 0; i < 101; i++) {
+        game.GetUniverse().emplace<cqspc::Wallet>(game.GetUniverse().create());
+    }
+
+    // Not amortized, so everything is processed once when the date is a multiple of the interval
+    for (int date = 1; date <= 25; date++) {
+        scheduler.Run(scheduler.GetDueSystems(date));
+    }
+    EXPECT_EQ(sliced.processed.size(), 101);
+    for (auto& [entity, count] : sliced.processed) {
+        EXPECT_EQ(count, 1);
+    }
+
+    // Amortized, so the system is run every tick, but every entity is still processed once per interval
+    sliced.processed.clear();
+    run_order.clear();
+    scheduler.SetAmortized(true);
+    for (int date = 26; date <= 50; date++) {
+        std::vector<int> due = scheduler.GetDueSystems(date);
+        ASSERT_FALSE(due.empty());
+        EXPECT_EQ(due.front(), 0);
+        scheduler.Run(due);
+    }
+    EXPECT_EQ(sliced.processed.size(), 101);
+    for (auto& [entity, count] : sliced.processed) {
+        EXPECT_EQ(count, 1);
+    }
+    // Systems that can't be sliced still only run once per interval
+    EXPECT_EQ(run_order.size(), 1);
+}
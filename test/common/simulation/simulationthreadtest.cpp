@@ -0,0 +1,144 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "common/game.h"
+#include "common/simulation.h"
+#include "common/simulationthread.h"
+
+using cqsp::common::systems::simulation::Simulation;
+using cqsp::common::systems::simulation::SimulationThread;
+
+namespace {
+// Far enough away that a run until it only ends when it is cancelled
+const int never = 1 << 30;
+
+// Locks the universe, as soon as the simulation thread lets go of it
+std::unique_lock<std::mutex> LockWhenFree(SimulationThread& thread) {
+    auto lock = thread.TryLockUniverse();
+    while (!lock.owns_lock()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        lock = thread.TryLockUniverse();
+    }
+    return lock;
+}
+}  // namespace
+
+class SimulationThreadTest : public ::testing::Test {
+ protected:
+    void SetUp() {
+        // The script system reads the events, which are otherwise registered when the core package is loaded
+        game.GetScriptInterface().RegisterDataGroup("events");
+        simulation = std::make_unique<Simulation>(game);
+    }
+
+    cqsp::common::Game game;
+    std::unique_ptr<Simulation> simulation;
+};
+
+TEST_F(SimulationThreadTest, TicksUntilTest) {
+    cqsp::common::Universe& universe = game.GetUniverse();
+    SimulationThread thread(*simulation, universe);
+    // Small batches, so that the date is checked across several of them
+    thread.snapshot_interval = std::chrono::microseconds(100);
+
+    ASSERT_TRUE(thread.RequestTicksUntil(50));
+    thread.WaitForTick();
+    EXPECT_EQ(universe.date.GetDate(), 50);
+    EXPECT_EQ(thread.GetSnapshot()->date.GetDate(), 50);
+    EXPECT_FALSE(thread.IsTicking());
+
+    // Nothing is run if the date is already reached
+    ASSERT_TRUE(thread.RequestTicksUntil(50));
+    thread.WaitForTick();
+    EXPECT_EQ(universe.date.GetDate(), 50);
+    ASSERT_TRUE(thread.RequestTicksUntil(10));
+    thread.WaitForTick();
+    EXPECT_EQ(universe.date.GetDate(), 50);
+}
+
+TEST_F(SimulationThreadTest, CancelTest) {
+    cqsp::common::Universe& universe = game.GetUniverse();
+    SimulationThread thread(*simulation, universe);
+
+    ASSERT_TRUE(thread.RequestTicksUntil(never));
+    EXPECT_TRUE(thread.IsRunningUntil());
+    // No other request can be made while ticking
+    EXPECT_FALSE(thread.RequestTick());
+    EXPECT_FALSE(thread.RequestTicks(std::chrono::milliseconds(1)));
+    EXPECT_FALSE(thread.RequestTicksUntil(10));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    thread.Cancel();
+    thread.WaitForTick();
+    EXPECT_FALSE(thread.IsTicking());
+    EXPECT_FALSE(thread.IsRunningUntil());
+    EXPECT_LT(universe.date.GetDate(), never);
+
+    // The thread takes requests again
+    int date = universe.date.GetDate();
+    ASSERT_TRUE(thread.RequestTick());
+    thread.WaitForTick();
+    EXPECT_EQ(universe.date.GetDate(), date + 1);
+}
+
+TEST_F(SimulationThreadTest, HandoffTest) {
+    cqsp::common::Universe& universe = game.GetUniverse();
+    SimulationThread thread(*simulation, universe);
+    thread.snapshot_interval = std::chrono::milliseconds(20);
+    ASSERT_TRUE(thread.RequestTicksUntil(never));
+
+    // Wait for a batch to hold the universe, and fail to lock it
+    auto lock = thread.TryLockUniverse();
+    while (lock.owns_lock()) {
+        lock.unlock();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        lock = thread.TryLockUniverse();
+    }
+    EXPECT_TRUE(thread.IsLockWanted());
+
+    // The simulation thread hands the universe over after the batch, instead of locking it again straight away
+    auto start = std::chrono::steady_clock::now();
+    lock = LockWhenFree(thread);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 5 * thread.snapshot_interval);
+    EXPECT_FALSE(thread.IsLockWanted());
+
+    // No tick runs while the universe is held
+    int date = universe.date.GetDate();
+    std::this_thread::sleep_for(2 * thread.snapshot_interval);
+    EXPECT_EQ(universe.date.GetDate(), date);
+    lock.unlock();
+
+    thread.Cancel();
+    thread.WaitForTick();
+}
+
+TEST_F(SimulationThreadTest, DestroyTest) {
+    cqsp::common::Universe& universe = game.GetUniverse();
+    auto thread = std::make_unique<SimulationThread>(*simulation, universe);
+    ASSERT_TRUE(thread->RequestTicksUntil(never));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    // The run is cancelled and the thread is joined, instead of running until the date
+    thread.reset();
+    EXPECT_LT(universe.date.GetDate(), never);
+}
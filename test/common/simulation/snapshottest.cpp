@@ -0,0 +1,68 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <gtest/gtest.h>
+
+#include "common/game.h"
+#include "common/universesnapshot.h"
+#include "common/components/area.h"
+#include "common/components/coordinates.h"
+#include "common/components/economy.h"
+#include "common/components/name.h"
+#include "common/components/population.h"
+#include "common/components/resource.h"
+
+namespace cqspc = cqsp::common::components;
+
+TEST(UniverseSnapshotTest, CopyTest) {
+    cqsp::common::Game game;
+    cqsp::common::Universe& universe = game.GetUniverse();
+    // Make a hole in the ids, so that the snapshot has to keep the same ids
+    universe.destroy(universe.create());
+    entt::entity planet = universe.create();
+    universe.emplace<cqspc::types::Kinematics>(planet).position = glm::dvec3(1, 2, 3);
+    universe.emplace<cqspc::Name>(planet, "Earth");
+    entt::entity city = universe.create();
+    universe.emplace<cqspc::Wallet>(city, entt::null, 100);
+    universe.emplace<cqspc::PopulationSegment>(city).population = 5000;
+    // The planet viewer reads the industries of the cities
+    entt::entity mine = universe.create();
+    entt::entity good = universe.create();
+    entt::entity commercial = universe.create();
+    universe.emplace<cqspc::Industry>(city).industries = {mine, commercial};
+    universe.emplace<cqspc::ResourceGenerator>(mine).emplace(good, 10);
+    universe.date.IncrementDate();
+    universe.date.IncrementDate();
+
+    auto snapshot = cqsp::common::TakeSnapshot(universe);
+    const entt::registry& registry = snapshot->registry;
+    EXPECT_EQ(snapshot->date.GetDate(), universe.date.GetDate());
+    ASSERT_TRUE(registry.all_of<cqspc::types::Kinematics>(planet));
+    EXPECT_EQ(registry.get<cqspc::types::Kinematics>(planet).position.y, 2);
+    EXPECT_EQ(registry.get<cqspc::Name>(planet).name, "Earth");
+    EXPECT_DOUBLE_EQ(registry.get<cqspc::Wallet>(city).GetBalance(), 100);
+    EXPECT_EQ(registry.get<cqspc::PopulationSegment>(city).population, 5000);
+    ASSERT_TRUE(registry.all_of<cqspc::Industry>(city));
+    EXPECT_EQ(registry.get<cqspc::Industry>(city).industries.front(), mine);
+    EXPECT_DOUBLE_EQ(registry.get<cqspc::ResourceGenerator>(mine).Get(good), 10);
+    // Entities without any component in the snapshot can still be looked up
+    EXPECT_TRUE(registry.valid(commercial));
+    EXPECT_FALSE(registry.all_of<cqspc::ResourceGenerator>(commercial));
+
+    // Changes to the universe don't change the snapshot
+    universe.get<cqspc::Wallet>(city).Add(50, cqspc::Wallet::GetEpoch(universe.date));
+    EXPECT_DOUBLE_EQ(registry.get<cqspc::Wallet>(city).GetBalance(), 100);
+}
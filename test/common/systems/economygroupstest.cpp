@@ -0,0 +1,49 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <gtest/gtest.h>
+
+#include "common/game.h"
+#include "common/components/economy.h"
+#include "common/components/population.h"
+#include "common/systems/economy/economygroups.h"
+#include "common/systems/economy/markethelpers.h"
+#include "common/systems/syntheticuniversegenerator.h"
+
+namespace cqspc = cqsp::common::components;
+namespace economy = cqsp::common::systems::economy;
+using cqsp::common::systems::universegenerator::SyntheticUniverseGenerator;
+using cqsp::common::systems::universegenerator::SyntheticUniverseOptions;
+
+TEST(EconomyGroupsTest, MembershipTest) {
+    cqsp::common::Game game;
+    cqsp::common::Universe& universe = game.GetUniverse();
+    SyntheticUniverseOptions options;
+    SyntheticUniverseGenerator(options).Generate(universe);
+
+    EXPECT_EQ(economy::ConsumerGroup(universe).size(), options.cities * options.segments_per_city);
+    EXPECT_EQ(economy::MineGroup(universe).size(),
+              options.cities * (options.mines_per_city + options.farms_per_city));
+
+    // Entities join the groups when they get the last component of the group
+    entt::entity segment = universe.create();
+    universe.emplace<cqspc::PopulationSegment>(segment);
+    EXPECT_FALSE(economy::ConsumerGroup(universe).contains(segment));
+    economy::AddParticipant(universe, universe.view<cqspc::Market>().front(), segment);
+    EXPECT_TRUE(economy::ConsumerGroup(universe).contains(segment));
+    universe.remove<cqspc::MarketAgent>(segment);
+    EXPECT_FALSE(economy::ConsumerGroup(universe).contains(segment));
+}
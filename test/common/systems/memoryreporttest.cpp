@@ -0,0 +1,81 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+
+#include "common/game.h"
+#include "common/components/economy.h"
+#include "common/components/name.h"
+#include "common/components/resource.h"
+#include "common/systems/memoryreport.h"
+
+namespace cqspc = cqsp::common::components;
+using cqsp::common::systems::memory::ComponentMemory;
+using cqsp::common::systems::memory::MemoryReport;
+using cqsp::common::systems::memory::MemoryTracker;
+
+namespace {
+const ComponentMemory* Find(const MemoryReport& report, const std::string& name) {
+    auto it = std::find_if(report.components.begin(), report.components.end(),
+                           [&](const ComponentMemory& memory) { return memory.name == name; });
+    return it == report.components.end() ? nullptr : &*it;
+}
+}  // namespace
+
+TEST(MemoryReportTest, SampleTest) {
+    cqsp::common::Game game;
+    cqsp::common::Universe& universe = game.GetUniverse();
+    entt::entity good = universe.create();
+    for (int i = 0; i < 10; i++) {
+        entt::entity entity = universe.create();
+        universe.emplace<cqspc::Name>(entity, std::string(100, 'a'));
+        universe.emplace<cqspc::ResourceStockpile>(entity)[good] = 10;
+    }
+
+    MemoryTracker tracker;
+    MemoryReport first = tracker.Sample(universe);
+    const ComponentMemory* names = Find(first, "Name");
+    ASSERT_NE(names, nullptr);
+    EXPECT_TRUE(names->known);
+    EXPECT_EQ(names->entities, 10);
+    EXPECT_GE(names->heap_bytes, 10 * 100);
+    EXPECT_GE(names->storage_bytes, 10 * sizeof(cqspc::Name));
+    // Nothing to compare to on the first sample
+    EXPECT_EQ(names->growth, 0);
+
+    const ComponentMemory* stockpiles = Find(first, "ResourceStockpile");
+    ASSERT_NE(stockpiles, nullptr);
+    EXPECT_GT(stockpiles->heap_bytes, 0);
+
+    // Every stockpile gets another good, which is another map node
+    entt::entity other_good = universe.create();
+    for (auto [entity, stockpile] : universe.view<cqspc::ResourceStockpile>().each()) {
+        stockpile[other_good] = 5;
+    }
+    MemoryReport second = tracker.Sample(universe);
+    const ComponentMemory* grown = Find(second, "ResourceStockpile");
+    ASSERT_NE(grown, nullptr);
+    EXPECT_GT(grown->heap_bytes, stockpiles->heap_bytes);
+    EXPECT_EQ(grown->growth, static_cast<int64_t>(grown->heap_bytes - stockpiles->heap_bytes));
+    EXPECT_EQ(Find(second, "Name")->growth, 0);
+
+    // The total is the last line
+    auto lines = second.Format(1);
+    EXPECT_EQ(lines.size(), 4);
+}
@@ -0,0 +1,92 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "common/game.h"
+#include "common/components/economy.h"
+#include "common/components/population.h"
+#include "common/components/resource.h"
+#include "common/systems/economy/markethelpers.h"
+#include "common/systems/economy/populationdemand.h"
+#include "common/systems/economy/syspopulation.h"
+
+namespace economy = cqsp::common::systems::economy;
+
+TEST(PopulationDemandTest, DemandTest) {
+    // Buys food and consumer goods, buys too few consumer goods to be worth it, can't afford all the food, and
+    // has no money at all
+    double consumption[] = {10, 10, 10, 10};
+    double threshold[] = {5, 50, 5, 5};
+    double balance[] = {100, 100, 5, 0};
+    double food_price[] = {2, 2, 1, 1};
+    double good_price[] = {4, 4, 4, 4};
+    double food[4];
+    double good[4];
+    economy::ComputePopulationDemand({4, consumption, threshold, balance, food_price, good_price, food, good});
+
+    EXPECT_DOUBLE_EQ(food[0], 10);
+    EXPECT_DOUBLE_EQ(good[0], (100 - 20) / 4.0);
+
+    EXPECT_DOUBLE_EQ(food[1], 10);
+    EXPECT_EQ(good[1], 0);
+
+    EXPECT_DOUBLE_EQ(food[2], 5);
+    EXPECT_EQ(good[2], 0);
+
+    EXPECT_DOUBLE_EQ(food[3], 0);
+    EXPECT_EQ(good[3], 0);
+}
+
+TEST(PopulationDemandTest, SystemTest) {
+    namespace cqspc = cqsp::common::components;
+    cqsp::common::Game game;
+    cqsp::common::Universe& universe = game.GetUniverse();
+    entt::entity food = universe.goods["food"] = universe.create();
+    entt::entity good = universe.goods["consumer_good"] = universe.create();
+    entt::entity market = economy::CreateMarket(universe);
+    universe.get<cqspc::Market>(market)[food].price = 1;
+    universe.get<cqspc::Market>(market)[good].price = 10;
+
+    auto add_segment = [&](uint64_t population, double balance) {
+        entt::entity segment = universe.create();
+        universe.emplace<cqspc::PopulationSegment>(segment, population);
+        economy::AddParticipant(universe, market, segment);
+        universe.get<cqspc::Wallet>(segment).Set(balance, cqspc::Wallet::GetEpoch(universe.date));
+        return segment;
+    };
+    entt::entity rich = add_segment(1000000, 1000);
+    entt::entity poor = add_segment(1000000, 5);
+    entt::entity isolated = universe.create();
+    universe.emplace<cqspc::PopulationSegment>(isolated, 1000000);
+
+    cqsp::common::systems::SysPopulationConsumption consumption(game);
+    consumption.DoSystem();
+
+    auto& rich_consumption = universe.get<cqspc::ResourceConsumption>(rich);
+    EXPECT_DOUBLE_EQ(rich_consumption[food], 10);
+    EXPECT_DOUBLE_EQ(rich_consumption[good], (1000 - 10) / 10.0);
+    EXPECT_DOUBLE_EQ(universe.get<cqspc::Wallet>(rich), 1000 + 1000);
+
+    auto& poor_consumption = universe.get<cqspc::ResourceConsumption>(poor);
+    EXPECT_DOUBLE_EQ(poor_consumption[food], 5);
+    EXPECT_FALSE(poor_consumption.HasGood(good));
+
+    EXPECT_DOUBLE_EQ(universe.get<cqspc::ResourceConsumption>(isolated)[food], 10);
+    EXPECT_DOUBLE_EQ(universe.get<cqspc::Wallet>(isolated), 1000);
+}
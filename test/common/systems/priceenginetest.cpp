@@ -0,0 +1,76 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "common/systems/economy/priceengine.h"
+
+namespace economy = cqsp::common::systems::economy;
+
+namespace {
+/// <summary>
+/// Runs the engine on one good with a supply of `price` and a demand of `100 - price`, so supply and demand are
+/// equal at a price of 50.
+/// </summary>
+/// <returns>the number of ticks until the price is within 0.01 of 50, or max_ticks if it never is</returns>
+int TicksToConverge(const economy::PriceEngine& engine, double price, int max_ticks = 1000) {
+    double last_supply = 0;
+    double last_demand = 0;
+    double last_price = 0;
+    for (int tick = 0; tick < max_ticks; tick++) {
+        if (std::abs(price - 50) < 0.01) {
+            return tick;
+        }
+        double supply = price;
+        double demand = 100 - price;
+        double next_price = last_price;
+        engine.UpdatePrices({1, &supply, &demand, &price, &last_supply, &last_demand, &last_price, &next_price});
+        last_supply = supply;
+        last_demand = demand;
+        last_price = price;
+        price = next_price;
+    }
+    return max_ticks;
+}
+}  // namespace
+
+TEST(PriceEngineTest, FixedStepTest) {
+    double supply[] = {10, 20, 10, 5};
+    double demand[] = {20, 10, 10, 0};
+    double price[] = {100, 100, 100, 0.001};
+    double next_price[4];
+    economy::FixedStepPriceEngine().UpdatePrices({4, supply, demand, price, supply, demand, price, next_price});
+    EXPECT_DOUBLE_EQ(next_price[0], 100 + (0.001 + 100.0 * 0.1f));
+    EXPECT_DOUBLE_EQ(next_price[1], 100 - (0.001 + 100.0 * 0.1f));
+    EXPECT_DOUBLE_EQ(next_price[2], 100);
+    // Limited to the minimum price
+    EXPECT_DOUBLE_EQ(next_price[3], economy::PriceEngine::min_price);
+}
+
+TEST(PriceEngineTest, ConvergenceTest) {
+    // The fixed step keeps jumping over the equilibrium, and only lands close to it by chance
+    int fixed_step = TicksToConverge(economy::FixedStepPriceEngine(), 80);
+    int tatonnement = TicksToConverge(economy::TatonnementPriceEngine(), 80);
+    int secant = TicksToConverge(economy::SecantPriceEngine(), 80);
+    EXPECT_LT(tatonnement, fixed_step);
+    EXPECT_LT(secant, tatonnement);
+
+    // From below as well
+    EXPECT_LT(TicksToConverge(economy::TatonnementPriceEngine(), 5), 1000);
+    EXPECT_LT(TicksToConverge(economy::SecantPriceEngine(), 5), 1000);
+}
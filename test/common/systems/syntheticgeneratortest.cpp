@@ -0,0 +1,55 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <gtest/gtest.h>
+
+#include "common/game.h"
+#include "common/components/area.h"
+#include "common/components/bodies.h"
+#include "common/components/economy.h"
+#include "common/components/population.h"
+#include "common/components/surface.h"
+#include "common/systems/syntheticuniversegenerator.h"
+
+namespace cqspc = cqsp::common::components;
+using cqsp::common::systems::universegenerator::SyntheticUniverseGenerator;
+using cqsp::common::systems::universegenerator::SyntheticUniverseOptions;
+
+TEST(SyntheticUniverseGeneratorTest, CountTest) {
+    cqsp::common::Game game;
+    cqsp::common::Universe& universe = game.GetUniverse();
+    SyntheticUniverseOptions options = SyntheticUniverseOptions::Scaled(3);
+    SyntheticUniverseGenerator generator(options);
+    generator.Generate(universe);
+
+    EXPECT_EQ(universe.view<cqspc::bodies::Star>().size(), options.star_systems);
+    EXPECT_EQ(universe.view<cqspc::bodies::Planet>().size(), options.star_systems * options.bodies_per_system);
+    EXPECT_EQ(universe.view<cqspc::Market>().size(), options.markets);
+    EXPECT_EQ(universe.view<cqspc::Settlement>().size(), options.cities);
+    EXPECT_EQ(universe.view<cqspc::PopulationSegment>().size(), options.cities * options.segments_per_city);
+    EXPECT_EQ(universe.view<cqspc::Factory>().size(), options.cities * options.factories_per_city);
+    EXPECT_EQ(universe.view<cqspc::Mine>().size(), options.cities * options.mines_per_city);
+    EXPECT_EQ(universe.view<cqspc::Farm>().size(), options.cities * options.farms_per_city);
+    EXPECT_EQ(universe.goods.size(), options.raw_goods + options.manufactured_goods + 2);
+    EXPECT_NE(universe.sun, entt::null);
+
+    // Everything that trades is in a market
+    for (entt::entity agent : universe.view<cqspc::MarketAgent>()) {
+        entt::entity market = universe.get<cqspc::MarketAgent>(agent).market;
+        ASSERT_TRUE(universe.valid(market));
+        EXPECT_TRUE(universe.get<cqspc::Market>(market).participants.contains(agent));
+    }
+}
@@ -0,0 +1,223 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "common/game.h"
+#include "common/components/economy.h"
+#include "common/components/resource.h"
+#include "common/systems/economy/markethelpers.h"
+#include "common/systems/economy/sysagent.h"
+#include "common/systems/economy/tradematrix.h"
+#include "common/util/threadpool.h"
+
+namespace cqspc = cqsp::common::components;
+namespace economy = cqsp::common::systems::economy;
+
+namespace {
+struct TradeMatrixTest : public ::testing::Test {
+    cqsp::common::Game game;
+    cqsp::common::Universe& universe = game.GetUniverse();
+    entt::entity goods[3];
+    entt::entity market;
+    entt::entity mine;
+    entt::entity factory;
+    entt::entity consumer;
+
+    void SetUp() override {
+        for (entt::entity& good : goods) {
+            good = universe.create();
+            universe.good_index.Add(good);
+        }
+        market = economy::CreateMarket(universe);
+        auto& market_comp = universe.get<cqspc::Market>(market);
+        for (int i = 0; i < 3; i++) {
+            market_comp[goods[i]].price = i + 1;
+        }
+
+        mine = AddAgent(0);
+        universe.emplace<cqspc::ResourceGenerator>(mine).emplace(goods[0], 10);
+        universe.emplace<cqspc::FactoryProductivity>(mine, 2, 2);
+
+        entt::entity recipe = universe.create();
+        auto& recipe_comp = universe.emplace<cqspc::Recipe>(recipe);
+        recipe_comp.input[goods[0]] = 1;
+        recipe_comp.output[goods[1]] = 2;
+        factory = AddAgent(100);
+        universe.emplace<cqspc::ResourceConverter>(factory, recipe);
+        universe.emplace<cqspc::FactoryProducing>(factory);
+
+        // Can't afford what it consumes
+        consumer = AddAgent(5);
+        universe.emplace<cqspc::ResourceConsumption>(consumer)[goods[2]] = 4;
+    }
+
+    entt::entity AddAgent(double balance) {
+        entt::entity agent = universe.create();
+        universe.emplace<cqspc::ResourceStockpile>(agent);
+        economy::AddParticipant(universe, market, agent);
+        universe.get<cqspc::Wallet>(agent).Set(balance, cqspc::Wallet::GetEpoch(universe.date));
+        return agent;
+    }
+
+    cqspc::TradeMatrix& Build() {
+        auto& matrix = universe.get_or_emplace<cqspc::TradeMatrix>(market);
+        economy::BuildTradeMatrices(universe);
+        return matrix;
+    }
+};
+}  // namespace
+
+TEST_F(TradeMatrixTest, TradeTest) {
+    cqsp::common::util::TickVector<entt::entity> unindexed;
+    auto& market_comp = universe.get<cqspc::Market>(market);
+    economy::TradeMarket(universe, market, market_comp, Build(), unindexed);
+    EXPECT_TRUE(unindexed.empty());
+    // Nothing is paid until the journal is settled
+    EXPECT_DOUBLE_EQ(universe.get<cqspc::Wallet>(mine), 0);
+    universe.journal.Settle(universe, universe.date);
+
+    EXPECT_DOUBLE_EQ(market_comp.GetSupply(goods[0]), 20);
+    EXPECT_DOUBLE_EQ(market_comp.GetSupply(goods[1]), 2);
+    EXPECT_DOUBLE_EQ(market_comp.GetDemand(goods[0]), 1);
+    EXPECT_DOUBLE_EQ(market_comp.GetDemand(goods[2]), 0);
+
+    EXPECT_DOUBLE_EQ(universe.get<cqspc::Wallet>(mine), 20);
+    EXPECT_DOUBLE_EQ(universe.get<cqspc::ResourceStockpile>(mine).Get(goods[0]), -20);
+
+    // Sold 2 of the second good, and bought 1 of the first good to produce again
+    EXPECT_DOUBLE_EQ(universe.get<cqspc::Wallet>(factory), 103);
+    EXPECT_DOUBLE_EQ(universe.get<cqspc::ResourceStockpile>(factory).Get(goods[0]), 1);
+    EXPECT_DOUBLE_EQ(universe.get<cqspc::ResourceStockpile>(factory).Get(goods[1]), -2);
+    EXPECT_TRUE(universe.all_of<cqspc::FactoryProducing>(factory));
+
+    EXPECT_DOUBLE_EQ(universe.get<cqspc::Wallet>(consumer), 5);
+    EXPECT_FALSE(universe.get<cqspc::ResourceStockpile>(consumer).HasGood(goods[2]));
+    EXPECT_FALSE(universe.all_of<cqspc::FactoryProducing>(consumer));
+}
+
+TEST_F(TradeMatrixTest, RebuildTest) {
+    cqspc::TradeMatrix& matrix = Build();
+    EXPECT_FALSE(matrix.dirty);
+    EXPECT_EQ(matrix.agents.size(), 3);
+    EXPECT_EQ(matrix.generation.size(), 3 * 3);
+
+    // Agents that join or leave mark the matrix dirty
+    entt::entity agent = AddAgent(0);
+    EXPECT_TRUE(matrix.dirty);
+    economy::BuildTradeMatrices(universe);
+    EXPECT_EQ(matrix.agents.size(), 4);
+    universe.remove<cqspc::MarketAgent>(agent);
+    EXPECT_TRUE(matrix.dirty);
+    economy::BuildTradeMatrices(universe);
+    EXPECT_EQ(matrix.agents.size(), 3);
+
+    // Goods that aren't in the index can't be in the matrix
+    entt::entity other_good = universe.create();
+    agent = AddAgent(0);
+    universe.emplace<cqspc::ResourceGenerator>(agent).emplace(other_good, 1);
+    economy::BuildTradeMatrices(universe);
+    EXPECT_EQ(matrix.agents.size(), 3);
+    ASSERT_EQ(matrix.unindexed.size(), 1);
+    EXPECT_EQ(matrix.unindexed.front(), agent);
+
+    // New goods grow the rows
+    universe.good_index.Add(other_good);
+    economy::BuildTradeMatrices(universe);
+    EXPECT_EQ(matrix.agents.size(), 4);
+    EXPECT_EQ(matrix.generation.size(), 4 * 4);
+    EXPECT_TRUE(matrix.unindexed.empty());
+}
+
+TEST_F(TradeMatrixTest, ChunkTest) {
+    // Trading the agents in separate chunks on several threads is the same as trading them all at once
+    auto& market_comp = universe.get<cqspc::Market>(market);
+    cqspc::TradeMatrix& matrix = Build();
+    economy::PrepareTradeMarket(universe, market_comp, matrix);
+    std::vector<economy::TradeChunk> chunks(matrix.agents.size());
+    for (size_t i = 0; i < chunks.size(); i++) {
+        chunks[i].market_entity = market;
+        chunks[i].market = &market_comp;
+        chunks[i].matrix = &matrix;
+        chunks[i].begin = i;
+        chunks[i].end = i + 1;
+    }
+    cqsp::common::util::ThreadPool pool(2);
+    pool.ParallelFor(static_cast<int>(chunks.size()), [&](int i) { economy::PlanTradeChunk(universe, chunks[i]); });
+    // Planning doesn't change the universe, everything is changed when the chunks are committed
+    EXPECT_TRUE(universe.all_of<cqspc::FactoryProducing>(factory));
+    EXPECT_DOUBLE_EQ(universe.get<cqspc::ResourceStockpile>(mine).Get(goods[0]), 0);
+    EXPECT_DOUBLE_EQ(market_comp.GetSupply(goods[0]), 0);
+    EXPECT_EQ(universe.journal.GetPendingCount(), 0);
+
+    pool.ParallelFor(static_cast<int>(chunks.size()), [&](int i) { economy::CommitTradeChunk(universe, chunks[i]); });
+    economy::CommitTradeMarket(universe, chunks);
+    cqsp::common::util::TickVector<entt::entity> unindexed;
+    for (const auto& chunk : chunks) {
+        economy::CommitProducing(universe, chunk, unindexed);
+    }
+    EXPECT_TRUE(unindexed.empty());
+    universe.journal.Settle(universe, universe.date);
+
+    EXPECT_DOUBLE_EQ(market_comp.GetSupply(goods[0]), 20);
+    EXPECT_DOUBLE_EQ(market_comp.GetSupply(goods[1]), 2);
+    EXPECT_DOUBLE_EQ(market_comp.GetDemand(goods[0]), 1);
+    EXPECT_DOUBLE_EQ(universe.get<cqspc::Wallet>(mine), 20);
+    EXPECT_DOUBLE_EQ(universe.get<cqspc::ResourceStockpile>(mine).Get(goods[0]), -20);
+    EXPECT_DOUBLE_EQ(universe.get<cqspc::Wallet>(factory), 103);
+    EXPECT_DOUBLE_EQ(universe.get<cqspc::ResourceStockpile>(factory).Get(goods[0]), 1);
+    EXPECT_TRUE(universe.all_of<cqspc::FactoryProducing>(factory));
+    EXPECT_DOUBLE_EQ(universe.get<cqspc::Wallet>(consumer), 5);
+}
+
+TEST_F(TradeMatrixTest, SysAgentTest) {
+    // Enough agents that SysAgent splits them into several chunks
+    std::vector<entt::entity> mines;
+    for (int i = 0; i < 1500; i++) {
+        mines.push_back(AddAgent(0));
+        universe.emplace<cqspc::ResourceGenerator>(mines.back()).emplace(goods[0], 10);
+    }
+    cqsp::common::util::ThreadPool pool(4);
+    cqsp::common::systems::SysAgent agent_system(game);
+    agent_system.SetThreadPool(&pool);
+    agent_system.DoSystem();
+    universe.journal.Settle(universe, universe.date);
+
+    auto& market_comp = universe.get<cqspc::Market>(market);
+    EXPECT_DOUBLE_EQ(market_comp.GetSupply(goods[0]), 20 + 1500 * 10);
+    for (entt::entity entity : mines) {
+        EXPECT_DOUBLE_EQ(universe.get<cqspc::Wallet>(entity), 10);
+        EXPECT_DOUBLE_EQ(universe.get<cqspc::ResourceStockpile>(entity).Get(goods[0]), -10);
+    }
+    EXPECT_TRUE(universe.all_of<cqspc::FactoryProducing>(factory));
+}
+
+TEST_F(TradeMatrixTest, IdleMarketTest) {
+    // A market without agents isn't marked as traded on by SysAgent, so SysMarket can skip it
+    entt::entity idle = economy::CreateMarket(universe);
+    auto& idle_market = universe.get<cqspc::Market>(idle);
+    idle_market[goods[0]].price = 5;
+    idle_market.Advance();
+    ASSERT_FALSE(idle_market.HasTrades());
+
+    cqsp::common::systems::SysAgent agent_system(game);
+    agent_system.DoSystem();
+    EXPECT_FALSE(idle_market.HasTrades());
+    EXPECT_DOUBLE_EQ(idle_market.GetPrice(goods[0]), 5);
+    EXPECT_TRUE(universe.get<cqspc::Market>(market).HasTrades());
+}
@@ -0,0 +1,69 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <entt/entt.hpp>
+
+#include "common/util/entityset.h"
+
+using cqsp::common::util::EntitySet;
+
+TEST(EntitySetTest, InsertEraseTest) {
+    entt::registry registry;
+    std::vector<entt::entity> entities;
+    for (int i = 0; i < 10; i++) {
+        entities.push_back(registry.create());
+    }
+
+    EntitySet set;
+    for (entt::entity entity : entities) {
+        EXPECT_TRUE(set.insert(entity));
+    }
+    EXPECT_FALSE(set.insert(entities[3]));
+    EXPECT_EQ(set.size(), 10u);
+
+    // The last entity is moved into the place of the erased one
+    EXPECT_TRUE(set.erase(entities[3]));
+    EXPECT_FALSE(set.erase(entities[3]));
+    EXPECT_FALSE(set.contains(entities[3]));
+    EXPECT_EQ(set.size(), 9u);
+    for (entt::entity entity : entities) {
+        EXPECT_EQ(set.contains(entity), entity != entities[3]);
+    }
+    std::vector<entt::entity> iterated(set.begin(), set.end());
+    EXPECT_EQ(iterated[3], entities[9]);
+    EXPECT_FALSE(set.contains(entt::null));
+}
+
+TEST(EntitySetTest, VersionTest) {
+    entt::registry registry;
+    entt::entity old_entity = registry.create();
+    EntitySet set;
+    set.insert(old_entity);
+    registry.destroy(old_entity);
+
+    // The new entity reuses the id of the old one
+    entt::entity new_entity = registry.create();
+    ASSERT_EQ(entt::to_entity(new_entity), entt::to_entity(old_entity));
+    EXPECT_FALSE(set.contains(new_entity));
+    EXPECT_TRUE(set.insert(new_entity));
+    EXPECT_TRUE(set.contains(new_entity));
+    EXPECT_FALSE(set.contains(old_entity));
+    EXPECT_EQ(set.size(), 1u);
+}
@@ -0,0 +1,74 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <gtest/gtest.h>
+
+#include "common/components/economy.h"
+#include "common/stardate.h"
+#include "common/util/epochaccumulator.h"
+
+using cqsp::common::util::EpochAccumulator;
+
+TEST(EpochAccumulatorTest, AddTest) {
+    EpochAccumulator<double> accumulator;
+    EXPECT_EQ(accumulator.Get(0), 0);
+    accumulator.Add(0, 5);
+    accumulator.Add(0, 2);
+    EXPECT_EQ(accumulator.Get(0), 7);
+    // Reads from another epoch don't see what was added in this one
+    EXPECT_EQ(accumulator.Get(1), 0);
+
+    // Writing in a later epoch starts again from zero
+    accumulator.Add(3, 1);
+    EXPECT_EQ(accumulator.GetEpoch(), 3u);
+    EXPECT_EQ(accumulator.Get(3), 1);
+    EXPECT_EQ(accumulator.Get(0), 0);
+}
+
+TEST(EpochAccumulatorTest, WalletTest) {
+    namespace cqspc = cqsp::common::components;
+    cqspc::StarDate date;
+    cqspc::Wallet wallet(entt::null, 100);
+    date.IncrementDate();
+
+    wallet.Spend(30, cqspc::Wallet::GetEpoch(date));
+    wallet.Add(10, cqspc::Wallet::GetEpoch(date));
+    EXPECT_EQ(wallet.GetBalance(), 80);
+    EXPECT_EQ(wallet.GetChange(cqspc::Wallet::GetEpoch(date)), -20);
+    EXPECT_EQ(wallet.GetGDPChange(cqspc::Wallet::GetEpoch(date)), 30);
+
+    // The changes are kept for the whole interval, and read as nothing once it is over
+    for (int i = 1; i < cqspc::Wallet::interval; i++) {
+        date.IncrementDate();
+    }
+    EXPECT_EQ(wallet.GetGDPChange(cqspc::Wallet::GetEpoch(date)), 30);
+    date.IncrementDate();
+    EXPECT_EQ(wallet.GetChange(cqspc::Wallet::GetEpoch(date)), 0);
+    EXPECT_EQ(wallet.GetGDPChange(cqspc::Wallet::GetEpoch(date)), 0);
+    EXPECT_EQ(wallet.GetBalance(), 80);
+
+    // Copies of the wallet, such as the ones in a snapshot, read the changes by whatever date they are given
+    cqspc::Wallet copy = wallet;
+    copy.Spend(5, cqspc::Wallet::GetEpoch(date));
+    EXPECT_EQ(copy.GetGDPChange(cqspc::Wallet::GetEpoch(date)), 5);
+    EXPECT_EQ(wallet.GetGDPChange(cqspc::Wallet::GetEpoch(date)), 0);
+
+    // Setting the balance is a change too
+    wallet.Set(200, cqspc::Wallet::GetEpoch(date));
+    EXPECT_EQ(wallet.GetChange(cqspc::Wallet::GetEpoch(date)), 120);
+    wallet.Set(150, cqspc::Wallet::GetEpoch(date));
+    EXPECT_EQ(wallet.GetChange(cqspc::Wallet::GetEpoch(date)), 70);
+}
@@ -0,0 +1,78 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include "common/util/identifiertable.h"
+
+using cqsp::common::util::IdentifierTable;
+
+TEST(IdentifierTableTest, LookupTest) {
+    entt::registry registry;
+    IdentifierTable table;
+    std::vector<entt::entity> goods;
+    // Enough identifiers that the table has to grow a few times
+    for (int i = 0; i < 100; i++) {
+        goods.push_back(registry.create());
+        table["good_" + std::to_string(i)] = goods.back();
+    }
+    EXPECT_EQ(table.size(), 100u);
+    for (int i = 0; i < 100; i++) {
+        auto it = table.find("good_" + std::to_string(i));
+        ASSERT_NE(it, table.end());
+        EXPECT_EQ(it->first, "good_" + std::to_string(i));
+        EXPECT_EQ(it->second, goods[i]);
+    }
+    EXPECT_EQ(table.find("good_100"), table.end());
+    EXPECT_FALSE(table.contains("food"));
+
+    // Iterated in the order that they were added
+    int index = 0;
+    for (const auto& [identifier, entity] : table) {
+        EXPECT_EQ(identifier, "good_" + std::to_string(index));
+        index++;
+    }
+    EXPECT_EQ(index, 100);
+}
+
+TEST(IdentifierTableTest, HandleTest) {
+    entt::registry registry;
+    IdentifierTable table;
+    EXPECT_FALSE(table.GetHandle("food").IsValid());
+    EXPECT_EQ(table[IdentifierTable::Handle()], entt::null);
+
+    // Handles can be taken before the identifier is loaded
+    IdentifierTable::Handle food = table.Intern("food");
+    ASSERT_TRUE(food.IsValid());
+    EXPECT_EQ(table[food], entt::null);
+    EXPECT_EQ(table.size(), 0u);
+    EXPECT_FALSE(table.contains("food"));
+
+    entt::entity food_entity = registry.create();
+    table["steel"] = registry.create();
+    table["food"] = food_entity;
+    EXPECT_EQ(table[food], food_entity);
+    EXPECT_EQ(table.GetHandle("food"), food);
+    EXPECT_EQ(table.Intern("food"), food);
+    EXPECT_EQ(table.size(), 2u);
+
+    table.clear();
+    EXPECT_TRUE(table.empty());
+    EXPECT_FALSE(table.GetHandle("food").IsValid());
+}
@@ -0,0 +1,48 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+#include "common/util/threadpool.h"
+
+using cqsp::common::util::ThreadPool;
+
+TEST(ThreadPoolTest, ParallelForTest) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> runs(1000);
+    pool.ParallelFor(static_cast<int>(runs.size()), [&runs](int i) { runs[i]++; });
+    for (const auto& count : runs) {
+        EXPECT_EQ(count.load(), 1);
+    }
+}
+
+TEST(ThreadPoolTest, NestedParallelForTest) {
+    // Every worker waits on a ParallelFor of its own, which only finishes because the waiting threads run the
+    // indices themselves
+    ThreadPool pool(2);
+    std::atomic<int> total = 0;
+    pool.ParallelFor(8, [&](int) { pool.ParallelFor(100, [&](int i) { total += i; }); });
+    EXPECT_EQ(total.load(), 8 * 4950);
+}
+
+TEST(ThreadPoolTest, SerialParallelForTest) {
+    std::vector<int> order;
+    cqsp::common::util::ParallelFor(nullptr, 5, [&order](int i) { order.push_back(i); });
+    EXPECT_EQ(order, (std::vector<int> {0, 1, 2, 3, 4}));
+}
@@ -0,0 +1,80 @@
+/* Conquer Space
+* Copyright (C) 2021 Conquer Space
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+#include "common/components/smallledger.h"
+#include "common/util/tickarena.h"
+
+using cqsp::common::util::TickArena;
+
+namespace {
+void RunTick() {
+    auto vector = cqsp::common::util::MakeTickVector<int>();
+    for (int i = 0; i < 100000; i++) {
+        vector.push_back(i);
+    }
+    TickArena::ResetAll();
+}
+}  // namespace
+
+TEST(TickArenaTest, ReuseTest) {
+    RunTick();
+    auto first = TickArena::GetStats();
+    EXPECT_GT(first.used, 100000 * sizeof(int));
+    EXPECT_GE(first.reserved, first.used);
+
+    // The blocks were merged, so the same tick again fits without allocating
+    RunTick();
+    auto second = TickArena::GetStats();
+    EXPECT_EQ(second.used, first.used);
+    EXPECT_EQ(second.block_allocations, 0);
+    EXPECT_EQ(second.reserved, first.reserved);
+    EXPECT_GE(second.high_water, second.used);
+
+    TickArena::ResetAll();
+    EXPECT_EQ(TickArena::GetStats().used, 0);
+    EXPECT_EQ(TickArena::GetStats().high_water, second.high_water);
+}
+
+TEST(TickArenaTest, AlignmentTest) {
+    TickArena& arena = TickArena::Get();
+    EXPECT_NE(arena.allocate(1, 1), nullptr);
+    void* aligned = arena.allocate(64, 64);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned) % 64, 0);
+    // Larger than a block
+    void* large = arena.allocate(1 << 20, 4096);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(large) % 4096, 0);
+    TickArena::ResetAll();
+}
+
+TEST(TickArenaTest, LedgerTest) {
+    entt::registry registry;
+    cqsp::common::components::SmallLedger ledger(&TickArena::Get());
+    for (int i = 0; i < 20; i++) {
+        ledger[registry.create()] = i;
+    }
+    EXPECT_TRUE(ledger.OnHeap());
+    EXPECT_GT(TickArena::Get().Used(), 0);
+
+    // Copies don't keep the arena
+    cqsp::common::components::SmallLedger copy = ledger;
+    TickArena::ResetAll();
+    EXPECT_EQ(copy.size(), 20);
+    EXPECT_DOUBLE_EQ(copy.GetSum(), 190);
+}